@@ -0,0 +1,269 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_ASYNC_JSON_READER_HPP
+#define JSONCONS_ASYNC_JSON_READER_HPP
+
+#include <jsoncons/config/jsoncons_config.hpp>
+
+#if defined(JSONCONS_HAS_COROUTINES)
+
+#include <memory> // std::allocator
+#include <system_error>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/staj_cursor.hpp>
+#include <jsoncons/unicode_traits.hpp>
+#include <jsoncons/async_source.hpp>
+
+namespace jsoncons {
+
+namespace detail {
+
+    // Hands a chunk to the parser, skipping a byte order mark at the start of the input
+    template <class CharT,class Allocator>
+    void update_parser(basic_json_parser<CharT,Allocator>& parser, span<const CharT> s, bool& begin, std::error_code& ec)
+    {
+        if (begin)
+        {
+            auto result = unicons::skip_bom(s.begin(), s.end());
+            if (result.ec != unicons::encoding_errc())
+            {
+                ec = result.ec;
+                return;
+            }
+            std::size_t offset = result.it - s.begin();
+            parser.update(s.data()+offset,s.size()-offset);
+            begin = false;
+        }
+        else
+        {
+            parser.update(s.data(),s.size());
+        }
+    }
+
+    // The parser takes running out of input as the end of a number, so it is only
+    // given no input when the text is complete
+    template <class CharT,class Allocator>
+    bool parser_needs_input(const basic_json_parser<CharT,Allocator>& parser)
+    {
+        return parser.source_exhausted() && parser.state() != json_parse_state::before_done;
+    }
+
+} // namespace detail
+
+    // basic_async_json_reader reads JSON texts from a basic_async_source, reporting their
+    // events to a visitor. read() suspends when the input runs dry and resumes when the
+    // producer supplies more, so that one thread can run any number of parses.
+
+    template <class CharT,class Allocator=std::allocator<char>>
+    class basic_async_json_reader : public ser_context
+    {
+        basic_async_source<CharT>& source_;
+        basic_json_parser<CharT,Allocator> parser_;
+        basic_json_visitor<CharT>& visitor_;
+        bool begin_;
+
+        // Noncopyable and nonmoveable
+        basic_async_json_reader(const basic_async_json_reader&) = delete;
+        basic_async_json_reader& operator=(const basic_async_json_reader&) = delete;
+    public:
+        basic_async_json_reader(basic_async_source<CharT>& source,
+                                basic_json_visitor<CharT>& visitor,
+                                const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>(),
+                                const Allocator& alloc = Allocator())
+            : source_(source), parser_(options, alloc), visitor_(visitor), begin_(true)
+        {
+        }
+
+        // Reads the next JSON text. Completes with true when the text has been read, and with
+        // false if the input ends before another text starts. Characters after the text
+        // are kept for the next read. Throws ser_error if the text is not valid JSON.
+        async_task<bool> read()
+        {
+            std::error_code ec;
+            async_task<bool> task = read(ec);
+            bool result = co_await task;
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec,line(),column()));
+            }
+            co_return result;
+        }
+
+        async_task<bool> read(std::error_code& ec)
+        {
+            parser_.reset();
+            for (;;)
+            {
+                parser_.skip_whitespace();
+                if (!parser_.source_exhausted())
+                {
+                    break;
+                }
+                span<const CharT> s = co_await source_.read();
+                if (s.empty())
+                {
+                    co_return false;
+                }
+                detail::update_parser(parser_, s, begin_, ec);
+                if (ec)
+                {
+                    co_return false;
+                }
+            }
+            while (!parser_.finished())
+            {
+                if (detail::parser_needs_input(parser_))
+                {
+                    span<const CharT> s = co_await source_.read();
+                    if (s.empty())
+                    {
+                        // The parser has the rest of the input
+                        parser_.finish_parse(visitor_, ec);
+                        break;
+                    }
+                    detail::update_parser(parser_, s, begin_, ec);
+                    if (ec)
+                    {
+                        co_return false;
+                    }
+                }
+                parser_.parse_some(visitor_, ec);
+                if (ec)
+                {
+                    co_return false;
+                }
+            }
+            co_return !ec;
+        }
+
+        std::size_t line() const override
+        {
+            return parser_.line();
+        }
+
+        std::size_t column() const override
+        {
+            return parser_.column();
+        }
+    };
+
+    // basic_async_json_cursor reports the events of a JSON text read from a basic_async_source
+    // one at a time. next() suspends when the input runs dry and resumes when the producer
+    // supplies more. A typical consumer is a loop
+    //
+    //     for (;;)
+    //     {
+    //         auto more = cursor.next();
+    //         if (!co_await more)
+    //         {
+    //             break;
+    //         }
+    //         const auto& event = cursor.current();
+    //     }
+    //
+    // (Some compilers mishandle a task awaited as a temporary in a loop condition.)
+
+    template <class CharT,class Allocator=std::allocator<char>>
+    class basic_async_json_cursor : public ser_context
+    {
+        basic_async_source<CharT>& source_;
+        basic_json_parser<CharT,Allocator> parser_;
+        basic_staj_visitor<CharT> cursor_visitor_;
+        bool begin_;
+
+        // Noncopyable and nonmoveable
+        basic_async_json_cursor(const basic_async_json_cursor&) = delete;
+        basic_async_json_cursor& operator=(const basic_async_json_cursor&) = delete;
+    public:
+        basic_async_json_cursor(basic_async_source<CharT>& source,
+                                const basic_json_decode_options<CharT>& options = basic_json_decode_options<CharT>(),
+                                const Allocator& alloc = Allocator())
+            : source_(source), parser_(options, alloc), cursor_visitor_(accept_all), begin_(true)
+        {
+        }
+
+        bool done() const
+        {
+            return parser_.done();
+        }
+
+        const basic_staj_event<CharT>& current() const
+        {
+            return cursor_visitor_.event();
+        }
+
+        // Advances to the next event. Completes with true if there is one, and with false
+        // after the last event of the JSON text. Throws ser_error if the text is not valid JSON.
+        async_task<bool> next()
+        {
+            std::error_code ec;
+            async_task<bool> task = next(ec);
+            bool result = co_await task;
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec,line(),column()));
+            }
+            co_return result;
+        }
+
+        async_task<bool> next(std::error_code& ec)
+        {
+            parser_.restart();
+            while (!parser_.stopped())
+            {
+                if (detail::parser_needs_input(parser_))
+                {
+                    span<const CharT> s = co_await source_.read();
+                    if (s.empty())
+                    {
+                        parser_.finish_parse(cursor_visitor_, ec);
+                        break;
+                    }
+                    detail::update_parser(parser_, s, begin_, ec);
+                    if (ec)
+                    {
+                        co_return false;
+                    }
+                }
+                parser_.parse_some(cursor_visitor_, ec);
+                if (ec)
+                {
+                    co_return false;
+                }
+            }
+            co_return !ec && !parser_.done();
+        }
+
+        std::size_t line() const override
+        {
+            return parser_.line();
+        }
+
+        std::size_t column() const override
+        {
+            return parser_.column();
+        }
+    private:
+        static bool accept_all(const basic_staj_event<CharT>&, const ser_context&)
+        {
+            return true;
+        }
+    };
+
+    using async_json_reader = basic_async_json_reader<char>;
+    using wasync_json_reader = basic_async_json_reader<wchar_t>;
+
+    using async_json_cursor = basic_async_json_cursor<char>;
+    using wasync_json_cursor = basic_async_json_cursor<wchar_t>;
+
+} // namespace jsoncons
+
+#endif // defined(JSONCONS_HAS_COROUTINES)
+
+#endif
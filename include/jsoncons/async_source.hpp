@@ -0,0 +1,313 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_ASYNC_SOURCE_HPP
+#define JSONCONS_ASYNC_SOURCE_HPP
+
+#include <jsoncons/config/jsoncons_config.hpp>
+
+#if defined(JSONCONS_HAS_COROUTINES)
+
+#include <cstddef>
+#include <coroutine>
+#include <exception> // std::exception_ptr
+#include <optional>
+#include <utility> // std::move, std::exchange
+#include <jsoncons/source.hpp>
+
+namespace jsoncons {
+
+    // async_task is the result of the coroutines of the async readers. It starts at once
+    // and runs until it needs input it does not have, then suspends until the input
+    // arrives. It may be awaited from another coroutine, which is resumed when it
+    // completes, or polled with done() and get().
+
+    template <class T>
+    class async_task;
+
+namespace detail {
+
+    struct async_final_awaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template <class Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            std::coroutine_handle<> continuation = handle.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    struct async_promise_base
+    {
+        std::coroutine_handle<> continuation;
+        std::exception_ptr exception;
+
+        std::suspend_never initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        async_final_awaiter final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void unhandled_exception() noexcept
+        {
+            exception = std::current_exception();
+        }
+    };
+
+    template <class T>
+    struct async_promise : async_promise_base
+    {
+        std::optional<T> value;
+
+        async_task<T> get_return_object() noexcept;
+
+        template <class U>
+        void return_value(U&& val)
+        {
+            value.emplace(std::forward<U>(val));
+        }
+
+        T result()
+        {
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+            return std::move(*value);
+        }
+    };
+
+    template <>
+    struct async_promise<void> : async_promise_base
+    {
+        async_task<void> get_return_object() noexcept;
+
+        void return_void() noexcept
+        {
+        }
+
+        void result()
+        {
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+    };
+
+} // namespace detail
+
+    template <class T = void>
+    class async_task
+    {
+    public:
+        using promise_type = detail::async_promise<T>;
+    private:
+        std::coroutine_handle<promise_type> handle_;
+
+        // Noncopyable
+        async_task(const async_task&) = delete;
+        async_task& operator=(const async_task&) = delete;
+    public:
+        explicit async_task(std::coroutine_handle<promise_type> handle) noexcept
+            : handle_(handle)
+        {
+        }
+
+        async_task(async_task&& other) noexcept
+            : handle_(std::exchange(other.handle_, nullptr))
+        {
+        }
+
+        async_task& operator=(async_task&& other) noexcept
+        {
+            std::swap(handle_, other.handle_);
+            return *this;
+        }
+
+        ~async_task() noexcept
+        {
+            if (handle_)
+            {
+                handle_.destroy();
+            }
+        }
+
+        bool done() const noexcept
+        {
+            return handle_.done();
+        }
+
+        // Returns the result of a completed task, or rethrows its exception
+        T get()
+        {
+            JSONCONS_ASSERT(handle_.done());
+            return handle_.promise().result();
+        }
+
+        auto operator co_await() noexcept
+        {
+            struct awaiter
+            {
+                std::coroutine_handle<promise_type> handle;
+
+                bool await_ready() const noexcept
+                {
+                    return handle.done();
+                }
+
+                void await_suspend(std::coroutine_handle<> continuation) noexcept
+                {
+                    handle.promise().continuation = continuation;
+                }
+
+                T await_resume()
+                {
+                    return handle.promise().result();
+                }
+            };
+            return awaiter{handle_};
+        }
+    };
+
+namespace detail {
+
+    template <class T>
+    async_task<T> async_promise<T>::get_return_object() noexcept
+    {
+        return async_task<T>(std::coroutine_handle<async_promise<T>>::from_promise(*this));
+    }
+
+    inline
+    async_task<void> async_promise<void>::get_return_object() noexcept
+    {
+        return async_task<void>(std::coroutine_handle<async_promise<void>>::from_promise(*this));
+    }
+
+} // namespace detail
+
+    // basic_async_source passes input from a producer, e.g. the completion handler of an
+    // asynchronous socket read, to one async reader or cursor. A reader that has used up
+    // its input suspends in co_await read(). update() hands it the next chunk and resumes
+    // it on the calling thread, so update() returns once the reader has consumed the
+    // chunk and is waiting again, or has completed. close() signals the end of input.
+    //
+    // The data passed to update must stay valid until the reader is waiting again or
+    // has completed.
+
+    template <class CharT>
+    class basic_async_source
+    {
+    public:
+        using value_type = CharT;
+    private:
+        const value_type* data_;
+        std::size_t length_;
+        bool closed_;
+        std::coroutine_handle<> waiting_;
+
+        // Noncopyable and nonmoveable
+        basic_async_source(const basic_async_source&) = delete;
+        basic_async_source& operator=(const basic_async_source&) = delete;
+    public:
+        basic_async_source()
+            : data_(nullptr), length_(0), closed_(false)
+        {
+        }
+
+        // Returns true if a reader is suspended waiting for input
+        bool waiting() const noexcept
+        {
+            return static_cast<bool>(waiting_);
+        }
+
+        bool closed() const noexcept
+        {
+            return closed_;
+        }
+
+        void update(const value_type* data, std::size_t length)
+        {
+            JSONCONS_ASSERT(length_ == 0 && !closed_);
+            if (length == 0)
+            {
+                return;
+            }
+            data_ = data;
+            length_ = length;
+            resume();
+        }
+
+        void update(const span<const value_type>& data)
+        {
+            update(data.data(), data.size());
+        }
+
+        void close()
+        {
+            closed_ = true;
+            resume();
+        }
+
+        // Awaits the next chunk of input, which is empty at the end of input
+        auto read() noexcept
+        {
+            struct awaiter
+            {
+                basic_async_source* self;
+
+                bool await_ready() const noexcept
+                {
+                    return self->length_ > 0 || self->closed_;
+                }
+
+                void await_suspend(std::coroutine_handle<> handle) noexcept
+                {
+                    self->waiting_ = handle;
+                }
+
+                span<const value_type> await_resume() noexcept
+                {
+                    span<const value_type> s(self->data_, self->length_);
+                    self->data_ = nullptr;
+                    self->length_ = 0;
+                    return s;
+                }
+            };
+            return awaiter{this};
+        }
+    private:
+        void resume()
+        {
+            if (waiting_)
+            {
+                std::exchange(waiting_, nullptr).resume();
+            }
+        }
+    };
+
+    using async_source = basic_async_source<char>;
+    using wasync_source = basic_async_source<wchar_t>;
+    using binary_async_source = basic_async_source<uint8_t>;
+
+} // namespace jsoncons
+
+#endif // defined(JSONCONS_HAS_COROUTINES)
+
+#endif
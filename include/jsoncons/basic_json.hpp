@@ -28,6 +28,7 @@
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/pretty_print.hpp>
 #include <jsoncons/json_container_types.hpp>
+#include <jsoncons/container_ptr.hpp>
 #include <jsoncons/bigint.hpp>
 #include <jsoncons/json_options.hpp>
 #include <jsoncons/json_encoder.hpp>
@@ -113,7 +114,7 @@ namespace detail {
 
         pointer operator->() const 
         {
-            return &(*it_);
+            return get_pointer(it_, std::is_lvalue_reference<reference>());
         }
 
         random_access_iterator_wrapper& operator++() 
@@ -225,6 +226,17 @@ namespace detail {
         {
             return next += offset;
         }
+    private:
+        static pointer get_pointer(const Iterator& it, std::true_type) 
+        {
+            return &(*it);
+        }
+
+        // The iterator yields a proxy rather than a reference, and provides its own pointer 
+        static pointer get_pointer(const Iterator& it, std::false_type) 
+        {
+            return it.operator->();
+        }
     };
 } // namespace detail
 } // namespace jsoncons
@@ -241,6 +253,10 @@ struct sorted_policy
     template <class CharT, class CharTraits, class Allocator>
     using key_storage = std::basic_string<CharT, CharTraits,Allocator>;
 
+    using array_layout = generic_array_layout;
+
+    using container_storage = unique_container_storage;
+
     using parse_error_handler_type = default_json_parsing;
 };
 
@@ -249,6 +265,35 @@ struct preserve_order_policy : public sorted_policy
     using key_order = preserve_key_order;
 };
 
+// Preserves insertion order like preserve_order_policy, and keeps a hash index 
+// of the keys of objects with more than a few members
+struct hash_index_policy : public sorted_policy
+{
+    using key_order = hash_index_key_order;
+};
+
+// Sorts keys like sorted_policy, and packs arrays of numbers of one kind,
+// double, int64_t, uint64_t or float, into contiguous storage
+struct packed_array_policy : public sorted_policy
+{
+    using array_layout = packed_array_layout;
+};
+
+// Preserves insertion order like preserve_order_policy, and keeps the keys of an
+// object in a shape that objects with the same keys in the same order share, so that 
+// each object stores only its values
+struct shape_policy : public sorted_policy
+{
+    using key_order = shape_key_order;
+};
+
+// Sorts keys like sorted_policy, and shares arrays and objects between copies, 
+// copying an array or object when it is modified if it is shared
+struct shared_container_policy : public sorted_policy
+{
+    using container_storage = shared_container_storage;
+};
+
 template <class IteratorT, class ConstIteratorT>
 class range 
 {
@@ -331,7 +376,7 @@ public:
 
     using char_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<char_type>;
 
-    using key_type = std::basic_string<char_type,char_traits_type,char_allocator_type>;
+    using key_type = typename implementation_policy::template key_storage<char_type,char_traits_type,char_allocator_type>;
 
 
     using reference = basic_json&;
@@ -690,89 +735,66 @@ private:
         uint8_t length_:4;
         semantic_tag tag_;
     private:
-        using array_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<array>;
-        using pointer = typename std::allocator_traits<array_allocator>::pointer;
-
-        pointer ptr_;
-
-        template <typename... Args>
-        void create(array_allocator alloc, Args&& ... args)
-        {
-            ptr_ = std::allocator_traits<array_allocator>::allocate(alloc, 1);
-            JSONCONS_TRY
-            {
-                std::allocator_traits<array_allocator>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
-            }
-            JSONCONS_CATCH(...)
-            {
-                std::allocator_traits<array_allocator>::deallocate(alloc, ptr_,1);
-                JSONCONS_RETHROW;
-            }
-        }
+        using container_ptr_type = jsoncons::detail::container_ptr<array,Allocator,typename implementation_policy::container_storage>;
 
-        void destroy() noexcept
-        {
-            array_allocator alloc(ptr_->get_allocator());
-            std::allocator_traits<array_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
-            std::allocator_traits<array_allocator>::deallocate(alloc, ptr_,1);
-        }
+        container_ptr_type ptr_;
     public:
         array_storage(const array& val, semantic_tag tag)
             : storage_(static_cast<uint8_t>(storage_kind::array_value)), length_(0), tag_(tag)
         {
-            create(val.get_allocator(), val);
+            ptr_.create(val.get_allocator(), val);
         }
 
         array_storage(const array& val, semantic_tag tag, const Allocator& a)
             : storage_(val.storage_), length_(0), tag_(val.tag_)
         {
-            create(array_allocator(a), val, a);
+            ptr_.create(a, val, a);
         }
 
         array_storage(const array_storage& val)
-            : storage_(val.storage_), length_(0), tag_(val.tag_)
+            : storage_(val.storage_), length_(0), tag_(val.tag_), ptr_(val.ptr_)
         {
-            create(val.ptr_->get_allocator(), *(val.ptr_));
         }
 
         array_storage(array_storage&& val) noexcept
             : storage_(val.storage_), length_(0), tag_(val.tag_),
-              ptr_(nullptr)
+              ptr_(std::move(val.ptr_))
         {
-            std::swap(val.ptr_, ptr_);
         }
 
         array_storage(const array_storage& val, const Allocator& a)
-            : storage_(val.storage_), length_(0), tag_(val.tag_)
+            : storage_(val.storage_), length_(0), tag_(val.tag_), ptr_(val.ptr_, a)
         {
-            create(array_allocator(a), *(val.ptr_), a);
-        }
-        ~array_storage() noexcept
-        {
-            if (ptr_ != nullptr)
-            {
-                destroy();
-            }
         }
 
         allocator_type get_allocator() const
         {
-            return ptr_->get_allocator();
+            return ptr_.get_allocator();
         }
 
         void swap(array_storage& val) noexcept
         {
-            std::swap(val.ptr_,ptr_);
+            ptr_.swap(val.ptr_);
+        }
+
+        std::size_t use_count() const noexcept
+        {
+            return ptr_.use_count();
         }
 
         array& value()
         {
-            return *ptr_;
+            return ptr_.get_mutable();
+        }
+
+        array& unshared_value()
+        {
+            return ptr_.get_unshared();
         }
 
         const array& value() const
         {
-            return *ptr_;
+            return ptr_.get();
         }
     };
 
@@ -784,91 +806,66 @@ private:
         uint8_t length_:4;
         semantic_tag tag_;
     private:
-        using object_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<object>;
-        using pointer = typename std::allocator_traits<object_allocator>::pointer;
+        using container_ptr_type = jsoncons::detail::container_ptr<object,Allocator,typename implementation_policy::container_storage>;
 
-        pointer ptr_;
-
-        template <typename... Args>
-        void create(object_allocator alloc, Args&& ... args)
-        {
-            ptr_ = std::allocator_traits<object_allocator>::allocate(alloc, 1);
-            JSONCONS_TRY
-            {
-                std::allocator_traits<object_allocator>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
-            }
-            JSONCONS_CATCH(...)
-            {
-                std::allocator_traits<object_allocator>::deallocate(alloc, ptr_,1);
-                JSONCONS_RETHROW;
-            }
-        }
+        container_ptr_type ptr_;
     public:
         explicit object_storage(const object& val, semantic_tag tag)
             : storage_(static_cast<uint8_t>(storage_kind::object_value)), length_(0), tag_(tag)
         {
-            create(val.get_allocator(), val);
+            ptr_.create(val.get_allocator(), val);
         }
 
         explicit object_storage(const object& val, semantic_tag tag, const Allocator& a)
             : storage_(val.storage_), length_(0), tag_(val.tag_)
         {
-            create(object_allocator(a), val, a);
+            ptr_.create(a, val, a);
         }
 
         explicit object_storage(const object_storage& val)
-            : storage_(val.storage_), length_(0), tag_(val.tag_)
+            : storage_(val.storage_), length_(0), tag_(val.tag_), ptr_(val.ptr_)
         {
-            create(val.ptr_->get_allocator(), *(val.ptr_));
         }
 
         explicit object_storage(object_storage&& val) noexcept
             : storage_(val.storage_), length_(0), tag_(val.tag_),
-              ptr_(nullptr)
+              ptr_(std::move(val.ptr_))
         {
-            std::swap(val.ptr_,ptr_);
         }
 
         explicit object_storage(const object_storage& val, const Allocator& a)
-            : storage_(val.storage_), tag_(val.tag_)
+            : storage_(val.storage_), tag_(val.tag_), ptr_(val.ptr_, a)
         {
-            create(object_allocator(a), *(val.ptr_), a);
         }
 
-        ~object_storage() noexcept
+        void swap(object_storage& val) noexcept
         {
-            if (ptr_ != nullptr)
-            {
-                destroy();
-            }
+            ptr_.swap(val.ptr_);
         }
 
-        void swap(object_storage& val) noexcept
+        std::size_t use_count() const noexcept
         {
-            std::swap(val.ptr_,ptr_);
+            return ptr_.use_count();
         }
 
         object& value()
         {
-            return *ptr_;
+            return ptr_.get_mutable();
         }
 
-        const object& value() const
+        object& unshared_value()
         {
-            return *ptr_;
+            return ptr_.get_unshared();
         }
 
-        allocator_type get_allocator() const
+        const object& value() const
         {
-            return ptr_->get_allocator();
+            return ptr_.get();
         }
-    private:
 
-        void destroy() noexcept
+        allocator_type get_allocator() const
         {
-            object_allocator alloc(ptr_->get_allocator());
-            std::allocator_traits<object_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
-            std::allocator_traits<object_allocator>::deallocate(alloc, ptr_,1);
+            return ptr_.get_allocator();
         }
     };
 
@@ -2432,6 +2429,21 @@ public:
         return static_cast<storage_kind>(common_stor_.storage_);
     }
 
+    // Returns the number of values that share this array or object, which may be more
+    // than one with shared_container_storage, otherwise 1
+    std::size_t use_count() const noexcept
+    {
+        switch (storage())
+        {
+            case storage_kind::array_value:
+                return cast<array_storage>().use_count();
+            case storage_kind::object_value:
+                return cast<object_storage>().use_count();
+            default:
+                return 1;
+        }
+    }
+
     json_type type() const
     {
         switch(storage())
@@ -2852,17 +2864,16 @@ public:
           const basic_json_decode_options<char_type>& options = basic_json_decode_options<CharT>(), 
           std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing())
     {
-        json_decoder<basic_json> decoder;
-        basic_json_parser<char_type> parser(options,err_handler);
-
         auto result = unicons::skip_bom(s.begin(), s.end());
         if (result.ec != unicons::encoding_errc())
         {
             JSONCONS_THROW(ser_error(result.ec));
         }
+        json_decoder<basic_json> decoder;
+        basic_json_parser<char_type> parser(options,err_handler);
+
         std::size_t offset = result.it - s.begin();
         parser.update(s.data()+offset,s.size()-offset);
-        parser.parse_some(decoder);
         parser.finish_parse(decoder);
         parser.check_done();
         if (!decoder.is_valid())
@@ -3833,17 +3844,17 @@ public:
             switch (storage())
             {
                 case storage_kind::array_value:
-                    array_value().reserve(n);
+                    unshared_array_value().reserve(n);
                     break;
                 case storage_kind::empty_object_value:
                 {
                     create_object_implicitly();
-                    object_value().reserve(n);
+                    unshared_object_value().reserve(n);
                 }
                 break;
                 case storage_kind::object_value:
                 {
-                    object_value().reserve(n);
+                    unshared_object_value().reserve(n);
                 }
                     break;
                 default:
@@ -3857,7 +3868,7 @@ public:
         switch (storage())
         {
             case storage_kind::array_value:
-                array_value().resize(n);
+                unshared_array_value().resize(n);
                 break;
             default:
                 break;
@@ -3870,7 +3881,7 @@ public:
         switch (storage())
         {
             case storage_kind::array_value:
-                array_value().resize(n, val);
+                unshared_array_value().resize(n, val);
                 break;
             default:
                 break;
@@ -4241,10 +4252,10 @@ public:
         switch (storage())
         {
         case storage_kind::array_value:
-            array_value().shrink_to_fit();
+            unshared_array_value().shrink_to_fit();
             break;
         case storage_kind::object_value:
-            object_value().shrink_to_fit();
+            unshared_object_value().shrink_to_fit();
             break;
         default:
             break;
@@ -4256,10 +4267,10 @@ public:
         switch (storage())
         {
         case storage_kind::array_value:
-            array_value().clear();
+            unshared_array_value().clear();
             break;
         case storage_kind::object_value:
-            object_value().clear();
+            unshared_object_value().clear();
             break;
         default:
             break;
@@ -4273,8 +4284,12 @@ public:
         case storage_kind::empty_object_value:
             break;
         case storage_kind::object_value:
-            object_value().erase(pos);
+        {
+            const auto offset = object_offset_(pos);
+            object& obj = unshared_object_value();
+            obj.erase(obj.begin() + offset);
             break;
+        }
         default:
             JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
             break;
@@ -4288,8 +4303,13 @@ public:
         case storage_kind::empty_object_value:
             break;
         case storage_kind::object_value:
-            object_value().erase(first, last);
+        {
+            const auto first_offset = object_offset_(first);
+            const auto last_offset = object_offset_(last);
+            object& obj = unshared_object_value();
+            obj.erase(obj.begin() + first_offset, obj.begin() + last_offset);
             break;
+        }
         default:
             JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
             break;
@@ -4301,8 +4321,12 @@ public:
         switch (storage())
         {
         case storage_kind::array_value:
-            array_value().erase(pos);
+        {
+            const auto offset = array_offset_(pos);
+            array& arr = unshared_array_value();
+            arr.erase(arr.begin() + offset);
             break;
+        }
         default:
             JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
             break;
@@ -4314,8 +4338,13 @@ public:
         switch (storage())
         {
         case storage_kind::array_value:
-            array_value().erase(first, last);
+        {
+            const auto first_offset = array_offset_(first);
+            const auto last_offset = array_offset_(last);
+            array& arr = unshared_array_value();
+            arr.erase(arr.begin() + first_offset, arr.begin() + last_offset);
             break;
+        }
         default:
             JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
             break;
@@ -4331,7 +4360,7 @@ public:
         case storage_kind::empty_object_value:
             break;
         case storage_kind::object_value:
-            object_value().erase(name);
+            unshared_object_value().erase(name);
             break;
         default:
             JSONCONS_THROW(not_an_object(name.data(),name.length()));
@@ -4389,7 +4418,7 @@ public:
             create_object_implicitly();
             JSONCONS_FALLTHROUGH;
         case storage_kind::object_value:
-            object_value().merge(source.object_value());
+            unshared_object_value().merge(source.object_value());
             break;
         default:
             {
@@ -4406,7 +4435,7 @@ public:
             create_object_implicitly();
             JSONCONS_FALLTHROUGH;
         case storage_kind::object_value:
-            object_value().merge(std::move(source.object_value()));
+            unshared_object_value().merge(std::move(source.unshared_object_value()));
             break;
         default:
             {
@@ -4423,7 +4452,7 @@ public:
             create_object_implicitly();
             JSONCONS_FALLTHROUGH;
         case storage_kind::object_value:
-            object_value().merge(hint, source.object_value());
+            unshared_object_value().merge(hint, source.object_value());
             break;
         default:
             {
@@ -4440,7 +4469,7 @@ public:
             create_object_implicitly();
             JSONCONS_FALLTHROUGH;
         case storage_kind::object_value:
-            object_value().merge(hint, std::move(source.object_value()));
+            unshared_object_value().merge(hint, std::move(source.unshared_object_value()));
             break;
         default:
             {
@@ -4459,7 +4488,7 @@ public:
             create_object_implicitly();
             JSONCONS_FALLTHROUGH;
         case storage_kind::object_value:
-            object_value().merge_or_update(source.object_value());
+            unshared_object_value().merge_or_update(source.object_value());
             break;
         default:
             {
@@ -4476,7 +4505,7 @@ public:
             create_object_implicitly();
             JSONCONS_FALLTHROUGH;
         case storage_kind::object_value:
-            object_value().merge_or_update(std::move(source.object_value()));
+            unshared_object_value().merge_or_update(std::move(source.unshared_object_value()));
             break;
         default:
             {
@@ -4493,7 +4522,7 @@ public:
             create_object_implicitly();
             JSONCONS_FALLTHROUGH;
         case storage_kind::object_value:
-            object_value().merge_or_update(hint, source.object_value());
+            unshared_object_value().merge_or_update(hint, source.object_value());
             break;
         default:
             {
@@ -4510,7 +4539,7 @@ public:
             create_object_implicitly();
             JSONCONS_FALLTHROUGH;
         case storage_kind::object_value:
-            object_value().merge_or_update(hint, std::move(source.object_value()));
+            unshared_object_value().merge_or_update(hint, std::move(source.unshared_object_value()));
             break;
         default:
             {
@@ -4559,8 +4588,11 @@ public:
         switch (storage())
         {
         case storage_kind::array_value:
-            return array_value().insert(pos, std::forward<T>(val));
-            break;
+        {
+            const auto offset = array_offset_(pos);
+            array& arr = array_value();
+            return arr.insert(arr.begin() + offset, std::forward<T>(val));
+        }
         default:
             {
                 JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to insert into a value that is not an array"));
@@ -4574,8 +4606,11 @@ public:
         switch (storage())
         {
         case storage_kind::array_value:
-            return array_value().insert(pos, first, last);
-            break;
+        {
+            const auto offset = array_offset_(pos);
+            array& arr = array_value();
+            return arr.insert(arr.begin() + offset, first, last);
+        }
         default:
             {
                 JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to insert into a value that is not an array"));
@@ -4590,7 +4625,7 @@ public:
         {
         case storage_kind::empty_object_value:
         case storage_kind::object_value:
-            object_value().insert(first, last, get_key_value<key_type,basic_json>());
+            unshared_object_value().insert(first, last, get_key_value<key_type,basic_json>());
             break;
         default:
             {
@@ -4606,7 +4641,7 @@ public:
         {
         case storage_kind::empty_object_value:
         case storage_kind::object_value:
-            object_value().insert(tag, first, last, get_key_value<key_type,basic_json>());
+            unshared_object_value().insert(tag, first, last, get_key_value<key_type,basic_json>());
             break;
         default:
             {
@@ -4621,8 +4656,11 @@ public:
         switch (storage())
         {
         case storage_kind::array_value:
-            return array_value().emplace(pos, std::forward<Args>(args)...);
-            break;
+        {
+            const auto offset = array_offset_(pos);
+            array& arr = array_value();
+            return arr.emplace(arr.begin() + offset, std::forward<Args>(args)...);
+        }
         default:
             {
                 JSONCONS_THROW(json_runtime_error<std::domain_error>("Attempting to insert into a value that is not an array"));
@@ -4655,7 +4693,7 @@ public:
         switch (storage())
         {
         case storage_kind::array_value:
-            array_value().push_back(std::forward<T>(val));
+            unshared_array_value().push_back(std::forward<T>(val));
             break;
         default:
             {
@@ -5224,7 +5262,7 @@ public:
         switch (storage())
         {
         case storage_kind::array_value:
-            array_value().remove_range(from_index, to_index);
+            unshared_array_value().remove_range(from_index, to_index);
             break;
         default:
             break;
@@ -5391,6 +5429,52 @@ public:
     }
 
 private:
+    template <class Json,class TempAllocator>
+    friend class json_decoder;
+
+    // Non-const access to the array or object for modifications that hand out no 
+    // references into it, which leaves it shareable with shared_container_storage
+
+    array& unshared_array_value() 
+    {
+        switch (storage())
+        {
+            case storage_kind::array_value:
+                return cast<array_storage>().unshared_value();
+            default:
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Bad array cast"));
+                break;
+        }
+    }
+
+    object& unshared_object_value()
+    {
+        switch (storage())
+        {
+            case storage_kind::empty_object_value:
+                create_object_implicitly();
+                JSONCONS_FALLTHROUGH;
+            case storage_kind::object_value:
+                return cast<object_storage>().unshared_value();
+            default:
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Bad object cast"));
+                break;
+        }
+    }
+
+    // An iterator obtained through const access may point into an array or object that is 
+    // shared with copies, which is copied before it is modified. Modifications that take 
+    // iterators convert them to offsets first, and rebase them onto the modified container.
+
+    std::ptrdiff_t array_offset_(const_array_iterator it) const
+    {
+        return it - array_value().begin();
+    }
+
+    std::ptrdiff_t object_offset_(const_object_iterator it) const
+    {
+        return it - const_object_iterator(object_value().begin());
+    }
 
     void dump_noflush(basic_json_visitor<char_type>& visitor, std::error_code& ec) const
     {
@@ -5451,8 +5535,25 @@ private:
             }
             case storage_kind::array_value:
             {
-                bool more = visitor.begin_array(size(), tag(), context, ec);
                 const array& o = array_value();
+                switch (o.packing())
+                {
+                    case jsoncons::detail::packed_kind::float32_value:
+                        visitor.typed_array(o.template packed_data<float>(), tag(), context, ec);
+                        return;
+                    case jsoncons::detail::packed_kind::float64_value:
+                        visitor.typed_array(o.template packed_data<double>(), tag(), context, ec);
+                        return;
+                    case jsoncons::detail::packed_kind::int64_value:
+                        visitor.typed_array(o.template packed_data<int64_t>(), tag(), context, ec);
+                        return;
+                    case jsoncons::detail::packed_kind::uint64_value:
+                        visitor.typed_array(o.template packed_data<uint64_t>(), tag(), context, ec);
+                        return;
+                    default:
+                        break;
+                }
+                bool more = visitor.begin_array(size(), tag(), context, ec);
                 for (const_array_iterator it = o.begin(); more && it != o.end(); ++it)
                 {
                     it->dump_noflush(visitor, ec);
@@ -5499,6 +5600,7 @@ using json = basic_json<char,sorted_policy,std::allocator<char>>;
 using wjson = basic_json<wchar_t,sorted_policy,std::allocator<char>>;
 using ojson = basic_json<char, preserve_order_policy, std::allocator<char>>;
 using wojson = basic_json<wchar_t, preserve_order_policy, std::allocator<char>>;
+using shared_json = basic_json<char, shared_container_policy, std::allocator<char>>;
 
 #if !defined(JSONCONS_NO_DEPRECATED)
 JSONCONS_DEPRECATED_MSG("Instead, use wojson") typedef basic_json<wchar_t, preserve_order_policy, std::allocator<wchar_t>> owjson;
@@ -0,0 +1,152 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CALLBACK_SINK_HPP
+#define JSONCONS_CALLBACK_SINK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <algorithm> // std::min
+#include <functional> // std::function
+#include <memory> // std::allocator
+#include <vector>
+#include <utility> // std::move
+#include <jsoncons/config/jsoncons_config.hpp>
+
+namespace jsoncons {
+
+    // callback_sink fills buffers of buffer_length elements and hands each full buffer,
+    // by move, to a write callback, e.g. one that queues it on an asynchronous writer.
+    // New buffers come from an optional acquire callback, so that buffers the writer is
+    // done with can be reused, and memory stays constant however large the output.
+    // flush() hands over a partly filled buffer.
+
+    template <class T,class Allocator=std::allocator<T>>
+    class callback_sink
+    {
+    public:
+        using value_type = T;
+        using buffer_type = std::vector<T,Allocator>;
+        using write_function = std::function<void(buffer_type&&)>;
+        using acquire_function = std::function<buffer_type()>;
+        static constexpr std::size_t default_buffer_length = 16384;
+    private:
+        write_function write_;
+        acquire_function acquire_;
+        std::size_t buffer_length_;
+        buffer_type buffer_;
+        value_type* begin_buffer_;
+        value_type* end_buffer_;
+        value_type* p_;
+
+        // Noncopyable
+        callback_sink(const callback_sink&) = delete;
+        callback_sink& operator=(const callback_sink&) = delete;
+    public:
+        explicit callback_sink(write_function write, std::size_t buffer_length = default_buffer_length)
+            : callback_sink(std::move(write), acquire_function(), buffer_length)
+        {
+        }
+
+        callback_sink(write_function write, acquire_function acquire,
+                      std::size_t buffer_length = default_buffer_length)
+            : write_(std::move(write)), acquire_(std::move(acquire)),
+              buffer_length_(buffer_length > 0 ? buffer_length : 1),
+              begin_buffer_(nullptr), end_buffer_(nullptr), p_(nullptr)
+        {
+        }
+
+        callback_sink(callback_sink&& other) noexcept
+            : buffer_length_(other.buffer_length_), begin_buffer_(nullptr), end_buffer_(nullptr), p_(nullptr)
+        {
+            swap(other);
+        }
+
+        ~callback_sink() noexcept
+        {
+            JSONCONS_TRY
+            {
+                flush();
+            }
+            JSONCONS_CATCH(...)
+            {
+            }
+        }
+
+        callback_sink& operator=(callback_sink&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        void flush()
+        {
+            if (p_ != begin_buffer_)
+            {
+                hand_off();
+            }
+        }
+
+        void append(const value_type* s, std::size_t length)
+        {
+            while (length > 0)
+            {
+                if (p_ == end_buffer_)
+                {
+                    next_buffer();
+                }
+                std::size_t len = (std::min)(length, static_cast<std::size_t>(end_buffer_ - p_));
+                std::memcpy(p_, s, len*sizeof(value_type));
+                p_ += len;
+                s += len;
+                length -= len;
+            }
+        }
+
+        void push_back(value_type ch)
+        {
+            if (p_ == end_buffer_)
+            {
+                next_buffer();
+            }
+            *p_++ = ch;
+        }
+
+        void swap(callback_sink& other) noexcept
+        {
+            std::swap(write_, other.write_);
+            std::swap(acquire_, other.acquire_);
+            std::swap(buffer_length_, other.buffer_length_);
+            buffer_.swap(other.buffer_);
+            std::swap(begin_buffer_, other.begin_buffer_);
+            std::swap(end_buffer_, other.end_buffer_);
+            std::swap(p_, other.p_);
+        }
+    private:
+        void hand_off()
+        {
+            buffer_.resize(p_ - begin_buffer_);
+            begin_buffer_ = end_buffer_ = p_ = nullptr;
+            write_(std::move(buffer_));
+        }
+
+        void next_buffer()
+        {
+            if (p_ != begin_buffer_)
+            {
+                hand_off();
+            }
+            buffer_ = acquire_ ? acquire_() : buffer_type();
+            buffer_.resize(buffer_length_);
+            begin_buffer_ = p_ = buffer_.data();
+            end_buffer_ = begin_buffer_ + buffer_.size();
+        }
+    };
+
+} // namespace jsoncons
+
+#endif
@@ -182,6 +182,30 @@
 #  endif // defined(JSONCONS_HAS_2017)
 #endif // !defined(JSONCONS_HAS_FILESYSTEM)
 
+#if !defined(JSONCONS_HAS_COROUTINES)
+#  if defined(__cpp_impl_coroutine) && defined(__has_include)
+#    if __has_include(<coroutine>)
+#      define JSONCONS_HAS_COROUTINES 1
+#    endif // __has_include(<coroutine>)
+#  endif // defined(__cpp_impl_coroutine)
+#endif // !defined(JSONCONS_HAS_COROUTINES)
+
+// SIMD support. Define JSONCONS_NO_SIMD to force the scalar code paths.
+#if !defined(JSONCONS_NO_SIMD)
+#  if !defined(JSONCONS_HAS_SSE2)
+#    if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#      define JSONCONS_HAS_SSE2 1
+#    endif
+#  endif
+// AVX2 code paths are compiled with a function level target attribute
+// and selected at runtime after checking the cpu
+#  if !defined(JSONCONS_HAS_AVX2_DISPATCH) && defined(JSONCONS_HAS_SSE2)
+#    if ((defined(__GNUC__) && __GNUC__ >= 5) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#      define JSONCONS_HAS_AVX2_DISPATCH 1
+#    endif
+#  endif
+#endif // !defined(JSONCONS_NO_SIMD)
+
 #if (!defined(JSONCONS_NO_EXCEPTIONS))
 // Check if exceptions are disabled.
 #  if defined( __cpp_exceptions) && __cpp_exceptions == 0
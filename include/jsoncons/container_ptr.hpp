@@ -0,0 +1,283 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CONTAINER_PTR_HPP
+#define JSONCONS_CONTAINER_PTR_HPP
+
+#include <atomic>
+#include <memory> // std::allocator
+#include <utility> // std::move, std::swap
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/more_type_traits.hpp>
+
+namespace jsoncons {
+
+    // Tags for the container_storage member of an implementation policy
+
+    // Each basic_json owns its array or object, and a copy of a basic_json is a deep copy
+    struct unique_container_storage
+    {
+        explicit unique_container_storage() = default;
+    };
+
+    // Copies of a basic_json share its array or object, which is reference counted.
+    // The array or object is copied before it is modified if it is shared. Once a 
+    // reference or iterator into it may have been handed out, it is no longer shared:
+    // later copies of the basic_json copy it, so that writes through the reference 
+    // are not seen by the copies.
+    struct shared_container_storage
+    {
+        explicit shared_container_storage() = default;
+    };
+
+namespace detail {
+
+    // container_ptr holds the heap allocated array or object of a basic_json
+
+    template <class T,class Allocator,class Storage>
+    class container_ptr
+    {
+    };
+
+    template <class T,class Allocator>
+    class container_ptr<T,Allocator,unique_container_storage>
+    {
+    public:
+        using allocator_type = Allocator;
+    private:
+        using container_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<T>;
+        using pointer = typename std::allocator_traits<container_allocator>::pointer;
+
+        pointer ptr_;
+    public:
+        container_ptr() noexcept
+            : ptr_(nullptr)
+        {
+        }
+
+        container_ptr(const container_ptr& other)
+            : ptr_(nullptr)
+        {
+            create(other.ptr_->get_allocator(), *(other.ptr_));
+        }
+
+        container_ptr(const container_ptr& other, const Allocator& alloc)
+            : ptr_(nullptr)
+        {
+            create(alloc, *(other.ptr_), alloc);
+        }
+
+        container_ptr(container_ptr&& other) noexcept
+            : ptr_(nullptr)
+        {
+            std::swap(other.ptr_, ptr_);
+        }
+
+        ~container_ptr() noexcept
+        {
+            if (ptr_ != nullptr)
+            {
+                container_allocator alloc(ptr_->get_allocator());
+                std::allocator_traits<container_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
+                std::allocator_traits<container_allocator>::deallocate(alloc, ptr_,1);
+            }
+        }
+
+        container_ptr& operator=(const container_ptr&) = delete;
+        container_ptr& operator=(container_ptr&&) = delete;
+
+        template <typename... Args>
+        void create(const Allocator& a, Args&& ... args)
+        {
+            container_allocator alloc(a);
+            ptr_ = std::allocator_traits<container_allocator>::allocate(alloc, 1);
+            JSONCONS_TRY
+            {
+                std::allocator_traits<container_allocator>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
+            }
+            JSONCONS_CATCH(...)
+            {
+                std::allocator_traits<container_allocator>::deallocate(alloc, ptr_,1);
+                ptr_ = nullptr;
+                JSONCONS_RETHROW;
+            }
+        }
+
+        allocator_type get_allocator() const
+        {
+            return ptr_->get_allocator();
+        }
+
+        void swap(container_ptr& other) noexcept
+        {
+            std::swap(other.ptr_,ptr_);
+        }
+
+        std::size_t use_count() const noexcept
+        {
+            return 1;
+        }
+
+        const T& get() const
+        {
+            return *ptr_;
+        }
+
+        T& get_mutable()
+        {
+            return *ptr_;
+        }
+
+        T& get_unshared()
+        {
+            return *ptr_;
+        }
+    };
+
+    template <class T,class Allocator>
+    class container_ptr<T,Allocator,shared_container_storage>
+    {
+    public:
+        using allocator_type = Allocator;
+    private:
+        struct node
+        {
+            std::atomic<std::size_t> count_;
+            // false once a reference into value_ may have been handed out
+            bool shareable_;
+            T value_;
+
+            template <typename... Args>
+            node(Args&& ... args)
+                : count_(1), shareable_(true), value_(std::forward<Args>(args)...)
+            {
+            }
+        };
+
+        using node_allocator = typename std::allocator_traits<Allocator>:: template rebind_alloc<node>;
+        using pointer = typename std::allocator_traits<node_allocator>::pointer;
+
+        pointer ptr_;
+    public:
+        container_ptr() noexcept
+            : ptr_(nullptr)
+        {
+        }
+
+        // Shares the container of other unless it is unshareable
+        container_ptr(const container_ptr& other)
+            : ptr_(nullptr)
+        {
+            if (other.ptr_->shareable_)
+            {
+                ptr_ = other.ptr_;
+                ptr_->count_.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                create(other.get_allocator(), other.get());
+            }
+        }
+
+        // Shares the container of other if it has an equal allocator and is not unshareable
+        container_ptr(const container_ptr& other, const Allocator& alloc)
+            : ptr_(nullptr)
+        {
+            if (other.ptr_->shareable_ && alloc == other.get_allocator())
+            {
+                ptr_ = other.ptr_;
+                ptr_->count_.fetch_add(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                create(alloc, other.get(), alloc);
+            }
+        }
+
+        container_ptr(container_ptr&& other) noexcept
+            : ptr_(nullptr)
+        {
+            std::swap(other.ptr_, ptr_);
+        }
+
+        ~container_ptr() noexcept
+        {
+            if (ptr_ != nullptr && ptr_->count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                node_allocator alloc(ptr_->value_.get_allocator());
+                std::allocator_traits<node_allocator>::destroy(alloc, jsoncons::detail::to_plain_pointer(ptr_));
+                std::allocator_traits<node_allocator>::deallocate(alloc, ptr_,1);
+            }
+        }
+
+        container_ptr& operator=(const container_ptr&) = delete;
+        container_ptr& operator=(container_ptr&&) = delete;
+
+        template <typename... Args>
+        void create(const Allocator& a, Args&& ... args)
+        {
+            node_allocator alloc(a);
+            ptr_ = std::allocator_traits<node_allocator>::allocate(alloc, 1);
+            JSONCONS_TRY
+            {
+                std::allocator_traits<node_allocator>::construct(alloc, jsoncons::detail::to_plain_pointer(ptr_), std::forward<Args>(args)...);
+            }
+            JSONCONS_CATCH(...)
+            {
+                std::allocator_traits<node_allocator>::deallocate(alloc, ptr_,1);
+                ptr_ = nullptr;
+                JSONCONS_RETHROW;
+            }
+        }
+
+        allocator_type get_allocator() const
+        {
+            return ptr_->value_.get_allocator();
+        }
+
+        void swap(container_ptr& other) noexcept
+        {
+            std::swap(other.ptr_,ptr_);
+        }
+
+        std::size_t use_count() const noexcept
+        {
+            return ptr_->count_.load(std::memory_order_acquire);
+        }
+
+        const T& get() const
+        {
+            return ptr_->value_;
+        }
+
+        // Returns the container for access that may hand out references or iterators 
+        // into it, after copying it if it is shared. The container is unshareable from
+        // then on, as copy on write std::string was after a non-const operator[].
+        T& get_mutable()
+        {
+            T& value = get_unshared();
+            ptr_->shareable_ = false;
+            return value;
+        }
+
+        // Returns the container for a modification that hands out no references into it,
+        // after copying it if it is shared. The copy shares the elements of the container.
+        T& get_unshared()
+        {
+            if (use_count() > 1)
+            {
+                container_ptr temp;
+                temp.create(get_allocator(), get());
+                swap(temp);
+            }
+            return ptr_->value_;
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
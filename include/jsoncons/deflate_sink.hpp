@@ -0,0 +1,162 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DEFLATE_SINK_HPP
+#define JSONCONS_DEFLATE_SINK_HPP
+
+#include <jsoncons/config/jsoncons_config.hpp>
+
+#if defined(JSONCONS_HAS_ZLIB)
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <memory> // std::unique_ptr
+#include <stdexcept> // std::runtime_error
+#include <vector>
+#include <utility> // std::move
+#include <zlib.h>
+#include <jsoncons/sink.hpp>
+
+namespace jsoncons {
+
+    enum class deflate_format : uint8_t {gzip, zlib};
+
+namespace detail {
+
+    struct deflate_stream_deleter
+    {
+        void operator()(z_stream* strm) const noexcept
+        {
+            ::deflateEnd(strm);
+            delete strm;
+        }
+    };
+
+} // namespace detail
+
+    // deflate_sink compresses its output into gzip or zlib format and writes it to another
+    // sink a block at a time. flush() makes everything written so far decodable; the
+    // compressed stream is completed when the deflate_sink is destroyed.
+
+    template <class CharT,class Sink=binary_stream_sink>
+    class deflate_sink
+    {
+        static_assert(sizeof(CharT) == 1, "deflate_sink requires a single byte character type");
+    public:
+        using value_type = CharT;
+        static constexpr std::size_t default_buffer_length = 16384;
+    private:
+        using sink_char_type = typename Sink::value_type;
+
+        Sink sink_;
+        std::unique_ptr<z_stream,detail::deflate_stream_deleter> strm_;
+        std::vector<value_type> buffer_;
+        std::vector<sink_char_type> output_;
+        value_type* begin_buffer_;
+        const value_type* end_buffer_;
+        value_type* p_;
+
+        // Noncopyable
+        deflate_sink(const deflate_sink&) = delete;
+        deflate_sink& operator=(const deflate_sink&) = delete;
+    public:
+        explicit deflate_sink(Sink&& sink,
+                              int level = Z_DEFAULT_COMPRESSION,
+                              deflate_format format = deflate_format::gzip,
+                              std::size_t buflen = default_buffer_length)
+            : sink_(std::move(sink)),
+              buffer_(buflen > 0 ? buflen : 1),
+              output_(buflen > 0 ? buflen : 1),
+              begin_buffer_(buffer_.data()),
+              end_buffer_(begin_buffer_ + buffer_.size()),
+              p_(begin_buffer_)
+        {
+            strm_.reset(new z_stream());
+            // 15 window bits, plus 16 to write a gzip header and trailer
+            int window_bits = format == deflate_format::gzip ? 15 + 16 : 15;
+            if (::deflateInit2(strm_.get(), level, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            {
+                JSONCONS_THROW(std::runtime_error("deflateInit2 failed"));
+            }
+        }
+
+        deflate_sink(deflate_sink&&) = default;
+        deflate_sink& operator=(deflate_sink&&) = default;
+
+        ~deflate_sink() noexcept
+        {
+            if (strm_)
+            {
+                JSONCONS_TRY
+                {
+                    compress(begin_buffer_, p_ - begin_buffer_, Z_FINISH);
+                    sink_.flush();
+                }
+                JSONCONS_CATCH(...)
+                {
+                }
+            }
+        }
+
+        void flush()
+        {
+            compress(begin_buffer_, p_ - begin_buffer_, Z_SYNC_FLUSH);
+            p_ = begin_buffer_;
+            sink_.flush();
+        }
+
+        void append(const value_type* s, std::size_t length)
+        {
+            std::size_t diff = end_buffer_ - p_;
+            if (diff >= length)
+            {
+                std::memcpy(p_, s, length);
+                p_ += length;
+            }
+            else
+            {
+                compress(begin_buffer_, p_ - begin_buffer_, Z_NO_FLUSH);
+                compress(s, length, Z_NO_FLUSH);
+                p_ = begin_buffer_;
+            }
+        }
+
+        void push_back(value_type ch)
+        {
+            if (p_ == end_buffer_)
+            {
+                compress(begin_buffer_, p_ - begin_buffer_, Z_NO_FLUSH);
+                p_ = begin_buffer_;
+            }
+            *p_++ = ch;
+        }
+    private:
+        void compress(const value_type* s, std::size_t length, int mode)
+        {
+            strm_->next_in = reinterpret_cast<Bytef*>(const_cast<value_type*>(s));
+            strm_->avail_in = static_cast<uInt>(length);
+            int ret;
+            do
+            {
+                strm_->next_out = reinterpret_cast<Bytef*>(output_.data());
+                strm_->avail_out = static_cast<uInt>(output_.size());
+                ret = ::deflate(strm_.get(), mode);
+                std::size_t count = output_.size() - strm_->avail_out;
+                if (count > 0)
+                {
+                    sink_.append(output_.data(), count);
+                }
+            }
+            while (strm_->avail_out == 0 || (mode == Z_FINISH && ret == Z_OK));
+        }
+    };
+
+} // namespace jsoncons
+
+#endif // JSONCONS_HAS_ZLIB
+
+#endif
@@ -0,0 +1,297 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_BINARY_PUSH_READER_HPP
+#define JSONCONS_DETAIL_BINARY_PUSH_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <algorithm> // std::min
+#include <vector>
+#include <system_error>
+#include <utility> // std::forward
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/source.hpp>
+#include <jsoncons/ser_context.hpp>
+#include <jsoncons/json_exception.hpp>
+
+namespace jsoncons { namespace detail {
+
+    // Push model decoding for the binary formats
+    //
+    // Bytes are fed as they arrive. A format specific Scanner finds where each top level
+    // item ends, keeping its place between calls, so a partial item costs only the bytes
+    // scanned since the last call. Each complete item is then decoded by the format's own
+    // reader, reading from a push_input_source re-pointed at the item, one item for each
+    // call to read, so that a visitor such as json_decoder sees one item at a time.
+    // Complete items are decoded in place in the caller's data when nothing is held over;
+    // only the bytes of an incomplete item are copied, to be completed by later updates.
+    //
+    // A Scanner has
+    //     std::size_t scan(const uint8_t* data, std::size_t length)
+    // which is called with the bytes of an item from its start, returns the length of the
+    // item if it is complete and 0 if more bytes are needed. On bytes that are not valid
+    // in the format it returns length, so that the reader reports the error. reset()
+    // prepares it for the next item.
+
+    struct push_input
+    {
+        const uint8_t* current;
+        const uint8_t* end;
+        std::size_t position;
+
+        push_input()
+            : current(nullptr), end(nullptr), position(0)
+        {
+        }
+    };
+
+    class push_input_source
+    {
+    public:
+        using value_type = uint8_t;
+    private:
+        push_input* input_;
+
+        // Noncopyable
+        push_input_source(const push_input_source&) = delete;
+        push_input_source& operator=(const push_input_source&) = delete;
+    public:
+        explicit push_input_source(push_input* input)
+            : input_(input)
+        {
+        }
+
+        push_input_source(push_input_source&&) = default;
+        push_input_source& operator=(push_input_source&&) = default;
+
+        bool eof() const
+        {
+            return input_->current == input_->end;
+        }
+
+        bool is_error() const
+        {
+            return false;
+        }
+
+        std::size_t position() const
+        {
+            return input_->position;
+        }
+
+        character_result<value_type> get_character()
+        {
+            if (input_->current == input_->end)
+            {
+                return character_result<value_type>();
+            }
+            ++input_->position;
+            return character_result<value_type>(*input_->current++);
+        }
+
+        void ignore(std::size_t count)
+        {
+            std::size_t len = (std::min)(count, static_cast<std::size_t>(input_->end - input_->current));
+            input_->current += len;
+            input_->position += len;
+        }
+
+        character_result<value_type> peek_character()
+        {
+            if (input_->current == input_->end)
+            {
+                return character_result<value_type>();
+            }
+            return character_result<value_type>(*input_->current);
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t len = (std::min)(length, static_cast<std::size_t>(input_->end - input_->current));
+            if (len > 0)
+            {
+                std::memcpy(p, input_->current, len);
+                input_->current += len;
+                input_->position += len;
+            }
+            return len;
+        }
+    };
+
+    template <class Scanner,class Reader>
+    class binary_push_reader : public ser_context
+    {
+        push_input input_;
+        Reader reader_;
+        Scanner scanner_;
+        std::vector<uint8_t> buffer_;
+        std::size_t begin_;
+        const uint8_t* data_;
+        std::size_t length_;
+        std::size_t position_;
+
+        // Noncopyable and nonmoveable
+        binary_push_reader(const binary_push_reader&) = delete;
+        binary_push_reader& operator=(const binary_push_reader&) = delete;
+    public:
+        // args are the arguments of the format's reader that follow the source
+        template <class... Args>
+        explicit binary_push_reader(Args&&... args)
+            : reader_(push_input_source(&input_), std::forward<Args>(args)...),
+              begin_(0), data_(nullptr), length_(0), position_(0)
+        {
+        }
+
+        // Adds data to the input. The data must stay valid until read returns false.
+        void update(const uint8_t* data, std::size_t length)
+        {
+            if (length_ > 0)
+            {
+                hold_over();
+            }
+            data_ = data;
+            length_ = length;
+        }
+
+        void update(const span<const uint8_t>& data)
+        {
+            update(data.data(), data.size());
+        }
+
+        // Decodes the next item if all its bytes have arrived, and returns true,
+        // otherwise holds over the bytes of the incomplete item and returns false.
+        bool read()
+        {
+            std::error_code ec;
+            bool decoded = read(ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec,line(),column()));
+            }
+            return decoded;
+        }
+
+        bool read(std::error_code& ec)
+        {
+            if (begin_ < buffer_.size())
+            {
+                if (length_ > 0)
+                {
+                    hold_over();
+                }
+                std::size_t n = scanner_.scan(buffer_.data() + begin_, buffer_.size() - begin_);
+                if (n == 0)
+                {
+                    return false;
+                }
+                decode_item(buffer_.data() + begin_, n, ec);
+                begin_ += n;
+                if (begin_ == buffer_.size())
+                {
+                    buffer_.clear();
+                    begin_ = 0;
+                }
+            }
+            else
+            {
+                if (length_ == 0)
+                {
+                    return false;
+                }
+                std::size_t n = scanner_.scan(data_, length_);
+                if (n == 0)
+                {
+                    hold_over();
+                    return false;
+                }
+                decode_item(data_, n, ec);
+                data_ += n;
+                length_ -= n;
+            }
+            if (ec)
+            {
+                // The rest of the input cannot be trusted
+                buffer_.clear();
+                begin_ = 0;
+                data_ = nullptr;
+                length_ = 0;
+                return false;
+            }
+            return true;
+        }
+
+        // Call at the end of the input. Reports the error the reader gives for a
+        // truncated item if bytes of an incomplete item are held over.
+        void finish()
+        {
+            std::error_code ec;
+            finish(ec);
+            if (ec)
+            {
+                JSONCONS_THROW(ser_error(ec,line(),column()));
+            }
+        }
+
+        void finish(std::error_code& ec)
+        {
+            if (length_ > 0)
+            {
+                hold_over();
+            }
+            if (begin_ < buffer_.size())
+            {
+                decode_item(buffer_.data() + begin_, buffer_.size() - begin_, ec);
+            }
+            buffer_.clear();
+            begin_ = 0;
+        }
+
+        // The number of bytes received and not yet decoded
+        std::size_t buffered() const
+        {
+            return buffer_.size() - begin_ + length_;
+        }
+
+        std::size_t line() const override
+        {
+            return reader_.line();
+        }
+
+        std::size_t column() const override
+        {
+            return reader_.column();
+        }
+    private:
+        // Copies the rest of the caller's data to the buffer, after any bytes held over
+        void hold_over()
+        {
+            if (begin_ > 0)
+            {
+                buffer_.erase(buffer_.begin(), buffer_.begin() + begin_);
+                begin_ = 0;
+            }
+            buffer_.insert(buffer_.end(), data_, data_ + length_);
+            data_ = nullptr;
+            length_ = 0;
+        }
+
+        void decode_item(const uint8_t* data, std::size_t length, std::error_code& ec)
+        {
+            scanner_.reset();
+            input_.current = data;
+            input_.end = data + length;
+            input_.position = position_;
+            reader_.read(ec);
+            position_ += length;
+        }
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
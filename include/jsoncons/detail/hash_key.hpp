@@ -0,0 +1,32 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_HASH_KEY_HPP
+#define JSONCONS_DETAIL_HASH_KEY_HPP
+
+#include <cstddef> // std::size_t
+#include <cstdint> // uint64_t
+
+namespace jsoncons { 
+namespace detail {
+
+    template <class CharT>
+    std::size_t hash_key_chars(const CharT* s, std::size_t length) noexcept
+    {
+        // FNV-1a
+        uint64_t h = 14695981039346656037ull;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            h ^= static_cast<uint64_t>(s[i]);
+            h *= 1099511628211ull;
+        }
+        return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,340 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_PARALLEL_PARSE_HPP
+#define JSONCONS_DETAIL_PARALLEL_PARSE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <algorithm> // std::min, std::max
+#include <thread>
+#include <exception> // std::exception_ptr
+#include <system_error>
+#include <utility> // std::move
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/tag_type.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/detail/structural_index.hpp>
+
+namespace jsoncons { namespace detail {
+
+    // Parallel parsing of a top level array
+    //
+    // The input is cut into one chunk per thread. A first pass counts the unescaped
+    // quotation marks in each chunk, which gives every chunk its starting string state.
+    // A second pass follows the nesting depth in each chunk and notes the first comma
+    // at each depth, which gives every chunk after the first an element boundary near
+    // its start. The slices between these boundaries are parsed as arrays on their
+    // own threads and their elements moved into one array.
+    //
+    // Nothing of this is trusted: if a slice fails to parse, or the text is not a plain
+    // array, parse_array_in_parallel returns false and the caller parses the text serially,
+    // so that errors are reported exactly as without threads.
+
+    // Runs f(0) through f(n-1), each on its own thread except f(0) which runs on the
+    // calling thread. If a thread cannot be started the rest run on the calling thread.
+    template <class F>
+    void run_in_parallel(std::size_t n, F f)
+    {
+        std::vector<std::exception_ptr> errors(n);
+        auto task = [&f,&errors](std::size_t i)
+        {
+            JSONCONS_TRY
+            {
+                f(i);
+            }
+            JSONCONS_CATCH(...)
+            {
+                errors[i] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        std::size_t started = 1;
+        JSONCONS_TRY
+        {
+            threads.reserve(n);
+            for (; started < n; ++started)
+            {
+                threads.emplace_back(task, started);
+            }
+        }
+        JSONCONS_CATCH(const std::system_error&)
+        {
+        }
+        task(0);
+        for (std::size_t i = started; i < n; ++i)
+        {
+            task(i);
+        }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+        for (auto& e : errors)
+        {
+            if (e)
+            {
+                std::rethrow_exception(e);
+            }
+        }
+    }
+
+    struct array_chunk
+    {
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        std::size_t begin;
+        std::size_t end;
+        bool odd_quotes;
+        bool in_string;
+        bool has_slash;
+        std::ptrdiff_t depth_change;
+        // first_comma[d] is the offset of the first comma at depth -d relative to begin, or npos
+        std::vector<std::size_t> first_comma;
+
+        array_chunk()
+            : begin(0), end(0), odd_quotes(false), in_string(false), has_slash(false), depth_change(0)
+        {
+        }
+    };
+
+    // Calls f(block, offset) for the 64 byte blocks of [begin,end), the last block padded with blanks
+    template <class F>
+    void for_each_block(const char* data, std::size_t begin, std::size_t end, F f)
+    {
+        structural_block block;
+        std::size_t offset = begin;
+        for (; offset + 64 <= end; offset += 64)
+        {
+            classify_block(data + offset, block);
+            f(block, offset);
+        }
+        if (offset < end)
+        {
+            char last[64];
+            std::memset(last, ' ', sizeof(last));
+            std::memcpy(last, data + offset, end - offset);
+            classify_block_scalar(last, block);
+            f(block, offset);
+        }
+    }
+
+    inline void count_chunk_quotes(const char* data, array_chunk& chunk)
+    {
+        structural_indexer indexer;
+        for_each_block(data, chunk.begin, chunk.end,
+                       [&](const structural_block& block, std::size_t) {indexer.next(block);});
+        chunk.odd_quotes = indexer.in_string();
+    }
+
+    inline void scan_chunk_depth(const char* data, array_chunk& chunk)
+    {
+        structural_indexer indexer(chunk.in_string);
+        std::ptrdiff_t depth = 0;
+        for_each_block(data, chunk.begin, chunk.end,
+                       [&](const structural_block& block, std::size_t offset)
+        {
+            uint64_t ops = indexer.next(block) & block.op;
+            while (ops != 0)
+            {
+                std::size_t pos = offset + count_trailing_zeros64(ops);
+                switch (data[pos])
+                {
+                    case '[':
+                    case '{':
+                        ++depth;
+                        break;
+                    case ']':
+                    case '}':
+                        --depth;
+                        break;
+                    case ',':
+                        if (depth <= 0)
+                        {
+                            std::size_t d = static_cast<std::size_t>(-depth);
+                            if (d >= chunk.first_comma.size())
+                            {
+                                chunk.first_comma.resize(d + 1, std::size_t(array_chunk::npos));
+                            }
+                            if (chunk.first_comma[d] == array_chunk::npos)
+                            {
+                                chunk.first_comma[d] = pos;
+                            }
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                ops &= ops - 1;
+            }
+        });
+        chunk.depth_change = depth;
+        chunk.has_slash = indexer.has_slash();
+    }
+
+    // Parses [begin,end) as the elements of an array, the first slice includes the opening
+    // bracket and the last slice the closing bracket.
+    template <class Json>
+    bool parse_array_slice(const char* data, std::size_t begin, std::size_t end,
+                           bool first, bool last,
+                           const basic_json_decode_options<char>& options,
+                           Json& part)
+    {
+        static const char open_bracket[] = "[";
+        static const char close_bracket[] = "]";
+
+        basic_json_parser<char> parser(options, strict_json_parsing());
+        json_decoder<Json> decoder;
+        std::error_code ec;
+
+        if (!first)
+        {
+            parser.update(open_bracket, 1);
+            parser.parse_some(decoder, ec);
+            if (ec) return false;
+        }
+        parser.update(data + begin, end - begin);
+        if (!last)
+        {
+            parser.parse_some(decoder, ec);
+            if (ec) return false;
+            parser.update(close_bracket, 1);
+        }
+        parser.finish_parse(decoder, ec);
+        if (ec) return false;
+        parser.check_done(ec);
+        if (ec || !decoder.is_valid()) return false;
+
+        part = decoder.get_result();
+        return true;
+    }
+
+    template <class CharT,class Json>
+    bool parse_array_in_parallel(const CharT*, std::size_t, std::size_t, const basic_json_decode_options<CharT>&, Json&)
+    {
+        return false;
+    }
+
+    template <class Json>
+    bool parse_array_in_parallel(const char* data, std::size_t length,
+                                 std::size_t num_threads,
+                                 const basic_json_decode_options<char>& options,
+                                 Json& result)
+    {
+        // Below this many characters per thread, starting the threads costs more than it saves
+        const std::size_t min_chunk_length = 64*1024;
+
+        if (num_threads == 0)
+        {
+            num_threads = std::thread::hardware_concurrency();
+        }
+        std::size_t num_chunks = (std::min)(num_threads, length / min_chunk_length);
+        if (num_chunks < 2)
+        {
+            return false;
+        }
+
+        std::size_t start = 0;
+        while (start < length && (data[start] == ' ' || data[start] == '\t' || data[start] == '\n' || data[start] == '\r'))
+        {
+            ++start;
+        }
+        if (start == length || data[start] != '[')
+        {
+            return false;
+        }
+
+        // A chunk never starts right after a backslash, so its first character is not escaped
+        std::vector<array_chunk> chunks(num_chunks);
+        for (std::size_t i = 1; i < num_chunks; ++i)
+        {
+            std::size_t begin = (std::max)(chunks[i-1].begin, length / num_chunks * i);
+            while (begin < length && data[begin-1] == '\\')
+            {
+                ++begin;
+            }
+            chunks[i].begin = begin;
+            chunks[i-1].end = begin;
+        }
+        chunks[num_chunks-1].end = length;
+
+        run_in_parallel(num_chunks, [&](std::size_t i) {count_chunk_quotes(data, chunks[i]);});
+        for (std::size_t i = 1; i < num_chunks; ++i)
+        {
+            chunks[i].in_string = chunks[i-1].in_string != chunks[i-1].odd_quotes;
+        }
+
+        run_in_parallel(num_chunks, [&](std::size_t i) {scan_chunk_depth(data, chunks[i]);});
+
+        // Offsets of the commas that separate the slices
+        std::vector<std::size_t> splits;
+        std::ptrdiff_t depth = 0;
+        for (std::size_t i = 0; i < num_chunks; ++i)
+        {
+            const array_chunk& chunk = chunks[i];
+            if (chunk.has_slash)
+            {
+                return false; // comments are left to the serial parser
+            }
+            if (i > 0 && depth >= 1)
+            {
+                std::size_t d = static_cast<std::size_t>(depth - 1);
+                if (d < chunk.first_comma.size() && chunk.first_comma[d] != array_chunk::npos)
+                {
+                    splits.push_back(chunk.first_comma[d]);
+                }
+            }
+            depth += chunk.depth_change;
+        }
+        if (splits.empty())
+        {
+            return false;
+        }
+
+        const std::size_t num_slices = splits.size() + 1;
+        std::vector<Json> parts(num_slices);
+        std::vector<char> parsed(num_slices, 0);
+        run_in_parallel(num_slices, [&](std::size_t i)
+        {
+            std::size_t begin = i == 0 ? 0 : splits[i-1] + 1;
+            std::size_t end = i + 1 == num_slices ? length : splits[i];
+            parsed[i] = parse_array_slice(data, begin, end, i == 0, i + 1 == num_slices, options, parts[i]);
+        });
+
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < num_slices; ++i)
+        {
+            // An empty slice is the trace of a missing element, e.g. "[," or ",,"
+            if (!parsed[i] || !parts[i].is_array() || parts[i].empty())
+            {
+                return false;
+            }
+            size += parts[i].size();
+        }
+
+        Json array(json_array_arg);
+        array.reserve(size);
+        for (auto& part : parts)
+        {
+            for (auto& item : part.array_range())
+            {
+                array.push_back(std::move(item));
+            }
+            part = Json();
+        }
+        result = std::move(array);
+        return true;
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -16,6 +16,7 @@
 #include <type_traits> // std::enable_if
 #include <exception>
 #include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/eisel_lemire.hpp>
 #include <cctype>
 
 namespace jsoncons { namespace detail {
@@ -760,26 +761,26 @@ base16_to_integer(const CharT* s, std::size_t length)
 
 #if defined(JSONCONS_HAS_MSC__STRTOD_L)
 
-class to_double_t
+class strtod_t
 {
 private:
     _locale_t locale_;
 public:
-    to_double_t()
+    strtod_t()
     {
         locale_ = _create_locale(LC_NUMERIC, "C");
     }
-    ~to_double_t() noexcept
+    ~strtod_t() noexcept
     {
         _free_locale(locale_);
     }
 
-    to_double_t(const to_double_t&)
+    strtod_t(const strtod_t&)
     {
         locale_ = _create_locale(LC_NUMERIC, "C");
     }
 
-    to_double_t& operator=(const to_double_t&) 
+    strtod_t& operator=(const strtod_t&) 
     {
         // Don't assign locale
         return *this;
@@ -819,26 +820,26 @@ public:
 
 #elif defined(JSONCONS_HAS_STRTOLD_L)
 
-class to_double_t
+class strtod_t
 {
 private:
     locale_t locale_;
 public:
-    to_double_t()
+    strtod_t()
     {
         locale_ = newlocale(LC_ALL_MASK, "C", (locale_t) 0);
     }
-    ~to_double_t() noexcept
+    ~strtod_t() noexcept
     {
         freelocale(locale_);
     }
 
-    to_double_t(const to_double_t&)
+    strtod_t(const strtod_t&)
     {
         locale_ = newlocale(LC_ALL_MASK, "C", (locale_t) 0);
     }
 
-    to_double_t& operator=(const to_double_t&) 
+    strtod_t& operator=(const strtod_t&) 
     {
         return *this;
     }
@@ -876,14 +877,12 @@ public:
 };
 
 #else
-class to_double_t
+class strtod_t
 {
 private:
-    std::vector<char> buffer_;
     char decimal_point_;
 public:
-    to_double_t()
-        : buffer_()
+    strtod_t()
     {
         struct lconv * lc = localeconv();
         if (lc != nullptr && lc->decimal_point[0] != 0)
@@ -894,11 +893,10 @@ public:
         {
             decimal_point_ = '.'; 
         }
-        buffer_.reserve(100);
     }
 
-    to_double_t(const to_double_t&) = default;
-    to_double_t& operator=(const to_double_t&) = default;
+    strtod_t(const strtod_t&) = default;
+    strtod_t& operator=(const strtod_t&) = default;
 
     char get_decimal_point() const
     {
@@ -933,6 +931,42 @@ public:
 };
 #endif
 
+// to_double_t converts the text of a number to a double. Decimal numbers are converted with
+// the Eisel-Lemire algorithm, anything else, and the rare decimal numbers that it cannot round 
+// with certainty, with strtod. The text need not be null terminated, and its decimal point 
+// may be '.' or the decimal point of the current locale.
+
+class to_double_t
+{
+private:
+    strtod_t strtod_;
+public:
+    char get_decimal_point() const
+    {
+        return strtod_.get_decimal_point();
+    }
+
+    template <class CharT>
+    double operator()(const CharT* s, std::size_t length) const
+    {
+        double val = 0;
+        if (decimal_to_double(s, length, strtod_.get_decimal_point(), val))
+        {
+            return val;
+        }
+
+        std::basic_string<CharT> buffer(s, length);
+        for (auto& c : buffer)
+        {
+            if (c == '.')
+            {
+                c = strtod_.get_decimal_point();
+            }
+        }
+        return strtod_(buffer.c_str(), buffer.length());
+    }
+};
+
 }}
 
 #endif
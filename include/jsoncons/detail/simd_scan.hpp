@@ -0,0 +1,269 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_SIMD_SCAN_HPP
+#define JSONCONS_DETAIL_SIMD_SCAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <jsoncons/config/jsoncons_config.hpp>
+
+#if defined(JSONCONS_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace jsoncons { namespace detail {
+
+    // Index of the lowest set bit, mask must be non zero
+    inline int count_trailing_zeros(uint32_t mask)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctz(mask);
+    #elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<int>(index);
+    #else
+        int n = 0;
+        while ((mask & 1) == 0)
+        {
+            mask >>= 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+
+    inline bool cpu_has_avx2()
+    {
+        static const bool has_avx2 = __builtin_cpu_supports("avx2") != 0;
+        return has_avx2;
+    }
+
+    __attribute__((target("avx2")))
+    inline const char* skip_blanks_avx2(const char* first, const char* last)
+    {
+        const __m256i spaces = _mm256_set1_epi8(' ');
+        const __m256i tabs = _mm256_set1_epi8('\t');
+        while (last - first >= 32)
+        {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            __m256i blanks = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, spaces),
+                                             _mm256_cmpeq_epi8(chunk, tabs));
+            uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(blanks));
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 32;
+        }
+        return first;
+    }
+
+    __attribute__((target("avx2")))
+    inline const char* find_string_special_avx2(const char* first, const char* last)
+    {
+        const __m256i quotes = _mm256_set1_epi8('\"');
+        const __m256i backslashes = _mm256_set1_epi8('\\');
+        const __m256i max_control = _mm256_set1_epi8(0x1f);
+        while (last - first >= 32)
+        {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quotes),
+                                              _mm256_cmpeq_epi8(chunk, backslashes));
+            // unsigned chunk <= 0x1f 
+            special = _mm256_or_si256(special, _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, max_control), max_control));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 32;
+        }
+        return first;
+    }
+
+    __attribute__((target("avx2")))
+    inline const char* skip_ascii_avx2(const char* first, const char* last)
+    {
+        while (last - first >= 32)
+        {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(chunk));
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 32;
+        }
+        return first;
+    }
+
+#endif // defined(JSONCONS_HAS_AVX2_DISPATCH)
+
+    // skip_blanks returns a pointer to the first character in [first,last) that is
+    // neither a space nor a tab, or last if there is none.
+
+    template <class CharT>
+    const CharT* skip_blanks(const CharT* first, const CharT* last)
+    {
+        while (first != last && (*first == ' ' || *first == '\t'))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    inline const char* skip_blanks(const char* first, const char* last)
+    {
+    #if defined(JSONCONS_HAS_SSE2)
+        const __m128i spaces = _mm_set1_epi8(' ');
+        const __m128i tabs = _mm_set1_epi8('\t');
+
+        // Most runs of indentation fit into a single 16 byte block
+        if (last - first >= 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            __m128i blanks = _mm_or_si128(_mm_cmpeq_epi8(chunk, spaces), _mm_cmpeq_epi8(chunk, tabs));
+            uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(blanks)) & 0xffff;
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 16;
+        #if defined(JSONCONS_HAS_AVX2_DISPATCH)
+            if (last - first >= 32 && cpu_has_avx2())
+            {
+                first = skip_blanks_avx2(first, last);
+            }
+        #endif
+        }
+        while (last - first >= 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            __m128i blanks = _mm_or_si128(_mm_cmpeq_epi8(chunk, spaces), _mm_cmpeq_epi8(chunk, tabs));
+            uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(blanks)) & 0xffff;
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 16;
+        }
+    #endif
+        while (first != last && (*first == ' ' || *first == '\t'))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    // find_string_special returns a pointer to the first quotation mark, reverse solidus 
+    // or control character in [first,last), or last if there is none.
+
+    template <class CharT>
+    const CharT* find_string_special(const CharT* first, const CharT* last)
+    {
+        while (first != last && *first != '\"' && *first != '\\' && static_cast<uint32_t>(*first) > 0x1f)
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    inline const char* find_string_special(const char* first, const char* last)
+    {
+    #if defined(JSONCONS_HAS_SSE2)
+        #if defined(JSONCONS_HAS_AVX2_DISPATCH)
+        if (last - first >= 64 && cpu_has_avx2())
+        {
+            first = find_string_special_avx2(first, last);
+            if (last - first >= 32)
+            {
+                return first;
+            }
+        }
+        #endif
+        const __m128i quotes = _mm_set1_epi8('\"');
+        const __m128i backslashes = _mm_set1_epi8('\\');
+        const __m128i max_control = _mm_set1_epi8(0x1f);
+        while (last - first >= 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, quotes), _mm_cmpeq_epi8(chunk, backslashes));
+            special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_max_epu8(chunk, max_control), max_control));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 16;
+        }
+    #endif
+        while (first != last)
+        {
+            unsigned char c = static_cast<unsigned char>(*first);
+            if (c == '\"' || c == '\\' || c <= 0x1f)
+            {
+                break;
+            }
+            ++first;
+        }
+        return first;
+    }
+
+    // skip_ascii returns a pointer to the first code unit in [first,last) that is
+    // not a 7-bit ascii character. Only meaningful for UTF-8, other character types 
+    // return first.
+
+    template <class CharT>
+    const CharT* skip_ascii(const CharT* first, const CharT*)
+    {
+        return first;
+    }
+
+    inline const char* skip_ascii(const char* first, const char* last)
+    {
+    #if defined(JSONCONS_HAS_SSE2)
+        #if defined(JSONCONS_HAS_AVX2_DISPATCH)
+        if (last - first >= 64 && cpu_has_avx2())
+        {
+            first = skip_ascii_avx2(first, last);
+            if (last - first >= 32)
+            {
+                return first;
+            }
+        }
+        #endif
+        while (last - first >= 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(chunk));
+            if (mask != 0)
+            {
+                return first + count_trailing_zeros(mask);
+            }
+            first += 16;
+        }
+    #endif
+        while (first != last && static_cast<unsigned char>(*first) < 0x80)
+        {
+            ++first;
+        }
+        return first;
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,351 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_DETAIL_STRUCTURAL_INDEX_HPP
+#define JSONCONS_DETAIL_STRUCTURAL_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
+
+#if defined(JSONCONS_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace jsoncons { namespace detail {
+
+    // Character classes of one 64 byte block of input, one bit per byte
+
+    struct structural_block
+    {
+        uint64_t quote;
+        uint64_t backslash;
+        uint64_t op;          // { } [ ] : ,
+        uint64_t blank;       // space and tab
+        uint64_t newline;     // line feed and carriage return
+        uint64_t slash;
+    };
+
+    inline int count_trailing_zeros64(uint64_t mask)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(mask);
+    #elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, mask);
+        return static_cast<int>(index);
+    #else
+        int n = 0;
+        while ((mask & 1) == 0)
+        {
+            mask >>= 1;
+            ++n;
+        }
+        return n;
+    #endif
+    }
+
+    // Bit i of the result is the xor of bits 0 through i of mask
+    inline uint64_t prefix_xor(uint64_t mask)
+    {
+        mask ^= mask << 1;
+        mask ^= mask << 2;
+        mask ^= mask << 4;
+        mask ^= mask << 8;
+        mask ^= mask << 16;
+        mask ^= mask << 32;
+        return mask;
+    }
+
+    inline void classify_block_scalar(const char* data, structural_block& block)
+    {
+        block = structural_block();
+        for (int i = 0; i < 64; ++i)
+        {
+            uint64_t bit = uint64_t(1) << i;
+            switch (data[i])
+            {
+                case '\"':
+                    block.quote |= bit;
+                    break;
+                case '\\':
+                    block.backslash |= bit;
+                    break;
+                case '{': case '}': case '[': case ']': case ':': case ',':
+                    block.op |= bit;
+                    break;
+                case ' ': case '\t':
+                    block.blank |= bit;
+                    break;
+                case '\n': case '\r':
+                    block.newline |= bit;
+                    break;
+                case '/':
+                    block.slash |= bit;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+#if defined(JSONCONS_HAS_SSE2)
+
+    inline void classify_block_sse2(const char* data, structural_block& block)
+    {
+        const __m128i quotes = _mm_set1_epi8('\"');
+        const __m128i backslashes = _mm_set1_epi8('\\');
+        const __m128i lower_bit = _mm_set1_epi8(0x20);
+        const __m128i left_braces = _mm_set1_epi8('{');   // '[' | 0x20 == '{'
+        const __m128i right_braces = _mm_set1_epi8('}');  // ']' | 0x20 == '}'
+        const __m128i colons = _mm_set1_epi8(':');
+        const __m128i commas = _mm_set1_epi8(',');
+        const __m128i spaces = _mm_set1_epi8(' ');
+        const __m128i tabs = _mm_set1_epi8('\t');
+        const __m128i line_feeds = _mm_set1_epi8('\n');
+        const __m128i carriage_returns = _mm_set1_epi8('\r');
+        const __m128i slashes = _mm_set1_epi8('/');
+
+        block = structural_block();
+        for (int i = 0; i < 4; ++i)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16*i));
+            __m128i folded = _mm_or_si128(chunk, lower_bit);
+            __m128i op = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, left_braces), _mm_cmpeq_epi8(folded, right_braces)),
+                                      _mm_or_si128(_mm_cmpeq_epi8(chunk, colons), _mm_cmpeq_epi8(chunk, commas)));
+            __m128i blank = _mm_or_si128(_mm_cmpeq_epi8(chunk, spaces), _mm_cmpeq_epi8(chunk, tabs));
+            __m128i newline = _mm_or_si128(_mm_cmpeq_epi8(chunk, line_feeds), _mm_cmpeq_epi8(chunk, carriage_returns));
+
+            int shift = 16*i;
+            block.quote |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quotes)))) << shift;
+            block.backslash |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslashes)))) << shift;
+            block.op |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(op))) << shift;
+            block.blank |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(blank))) << shift;
+            block.newline |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(newline))) << shift;
+            block.slash |= uint64_t(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, slashes)))) << shift;
+        }
+    }
+
+#endif // defined(JSONCONS_HAS_SSE2)
+
+#if defined(JSONCONS_HAS_AVX2_DISPATCH)
+
+    __attribute__((target("avx2")))
+    inline void classify_block_avx2(const char* data, structural_block& block)
+    {
+        const __m256i quotes = _mm256_set1_epi8('\"');
+        const __m256i backslashes = _mm256_set1_epi8('\\');
+        const __m256i lower_bit = _mm256_set1_epi8(0x20);
+        const __m256i left_braces = _mm256_set1_epi8('{');
+        const __m256i right_braces = _mm256_set1_epi8('}');
+        const __m256i colons = _mm256_set1_epi8(':');
+        const __m256i commas = _mm256_set1_epi8(',');
+        const __m256i spaces = _mm256_set1_epi8(' ');
+        const __m256i tabs = _mm256_set1_epi8('\t');
+        const __m256i line_feeds = _mm256_set1_epi8('\n');
+        const __m256i carriage_returns = _mm256_set1_epi8('\r');
+        const __m256i slashes = _mm256_set1_epi8('/');
+
+        block = structural_block();
+        for (int i = 0; i < 2; ++i)
+        {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32*i));
+            __m256i folded = _mm256_or_si256(chunk, lower_bit);
+            __m256i op = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(folded, left_braces), _mm256_cmpeq_epi8(folded, right_braces)),
+                                         _mm256_or_si256(_mm256_cmpeq_epi8(chunk, colons), _mm256_cmpeq_epi8(chunk, commas)));
+            __m256i blank = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, spaces), _mm256_cmpeq_epi8(chunk, tabs));
+            __m256i newline = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, line_feeds), _mm256_cmpeq_epi8(chunk, carriage_returns));
+
+            int shift = 32*i;
+            block.quote |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, quotes)))) << shift;
+            block.backslash |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, backslashes)))) << shift;
+            block.op |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(op))) << shift;
+            block.blank |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(blank))) << shift;
+            block.newline |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(newline))) << shift;
+            block.slash |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, slashes)))) << shift;
+        }
+    }
+
+#endif // defined(JSONCONS_HAS_AVX2_DISPATCH)
+
+    inline void classify_block(const char* data, structural_block& block)
+    {
+    #if defined(JSONCONS_HAS_AVX2_DISPATCH)
+        if (cpu_has_avx2())
+        {
+            classify_block_avx2(data, block);
+            return;
+        }
+    #endif
+    #if defined(JSONCONS_HAS_SSE2)
+        classify_block_sse2(data, block);
+    #else
+        classify_block_scalar(data, block);
+    #endif
+    }
+
+    // structural_indexer turns the character classes of consecutive blocks into the
+    // offsets of the tokens of a JSON text. Quotation marks preceded by an odd number
+    // of reverse solidi are escaped, and the characters from an opening quotation mark
+    // up to its closing quotation mark are inside a string. Outside strings it reports
+    //
+    //  - the structural characters { } [ ] : ,
+    //  - opening quotation marks
+    //  - the first character of every other token, e.g. a number or literal
+    //  - line feeds and carriage returns, so that line numbers can be kept
+    //
+    // Characters that directly follow a number or literal without separating
+    // whitespace are not reported, they can only be part of a malformed token.
+
+    class structural_indexer
+    {
+        static constexpr uint64_t odd_bits = 0xAAAAAAAAAAAAAAAAULL;
+
+        uint64_t prev_escaped_;
+        uint64_t prev_in_string_;
+        uint64_t prev_boundary_;
+        uint64_t slash_;
+    public:
+        structural_indexer()
+            : prev_escaped_(0), prev_in_string_(0), prev_boundary_(1), slash_(0)
+        {
+        }
+
+        // Starts inside a string if in_string is true, for scanning from the middle of a text
+        explicit structural_indexer(bool in_string)
+            : prev_escaped_(0), prev_in_string_(in_string ? ~uint64_t(0) : 0), prev_boundary_(1), slash_(0)
+        {
+        }
+
+        // Returns the tokens of the block as a mask
+        uint64_t next(const structural_block& block)
+        {
+            uint64_t escaped = next_escaped(block.backslash);
+            uint64_t quote = block.quote & ~escaped;
+
+            // Bits of the opening quotation mark and the contents of strings
+            uint64_t in_string = prefix_xor(quote) ^ prev_in_string_;
+            prev_in_string_ = uint64_t(0) - (in_string >> 63);
+
+            uint64_t outside = ~in_string;
+            uint64_t whitespace = block.blank | block.newline;
+            uint64_t closing_quote = quote & outside;
+
+            // A token starts at a character that is not whitespace and that follows
+            // whitespace, a structural character or a closing quotation mark
+            uint64_t boundary = whitespace | block.op | closing_quote;
+            uint64_t follows_boundary = (boundary << 1) | prev_boundary_;
+            prev_boundary_ = boundary >> 63;
+            uint64_t scalar = ~(whitespace | block.op | quote) & outside;
+
+            slash_ |= block.slash & outside;
+
+            return ((block.op | block.newline) & outside) | (quote & in_string) | (scalar & follows_boundary);
+        }
+
+        // True if the input ended inside a string
+        bool in_string() const
+        {
+            return prev_in_string_ != 0;
+        }
+
+        // True if there was a solidus outside a string, the start of a comment
+        bool has_slash() const
+        {
+            return slash_ != 0;
+        }
+
+    private:
+        uint64_t next_escaped(uint64_t backslash)
+        {
+            if (backslash == 0)
+            {
+                uint64_t escaped = prev_escaped_;
+                prev_escaped_ = 0;
+                return escaped;
+            }
+            // Backslashes that start a run on an even bit escape the characters at odd
+            // offsets from the start of the run, subtraction propagates the run start
+            uint64_t potential_escape = backslash & ~prev_escaped_;
+            uint64_t maybe_escaped = potential_escape << 1;
+            uint64_t even_series_codes_and_odd_bits = (maybe_escaped | odd_bits) - potential_escape;
+            uint64_t escape_and_terminal_code = even_series_codes_and_odd_bits ^ odd_bits;
+            uint64_t escaped = escape_and_terminal_code ^ (backslash | prev_escaped_);
+            uint64_t escape = escape_and_terminal_code & backslash;
+            prev_escaped_ = escape >> 63;
+            return escaped;
+        }
+    };
+
+    // build_structural_index stores the offsets of the tokens of [data,data+length) in index,
+    // in increasing order. It returns false, leaving the index unspecified, if the input is
+    // too large for 32 bit offsets, ends inside a string, or has comments.
+
+    template <class Allocator>
+    bool build_structural_index(const char* data, std::size_t length, std::vector<uint32_t,Allocator>& index)
+    {
+        index.clear();
+        if (length > (std::numeric_limits<uint32_t>::max)())
+        {
+            return false;
+        }
+        // Pretty printed text has roughly one token for every four characters, the index
+        // grows in steps so that a block can write all its tokens without checks
+        index.resize(length/4 + 64);
+
+        structural_indexer indexer;
+        structural_block block;
+        std::size_t offset = 0;
+        std::size_t count = 0;
+
+        for (; offset + 64 <= length; offset += 64)
+        {
+            classify_block(data + offset, block);
+            uint64_t tokens = indexer.next(block);
+            if (index.size() - count < 64)
+            {
+                index.resize(index.size()*2);
+            }
+            uint32_t* p = index.data() + count;
+            while (tokens != 0)
+            {
+                *p++ = static_cast<uint32_t>(offset + count_trailing_zeros64(tokens));
+                tokens &= tokens - 1;
+            }
+            count = static_cast<std::size_t>(p - index.data());
+        }
+        index.resize(count);
+        if (offset < length)
+        {
+            // Pad the last block with blanks
+            char last[64];
+            std::memset(last, ' ', sizeof(last));
+            std::memcpy(last, data + offset, length - offset);
+            classify_block_scalar(last, block);
+            uint64_t tokens = indexer.next(block);
+            while (tokens != 0)
+            {
+                index.push_back(static_cast<uint32_t>(offset + count_trailing_zeros64(tokens)));
+                tokens &= tokens - 1;
+            }
+        }
+        return !indexer.in_string() && !indexer.has_slash();
+    }
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
@@ -302,7 +302,7 @@ namespace detail {
         {
             return false;
         }
-        if (to_double_(buffer, sizeof(buffer)) != val)
+        if (to_double_(buffer, static_cast<std::size_t>(length)) != val)
         {
             const int precision2 = std::numeric_limits<double>::max_digits10;
             length = snprintf(buffer, sizeof(buffer), "%1.*e", precision2, val);
@@ -335,7 +335,7 @@ namespace detail {
         {
             return false;
         }
-        if (to_double_(buffer, sizeof(buffer)) != val)
+        if (to_double_(buffer, static_cast<std::size_t>(length)) != val)
         {
             const int precision2 = std::numeric_limits<double>::max_digits10;
             length = snprintf(buffer, sizeof(buffer), "%1.*g", precision2, val);
@@ -402,7 +402,7 @@ namespace detail {
         {
             return false;
         }
-        if (to_double_(buffer, sizeof(buffer)) != val)
+        if (to_double_(buffer, static_cast<std::size_t>(length)) != val)
         {
             const int precision2 = std::numeric_limits<double>::max_digits10;
             length = snprintf(buffer, sizeof(buffer), "%1.*f", precision2, val);
@@ -0,0 +1,168 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_FD_SINK_HPP
+#define JSONCONS_FD_SINK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <climits> // INT_MAX
+#include <cstring> // std::memcpy
+#include <algorithm> // std::min
+#include <system_error>
+#include <utility> // std::swap
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace jsoncons {
+
+namespace detail {
+
+    // Writes all length bytes to fd, retrying if interrupted by a signal
+    // and continuing after partial writes. Returns false with ec set on failure.
+    inline bool fd_write(int fd, const void* p, std::size_t length, std::error_code& ec)
+    {
+        const char* data = static_cast<const char*>(p);
+        while (length > 0)
+        {
+#if defined(_WIN32)
+            int n = ::_write(fd, data, static_cast<unsigned int>((std::min)(length, static_cast<std::size_t>(INT_MAX))));
+#else
+            ssize_t n = ::write(fd, data, length);
+#endif
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                ec = std::error_code(errno, std::system_category());
+                return false;
+            }
+            data += n;
+            length -= static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+} // namespace detail
+
+    // fd_sink writes to a file descriptor, such as a pipe or socket, with write(2),
+    // bypassing iostreams. The descriptor is not owned and is not closed. After a
+    // write error further output is discarded, and error() says why.
+
+    template <class CharT>
+    class fd_sink
+    {
+    public:
+        using value_type = CharT;
+        static constexpr std::size_t default_buffer_length = 16384;
+    private:
+        int fd_;
+        std::vector<value_type> buffer_;
+        value_type* begin_buffer_;
+        const value_type* end_buffer_;
+        value_type* p_;
+        std::error_code ec_;
+
+        // Noncopyable
+        fd_sink(const fd_sink&) = delete;
+        fd_sink& operator=(const fd_sink&) = delete;
+    public:
+        explicit fd_sink(int fd, std::size_t buflen = default_buffer_length)
+            : fd_(fd), buffer_(buflen > 0 ? buflen : 1), begin_buffer_(buffer_.data()),
+              end_buffer_(begin_buffer_+buffer_.size()), p_(begin_buffer_)
+        {
+        }
+
+        fd_sink(fd_sink&& other) noexcept
+            : fd_(-1), begin_buffer_(nullptr), end_buffer_(nullptr), p_(nullptr)
+        {
+            swap(other);
+        }
+
+        ~fd_sink() noexcept
+        {
+            write_buffer();
+        }
+
+        fd_sink& operator=(fd_sink&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        std::error_code error() const
+        {
+            return ec_;
+        }
+
+        void flush()
+        {
+            write_buffer();
+        }
+
+        void append(const value_type* s, std::size_t length)
+        {
+            std::size_t diff = end_buffer_ - p_;
+            if (diff >= length)
+            {
+                std::memcpy(p_, s, length*sizeof(value_type));
+                p_ += length;
+            }
+            else
+            {
+                write_buffer();
+                write(s, length);
+            }
+        }
+
+        void push_back(value_type ch)
+        {
+            if (p_ == end_buffer_)
+            {
+                write_buffer();
+            }
+            *p_++ = ch;
+        }
+
+        void swap(fd_sink& other) noexcept
+        {
+            std::swap(fd_, other.fd_);
+            buffer_.swap(other.buffer_);
+            std::swap(begin_buffer_, other.begin_buffer_);
+            std::swap(end_buffer_, other.end_buffer_);
+            std::swap(p_, other.p_);
+            std::swap(ec_, other.ec_);
+        }
+    private:
+        void write_buffer()
+        {
+            write(begin_buffer_, p_ - begin_buffer_);
+            p_ = begin_buffer_;
+        }
+
+        void write(const value_type* s, std::size_t length)
+        {
+            if (length > 0 && !ec_)
+            {
+                detail::fd_write(fd_, s, length*sizeof(value_type), ec_);
+            }
+        }
+    };
+
+    using binary_fd_sink = fd_sink<uint8_t>;
+
+} // namespace jsoncons
+
+#endif
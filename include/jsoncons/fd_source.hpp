@@ -0,0 +1,227 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_FD_SOURCE_HPP
+#define JSONCONS_FD_SOURCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <climits> // INT_MAX
+#include <cstring> // std::memcpy
+#include <algorithm> // std::min
+#include <system_error>
+#include <utility> // std::swap
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/source.hpp>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace jsoncons {
+
+namespace detail {
+
+    // Reads up to length bytes from fd, retrying if interrupted by a signal.
+    // Returns the number of bytes read, 0 at end of file, or -1 with ec set.
+    inline std::ptrdiff_t fd_read(int fd, void* p, std::size_t length, std::error_code& ec)
+    {
+        for (;;)
+        {
+#if defined(_WIN32)
+            int n = ::_read(fd, p, static_cast<unsigned int>((std::min)(length, static_cast<std::size_t>(INT_MAX))));
+#else
+            ssize_t n = ::read(fd, p, length);
+#endif
+            if (n >= 0)
+            {
+                return static_cast<std::ptrdiff_t>(n);
+            }
+            if (errno != EINTR)
+            {
+                ec = std::error_code(errno, std::system_category());
+                return -1;
+            }
+        }
+    }
+
+} // namespace detail
+
+    // fd_source reads from a file descriptor, such as a pipe or socket, with read(2),
+    // bypassing iostreams. The descriptor is not owned and is not closed. A read error
+    // ends the input, after which is_error() returns true and error() says why.
+
+    template <class CharT>
+    class fd_source
+    {
+    public:
+        using value_type = CharT;
+        static constexpr std::size_t default_max_buffer_length = 16384;
+    private:
+        int fd_;
+        std::vector<value_type> buffer_;
+        const value_type* current_;
+        const value_type* end_;
+        std::size_t position_;
+        bool eof_;
+        std::error_code ec_;
+
+        // Noncopyable
+        fd_source(const fd_source&) = delete;
+        fd_source& operator=(const fd_source&) = delete;
+    public:
+        fd_source()
+            : fd_(-1), current_(nullptr), end_(nullptr), position_(0), eof_(true)
+        {
+        }
+
+        explicit fd_source(int fd, std::size_t buffer_length = default_max_buffer_length)
+            : fd_(fd), buffer_(buffer_length > 0 ? buffer_length : 1),
+              current_(buffer_.data()), end_(buffer_.data()), position_(0), eof_(false)
+        {
+        }
+
+        fd_source(fd_source&& other) noexcept
+            : fd_(-1), current_(nullptr), end_(nullptr), position_(0), eof_(true)
+        {
+            swap(other);
+        }
+
+        fd_source& operator=(fd_source&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        bool eof() const
+        {
+            return current_ == end_ && eof_;
+        }
+
+        bool is_error() const
+        {
+            return static_cast<bool>(ec_);
+        }
+
+        std::error_code error() const
+        {
+            return ec_;
+        }
+
+        std::size_t position() const
+        {
+            return position_;
+        }
+
+        character_result<value_type> get_character()
+        {
+            if (current_ == end_ && !fill_buffer())
+            {
+                return character_result<value_type>();
+            }
+            ++position_;
+            return character_result<value_type>(*current_++);
+        }
+
+        void ignore(std::size_t count)
+        {
+            while (count > 0)
+            {
+                if (current_ == end_ && !fill_buffer())
+                {
+                    return;
+                }
+                std::size_t len = (std::min)(count, static_cast<std::size_t>(end_ - current_));
+                current_ += len;
+                position_ += len;
+                count -= len;
+            }
+        }
+
+        character_result<value_type> peek_character()
+        {
+            if (current_ == end_ && !fill_buffer())
+            {
+                return character_result<value_type>();
+            }
+            return character_result<value_type>(*current_);
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t count = 0;
+            while (count < length && (current_ != end_ || fill_buffer()))
+            {
+                std::size_t len = (std::min)(length - count, static_cast<std::size_t>(end_ - current_));
+                std::memcpy(p + count, current_, len*sizeof(value_type));
+                current_ += len;
+                count += len;
+            }
+            position_ += count;
+            return count;
+        }
+
+        // Hands out the buffered block in place, so readers need not copy it again
+        span<const value_type> read_buffer()
+        {
+            if (current_ == end_ && !fill_buffer())
+            {
+                return span<const value_type>();
+            }
+            span<const value_type> s(current_, end_ - current_);
+            position_ += s.size();
+            current_ = end_;
+            return s;
+        }
+
+        void swap(fd_source& other) noexcept
+        {
+            std::swap(fd_, other.fd_);
+            buffer_.swap(other.buffer_);
+            std::swap(current_, other.current_);
+            std::swap(end_, other.end_);
+            std::swap(position_, other.position_);
+            std::swap(eof_, other.eof_);
+            std::swap(ec_, other.ec_);
+        }
+    private:
+        bool fill_buffer()
+        {
+            if (eof_)
+            {
+                return false;
+            }
+            char* data = reinterpret_cast<char*>(buffer_.data());
+            const std::size_t capacity = buffer_.size()*sizeof(value_type);
+            std::size_t length = 0;
+            // A wide character may arrive split across reads
+            do
+            {
+                std::ptrdiff_t n = detail::fd_read(fd_, data + length, capacity - length, ec_);
+                if (n <= 0)
+                {
+                    eof_ = true;
+                    break;
+                }
+                length += static_cast<std::size_t>(n);
+            }
+            while (length % sizeof(value_type) != 0);
+
+            current_ = buffer_.data();
+            end_ = buffer_.data() + length/sizeof(value_type);
+            return current_ != end_;
+        }
+    };
+
+    using binary_fd_source = fd_source<uint8_t>;
+
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,239 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_INFLATE_SOURCE_HPP
+#define JSONCONS_INFLATE_SOURCE_HPP
+
+#include <jsoncons/config/jsoncons_config.hpp>
+
+#if defined(JSONCONS_HAS_ZLIB)
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <algorithm> // std::min
+#include <memory> // std::unique_ptr
+#include <vector>
+#include <utility> // std::move
+#include <zlib.h>
+#include <jsoncons/source.hpp>
+
+namespace jsoncons {
+
+namespace detail {
+
+    struct inflate_stream_deleter
+    {
+        void operator()(z_stream* strm) const noexcept
+        {
+            ::inflateEnd(strm);
+            delete strm;
+        }
+    };
+
+} // namespace detail
+
+    // inflate_source decompresses gzip or zlib data read from another source, a block at
+    // a time, so that memory use does not depend on the size of the input. Concatenated
+    // gzip members are read as one stream. Corrupt or truncated input sets is_error().
+
+    template <class CharT,class Source=binary_stream_source>
+    class inflate_source
+    {
+        static_assert(sizeof(CharT) == 1, "inflate_source requires a single byte character type");
+        static_assert(sizeof(typename Source::value_type) == 1, "inflate_source requires a byte source");
+    public:
+        using value_type = CharT;
+        static constexpr std::size_t default_max_buffer_length = 16384;
+    private:
+        using source_char_type = typename Source::value_type;
+
+        Source source_;
+        std::unique_ptr<z_stream,detail::inflate_stream_deleter> strm_;
+        std::vector<source_char_type> input_;
+        std::vector<value_type> buffer_;
+        const value_type* current_;
+        const value_type* end_;
+        std::size_t position_;
+        bool input_done_;
+        bool output_pending_;
+        bool done_;
+        bool is_error_;
+
+        // Noncopyable
+        inflate_source(const inflate_source&) = delete;
+        inflate_source& operator=(const inflate_source&) = delete;
+    public:
+        inflate_source()
+            : inflate_source(Source())
+        {
+        }
+
+        explicit inflate_source(Source&& source, std::size_t buffer_length = default_max_buffer_length)
+            : source_(std::move(source)),
+              input_(buffer_length > 0 ? buffer_length : 1),
+              buffer_(buffer_length > 0 ? buffer_length : 1),
+              current_(buffer_.data()), end_(buffer_.data()), position_(0),
+              input_done_(false), output_pending_(false), done_(false), is_error_(false)
+        {
+            strm_.reset(new z_stream());
+            // 15 window bits, plus 32 to accept both zlib and gzip headers
+            if (::inflateInit2(strm_.get(), 15 + 32) != Z_OK)
+            {
+                strm_.reset();
+                done_ = true;
+                is_error_ = true;
+            }
+        }
+
+        inflate_source(inflate_source&&) = default;
+        inflate_source& operator=(inflate_source&&) = default;
+
+        bool eof() const
+        {
+            return current_ == end_ && done_;
+        }
+
+        bool is_error() const
+        {
+            return is_error_ || source_.is_error();
+        }
+
+        std::size_t position() const
+        {
+            return position_;
+        }
+
+        character_result<value_type> get_character()
+        {
+            if (current_ == end_ && !fill_buffer())
+            {
+                return character_result<value_type>();
+            }
+            ++position_;
+            return character_result<value_type>(*current_++);
+        }
+
+        void ignore(std::size_t count)
+        {
+            while (count > 0)
+            {
+                if (current_ == end_ && !fill_buffer())
+                {
+                    return;
+                }
+                std::size_t len = (std::min)(count, static_cast<std::size_t>(end_ - current_));
+                current_ += len;
+                position_ += len;
+                count -= len;
+            }
+        }
+
+        character_result<value_type> peek_character()
+        {
+            if (current_ == end_ && !fill_buffer())
+            {
+                return character_result<value_type>();
+            }
+            return character_result<value_type>(*current_);
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t count = 0;
+            while (count < length && (current_ != end_ || fill_buffer()))
+            {
+                std::size_t len = (std::min)(length - count, static_cast<std::size_t>(end_ - current_));
+                std::memcpy(p + count, current_, len);
+                current_ += len;
+                count += len;
+            }
+            position_ += count;
+            return count;
+        }
+
+        // Hands out the block just decompressed in place
+        span<const value_type> read_buffer()
+        {
+            if (current_ == end_ && !fill_buffer())
+            {
+                return span<const value_type>();
+            }
+            span<const value_type> s(current_, end_ - current_);
+            position_ += s.size();
+            current_ = end_;
+            return s;
+        }
+    private:
+        // Returns true when more input was read from the source
+        bool read_input()
+        {
+            if (input_done_)
+            {
+                return false;
+            }
+            std::size_t count = source_.read(input_.data(), input_.size());
+            if (count == 0)
+            {
+                input_done_ = true;
+                return false;
+            }
+            strm_->next_in = reinterpret_cast<Bytef*>(input_.data());
+            strm_->avail_in = static_cast<uInt>(count);
+            return true;
+        }
+
+        // Decompresses until at least one character is available or the input ends
+        bool fill_buffer()
+        {
+            current_ = end_ = buffer_.data();
+            while (!done_)
+            {
+                if (strm_->avail_in == 0 && !output_pending_ && !read_input())
+                {
+                    // The source ended in the middle of a compressed stream
+                    is_error_ = true;
+                    done_ = true;
+                    break;
+                }
+                strm_->next_out = reinterpret_cast<Bytef*>(buffer_.data());
+                strm_->avail_out = static_cast<uInt>(buffer_.size());
+                int ret = ::inflate(strm_.get(), Z_NO_FLUSH);
+                end_ = buffer_.data() + (buffer_.size() - strm_->avail_out);
+                // A full buffer may leave output that needs no more input
+                output_pending_ = strm_->avail_out == 0;
+
+                if (ret == Z_STREAM_END)
+                {
+                    // Another gzip member may follow
+                    if (strm_->avail_in > 0 || read_input())
+                    {
+                        ::inflateReset(strm_.get());
+                    }
+                    else
+                    {
+                        done_ = true;
+                    }
+                }
+                else if (ret != Z_OK && ret != Z_BUF_ERROR)
+                {
+                    is_error_ = true;
+                    done_ = true;
+                }
+                if (current_ != end_)
+                {
+                    return true;
+                }
+            }
+            return current_ != end_;
+        }
+    };
+
+} // namespace jsoncons
+
+#endif // JSONCONS_HAS_ZLIB
+
+#endif
@@ -0,0 +1,575 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_INTERNED_KEY_HPP
+#define JSONCONS_INTERNED_KEY_HPP
+
+#include <string>
+#include <ostream>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <cstring> // std::memcpy
+#include <cstdint> // uint64_t
+#include <memory> // std::allocator
+#include <utility> // std::swap
+#include <algorithm> // std::min
+#include <iterator> // std::distance
+#include <type_traits> // std::aligned_storage
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/more_type_traits.hpp>
+#include <jsoncons/detail/string_wrapper.hpp> // jsoncons::detail::launder_cast
+#include <jsoncons/detail/hash_key.hpp> // jsoncons::detail::hash_key_chars
+
+namespace jsoncons {
+
+    // basic_interned_key is an immutable string that shares its characters with every
+    // equal key. With a stateless allocator, keys are interned in a process wide pool, so a
+    // document with a million records holds each distinct field name once, and equal keys
+    // compare by pointer. The characters are freed with the last key that refers to them.
+    // With a stateful allocator, copies share the characters, but keys made from characters
+    // are not interned.
+
+    template <class CharT,class CharTraits=std::char_traits<CharT>,class Allocator=std::allocator<CharT>>
+    class basic_interned_key;
+
+namespace detail {
+
+    template <class CharT,class CharTraits,class Allocator>
+    struct interned_key_node
+    {
+        using byte_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<char>;
+
+        std::atomic<std::size_t> count;
+        std::size_t hash;
+        std::size_t length;
+        bool pooled;
+        byte_allocator_type alloc;
+
+        interned_key_node(std::size_t hash, std::size_t length, bool pooled, const Allocator& alloc)
+            : count(1), hash(hash), length(length), pooled(pooled), alloc(alloc)
+        {
+        }
+
+        const CharT* data() const;
+
+        bool equals(const CharT* s, std::size_t n) const
+        {
+            return length == n && CharTraits::compare(data(), s, n) == 0;
+        }
+    };
+
+    template <class CharT,class CharTraits,class Allocator>
+    struct interned_key_storage
+    {
+        interned_key_node<CharT,CharTraits,Allocator> node;
+        CharT c[1];
+    };
+
+    template <class CharT,class CharTraits,class Allocator>
+    const CharT* interned_key_node<CharT,CharTraits,Allocator>::data() const
+    {
+        return launder_cast<const interned_key_storage<CharT,CharTraits,Allocator>*>(this)->c;
+    }
+
+    // Allocates and frees the nodes of basic_interned_key, and keeps the pool of
+    // interned nodes. A node's count is only taken to zero with the pool locked, so
+    // a lookup cannot revive a node that is being freed.
+
+    template <class CharT,class CharTraits,class Allocator>
+    class interned_key_pool
+    {
+    public:
+        using node_type = interned_key_node<CharT,CharTraits,Allocator>;
+    private:
+        using storage_type = interned_key_storage<CharT,CharTraits,Allocator>;
+        using byte_allocator_type = typename node_type::byte_allocator_type;
+        using byte_pointer = typename std::allocator_traits<byte_allocator_type>::pointer;
+
+        std::mutex mutex_;
+        std::unordered_multimap<std::size_t,node_type*> nodes_;
+
+        interned_key_pool() = default;
+    public:
+        interned_key_pool(const interned_key_pool&) = delete;
+        interned_key_pool& operator=(const interned_key_pool&) = delete;
+
+        // Never destroyed, so that keys in objects with static storage duration
+        // may outlive it
+        static interned_key_pool& instance()
+        {
+            static interned_key_pool* pool = new interned_key_pool();
+            return *pool;
+        }
+
+        node_type* intern(const CharT* s, std::size_t length, const Allocator& alloc)
+        {
+            std::size_t hash = hash_key_chars(s, length);
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto range = nodes_.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second->equals(s, length))
+                {
+                    it->second->count.fetch_add(1, std::memory_order_relaxed);
+                    return it->second;
+                }
+            }
+            node_type* node = create(s, length, hash, true, alloc);
+            nodes_.emplace(hash, node);
+            return node;
+        }
+
+        void release(node_type* node) noexcept
+        {
+            if (node->pooled)
+            {
+                std::size_t count = node->count.load(std::memory_order_relaxed);
+                while (count > 1)
+                {
+                    if (node->count.compare_exchange_weak(count, count-1, std::memory_order_release, std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+                }
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (node->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    auto range = nodes_.equal_range(node->hash);
+                    for (auto it = range.first; it != range.second; ++it)
+                    {
+                        if (it->second == node)
+                        {
+                            nodes_.erase(it);
+                            break;
+                        }
+                    }
+                    destroy(node);
+                }
+            }
+            else if (node->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                destroy(node);
+            }
+        }
+
+        static node_type* create(const CharT* s, std::size_t length, std::size_t hash, bool pooled, const Allocator& alloc)
+        {
+            byte_allocator_type byte_alloc(alloc);
+            byte_pointer ptr = byte_alloc.allocate(storage_size(length));
+            char* storage = to_plain_pointer(ptr);
+            node_type* node = ::new(storage)node_type(hash, length, pooled, alloc);
+            auto psa = launder_cast<storage_type*>(storage);
+            CharT* p = ::new(&psa->c)CharT[length + 1];
+            std::memcpy(p, s, length*sizeof(CharT));
+            p[length] = 0;
+            return node;
+        }
+
+        static void destroy(node_type* node) noexcept
+        {
+            byte_allocator_type byte_alloc(node->alloc);
+            std::size_t size = storage_size(node->length);
+            node->~node_type();
+            byte_alloc.deallocate(std::pointer_traits<byte_pointer>::pointer_to(*launder_cast<char*>(node)), size);
+        }
+    private:
+        static std::size_t storage_size(std::size_t length)
+        {
+            return sizeof(typename std::aligned_storage<sizeof(storage_type), alignof(storage_type)>::type) + length*sizeof(CharT);
+        }
+    };
+
+} // namespace detail
+
+    template <class CharT,class CharTraits,class Allocator>
+    class basic_interned_key
+    {
+    public:
+        using value_type = CharT;
+        using traits_type = CharTraits;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using const_iterator = const CharT*;
+        using iterator = const CharT*;
+        using string_view_type = jsoncons::basic_string_view<CharT,CharTraits>;
+        static constexpr size_type npos = size_type(-1);
+    private:
+        using pool_type = detail::interned_key_pool<CharT,CharTraits,Allocator>;
+        using node_type = typename pool_type::node_type;
+
+        node_type* node_;
+        allocator_type alloc_;
+    public:
+        basic_interned_key() noexcept
+            : node_(nullptr)
+        {
+        }
+
+        explicit basic_interned_key(const allocator_type& alloc) noexcept
+            : node_(nullptr), alloc_(alloc)
+        {
+        }
+
+        basic_interned_key(const CharT* s, size_type length, const allocator_type& alloc = allocator_type())
+            : node_(nullptr), alloc_(alloc)
+        {
+            assign(s, length);
+        }
+
+        basic_interned_key(const CharT* s, const allocator_type& alloc = allocator_type())
+            : node_(nullptr), alloc_(alloc)
+        {
+            assign(s, CharTraits::length(s));
+        }
+
+        basic_interned_key(const CharT* first, const CharT* last, const allocator_type& alloc = allocator_type())
+            : node_(nullptr), alloc_(alloc)
+        {
+            assign(first, last - first);
+        }
+
+        template <class InputIt>
+        basic_interned_key(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+            : node_(nullptr), alloc_(alloc)
+        {
+            std::basic_string<CharT,CharTraits,Allocator> s(first, last, alloc);
+            assign(s.data(), s.size());
+        }
+
+        template <class Alloc>
+        basic_interned_key(const std::basic_string<CharT,CharTraits,Alloc>& s, const allocator_type& alloc = allocator_type())
+            : node_(nullptr), alloc_(alloc)
+        {
+            assign(s.data(), s.size());
+        }
+
+        explicit basic_interned_key(const string_view_type& s, const allocator_type& alloc = allocator_type())
+            : node_(nullptr), alloc_(alloc)
+        {
+            assign(s.data(), s.size());
+        }
+
+        basic_interned_key(const basic_interned_key& other) noexcept
+            : node_(other.node_), alloc_(other.alloc_)
+        {
+            add_ref();
+        }
+
+        basic_interned_key(const basic_interned_key& other, const allocator_type& alloc)
+            : node_(nullptr), alloc_(alloc)
+        {
+            if (alloc == other.alloc_)
+            {
+                node_ = other.node_;
+                add_ref();
+            }
+            else
+            {
+                assign(other.data(), other.size());
+            }
+        }
+
+        basic_interned_key(basic_interned_key&& other) noexcept
+            : node_(other.node_), alloc_(other.alloc_)
+        {
+            other.node_ = nullptr;
+        }
+
+        basic_interned_key(basic_interned_key&& other, const allocator_type& alloc)
+            : node_(nullptr), alloc_(alloc)
+        {
+            if (alloc == other.alloc_)
+            {
+                std::swap(node_, other.node_);
+            }
+            else
+            {
+                assign(other.data(), other.size());
+            }
+        }
+
+        ~basic_interned_key() noexcept
+        {
+            release();
+        }
+
+        basic_interned_key& operator=(const basic_interned_key& other) noexcept
+        {
+            if (node_ != other.node_)
+            {
+                release();
+                node_ = other.node_;
+                add_ref();
+            }
+            return *this;
+        }
+
+        basic_interned_key& operator=(basic_interned_key&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        void swap(basic_interned_key& other) noexcept
+        {
+            std::swap(node_, other.node_);
+            std::swap(alloc_, other.alloc_);
+        }
+
+        allocator_type get_allocator() const
+        {
+            return alloc_;
+        }
+
+        const CharT* data() const noexcept
+        {
+            return node_ != nullptr ? node_->data() : empty_chars();
+        }
+
+        const CharT* c_str() const noexcept
+        {
+            return data();
+        }
+
+        size_type size() const noexcept
+        {
+            return node_ != nullptr ? node_->length : 0;
+        }
+
+        size_type length() const noexcept
+        {
+            return size();
+        }
+
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return data();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return data() + size();
+        }
+
+        const CharT& operator[](size_type pos) const
+        {
+            return data()[pos];
+        }
+
+        // The characters are shared and immutable
+        void shrink_to_fit() noexcept
+        {
+        }
+
+        operator string_view_type() const noexcept
+        {
+            return string_view_type(data(), size());
+        }
+
+        template <class Alloc>
+        explicit operator std::basic_string<CharT,CharTraits,Alloc>() const
+        {
+            return std::basic_string<CharT,CharTraits,Alloc>(data(),size());
+        }
+
+        int compare(const basic_interned_key& other) const noexcept
+        {
+            return node_ == other.node_ ? 0 : compare(other.data(), other.size());
+        }
+
+        int compare(const string_view_type& s) const noexcept
+        {
+            return compare(s.data(), s.size());
+        }
+
+        int compare(const CharT* s) const noexcept
+        {
+            return compare(s, CharTraits::length(s));
+        }
+
+        template <class Alloc>
+        int compare(const std::basic_string<CharT,CharTraits,Alloc>& s) const noexcept
+        {
+            return compare(s.data(), s.size());
+        }
+
+        friend bool operator==(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            // Interned keys are equal if and only if they share characters
+            if (lhs.node_ == rhs.node_)
+            {
+                return true;
+            }
+            if (lhs.node_ != nullptr && rhs.node_ != nullptr && lhs.node_->pooled && rhs.node_->pooled)
+            {
+                return false;
+            }
+            return lhs.compare(rhs) == 0;
+        }
+        friend bool operator!=(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+        friend bool operator<(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) < 0;
+        }
+        friend bool operator<=(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) <= 0;
+        }
+        friend bool operator>(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) > 0;
+        }
+        friend bool operator>=(const basic_interned_key& lhs, const basic_interned_key& rhs) noexcept
+        {
+            return lhs.compare(rhs) >= 0;
+        }
+
+        // Comparisons with strings, string views and null terminated strings
+        template <class T>
+        friend auto operator==(const basic_interned_key& lhs, const T& rhs) noexcept
+            -> decltype(string_view_type(rhs), bool())
+        {
+            return lhs.compare(string_view_type(rhs)) == 0;
+        }
+        template <class T>
+        friend auto operator==(const T& lhs, const basic_interned_key& rhs) noexcept
+            -> decltype(string_view_type(lhs), bool())
+        {
+            return rhs.compare(string_view_type(lhs)) == 0;
+        }
+        template <class T>
+        friend auto operator!=(const basic_interned_key& lhs, const T& rhs) noexcept
+            -> decltype(string_view_type(rhs), bool())
+        {
+            return lhs.compare(string_view_type(rhs)) != 0;
+        }
+        template <class T>
+        friend auto operator!=(const T& lhs, const basic_interned_key& rhs) noexcept
+            -> decltype(string_view_type(lhs), bool())
+        {
+            return rhs.compare(string_view_type(lhs)) != 0;
+        }
+        template <class T>
+        friend auto operator<(const basic_interned_key& lhs, const T& rhs) noexcept
+            -> decltype(string_view_type(rhs), bool())
+        {
+            return lhs.compare(string_view_type(rhs)) < 0;
+        }
+        template <class T>
+        friend auto operator<(const T& lhs, const basic_interned_key& rhs) noexcept
+            -> decltype(string_view_type(lhs), bool())
+        {
+            return rhs.compare(string_view_type(lhs)) > 0;
+        }
+        template <class T>
+        friend auto operator<=(const basic_interned_key& lhs, const T& rhs) noexcept
+            -> decltype(string_view_type(rhs), bool())
+        {
+            return lhs.compare(string_view_type(rhs)) <= 0;
+        }
+        template <class T>
+        friend auto operator<=(const T& lhs, const basic_interned_key& rhs) noexcept
+            -> decltype(string_view_type(lhs), bool())
+        {
+            return rhs.compare(string_view_type(lhs)) >= 0;
+        }
+        template <class T>
+        friend auto operator>(const basic_interned_key& lhs, const T& rhs) noexcept
+            -> decltype(string_view_type(rhs), bool())
+        {
+            return lhs.compare(string_view_type(rhs)) > 0;
+        }
+        template <class T>
+        friend auto operator>(const T& lhs, const basic_interned_key& rhs) noexcept
+            -> decltype(string_view_type(lhs), bool())
+        {
+            return rhs.compare(string_view_type(lhs)) < 0;
+        }
+        template <class T>
+        friend auto operator>=(const basic_interned_key& lhs, const T& rhs) noexcept
+            -> decltype(string_view_type(rhs), bool())
+        {
+            return lhs.compare(string_view_type(rhs)) >= 0;
+        }
+        template <class T>
+        friend auto operator>=(const T& lhs, const basic_interned_key& rhs) noexcept
+            -> decltype(string_view_type(lhs), bool())
+        {
+            return rhs.compare(string_view_type(lhs)) <= 0;
+        }
+
+        friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const basic_interned_key& key)
+        {
+            os.write(key.data(), key.size());
+            return os;
+        }
+    private:
+        static const CharT* empty_chars() noexcept
+        {
+            static const CharT c = 0;
+            return &c;
+        }
+
+        int compare(const CharT* s, size_type length) const noexcept
+        {
+            const size_type len = (std::min)(size(), length);
+            int result = CharTraits::compare(data(), s, len);
+            if (result != 0)
+            {
+                return result;
+            }
+            return size() == length ? 0 : (size() < length ? -1 : 1);
+        }
+
+        void assign(const CharT* s, size_type length)
+        {
+            if (length == 0)
+            {
+                return;
+            }
+            if (jsoncons::detail::is_stateless<Allocator>::value)
+            {
+                node_ = pool_type::instance().intern(s, length, alloc_);
+            }
+            else
+            {
+                node_ = pool_type::create(s, length, detail::hash_key_chars(s, length), false, alloc_);
+            }
+        }
+
+        void add_ref() noexcept
+        {
+            if (node_ != nullptr)
+            {
+                node_->count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void release() noexcept
+        {
+            if (node_ != nullptr)
+            {
+                pool_type::instance().release(node_);
+                node_ = nullptr;
+            }
+        }
+    };
+
+    using interned_key = basic_interned_key<char>;
+    using winterned_key = basic_interned_key<wchar_t>;
+
+} // namespace jsoncons
+
+#endif
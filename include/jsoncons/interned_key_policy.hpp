@@ -0,0 +1,25 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_INTERNED_KEY_POLICY_HPP
+#define JSONCONS_INTERNED_KEY_POLICY_HPP
+
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/interned_key.hpp>
+
+namespace jsoncons {
+
+// Sorts keys like sorted_policy, and stores them as basic_interned_key, so that
+// equal keys share one copy of their characters
+struct interned_key_policy : public sorted_policy
+{
+    template <class CharT, class CharTraits, class Allocator>
+    using key_storage = basic_interned_key<CharT, CharTraits, Allocator>;
+};
+
+} // namespace jsoncons
+
+#endif
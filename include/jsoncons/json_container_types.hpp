@@ -11,6 +11,8 @@
 #include <vector>
 #include <exception>
 #include <cstring>
+#include <cstdint> // uint64_t
+#include <limits> // std::numeric_limits
 #include <algorithm> // std::sort, std::stable_sort, std::lower_bound, std::unique
 #include <utility>
 #include <initializer_list>
@@ -19,23 +21,355 @@
 #include <utility> // std::move
 #include <cassert> // assert
 #include <type_traits> // std::enable_if
+#include <atomic> // std::atomic
 #include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_type.hpp>
+#include <jsoncons/tag_type.hpp>
 #include <jsoncons/allocator_holder.hpp>
+#include <jsoncons/object_shape.hpp>
 
 namespace jsoncons {
 
+    struct generic_array_layout
+    {
+        explicit generic_array_layout() = default;
+    };
+
+    struct packed_array_layout
+    {
+        explicit packed_array_layout() = default;
+    };
+
+namespace detail {
+
+    enum class packed_kind : uint8_t {none, float32_value, float64_value, int64_value, uint64_value};
+
+    template <class T>
+    struct packed_kind_of {};
+
+    template <>
+    struct packed_kind_of<float> : std::integral_constant<packed_kind, packed_kind::float32_value> {};
+
+    template <>
+    struct packed_kind_of<double> : std::integral_constant<packed_kind, packed_kind::float64_value> {};
+
+    template <>
+    struct packed_kind_of<int64_t> : std::integral_constant<packed_kind, packed_kind::int64_value> {};
+
+    template <>
+    struct packed_kind_of<uint64_t> : std::integral_constant<packed_kind, packed_kind::uint64_value> {};
+
+    // The numbers of a json_array with a generic layout, of which there are never any
+
+    template <class Allocator,class Layout>
+    class packed_numbers
+    {
+    public:
+        packed_numbers() = default;
+
+        explicit packed_numbers(const Allocator&) noexcept
+        {
+        }
+
+        packed_numbers(const packed_numbers&, const Allocator&) noexcept
+        {
+        }
+
+        packed_numbers(packed_numbers&&, const Allocator&) noexcept
+        {
+        }
+
+        packed_kind kind() const noexcept {return packed_kind::none;}
+
+        std::size_t size() const noexcept {return 0;}
+
+        std::size_t capacity() const noexcept {return 0;}
+
+        template <class T>
+        jsoncons::span<const T> data() const noexcept {return jsoncons::span<const T>();}
+
+        void clear() noexcept {}
+
+        void shrink_to_fit() noexcept {}
+
+        void swap(packed_numbers&) noexcept {}
+    };
+
+    // The numbers of a json_array with a packed layout. They are stored contiguously as
+    // float, double, int64_t or uint64_t in a buffer of 64 bit words, so that the
+    // buffer is suitably aligned for all of them.
+
+    template <class Allocator>
+    class packed_numbers<Allocator,packed_array_layout>
+    {
+        using word_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<uint64_t>;
+
+        std::vector<uint64_t,word_allocator_type> words_;
+        std::size_t size_;
+        packed_kind kind_;
+    public:
+        packed_numbers()
+            : size_(0), kind_(packed_kind::none)
+        {
+        }
+
+        explicit packed_numbers(const Allocator& alloc)
+            : words_(word_allocator_type(alloc)), size_(0), kind_(packed_kind::none)
+        {
+        }
+
+        packed_numbers(const packed_numbers& other)
+            : words_(other.words_), size_(other.size_), kind_(other.kind_)
+        {
+        }
+
+        packed_numbers(const packed_numbers& other, const Allocator& alloc)
+            : words_(other.words_, word_allocator_type(alloc)), size_(other.size_), kind_(other.kind_)
+        {
+        }
+
+        packed_numbers(packed_numbers&& other) noexcept
+            : words_(std::move(other.words_)), size_(other.size_), kind_(other.kind_)
+        {
+            other.size_ = 0;
+            other.kind_ = packed_kind::none;
+        }
+
+        packed_numbers(packed_numbers&& other, const Allocator& alloc)
+            : words_(std::move(other.words_), word_allocator_type(alloc)), size_(other.size_), kind_(other.kind_)
+        {
+            other.size_ = 0;
+            other.kind_ = packed_kind::none;
+        }
+
+        packed_kind kind() const noexcept {return kind_;}
+
+        std::size_t size() const noexcept {return size_;}
+
+        std::size_t capacity() const noexcept
+        {
+            return kind_ == packed_kind::float32_value ? 2*words_.capacity() : words_.capacity();
+        }
+
+        template <class T>
+        jsoncons::span<const T> data() const noexcept
+        {
+            return jsoncons::span<const T>(reinterpret_cast<const T*>(words_.data()), size_);
+        }
+
+        template <class T>
+        void push_back(T value)
+        {
+            JSONCONS_ASSERT(kind_ == packed_kind::none || kind_ == packed_kind_of<T>::value);
+            kind_ = packed_kind_of<T>::value;
+            words_.resize(words_needed<T>(size_+1));
+            std::memcpy(reinterpret_cast<unsigned char*>(words_.data()) + size_*sizeof(T), &value, sizeof(T));
+            ++size_;
+        }
+
+        template <class T>
+        void assign(const T* data, std::size_t length)
+        {
+            words_.resize(words_needed<T>(length));
+            if (length > 0)
+            {
+                std::memcpy(words_.data(), data, length*sizeof(T));
+            }
+            size_ = length;
+            kind_ = length > 0 ? packed_kind_of<T>::value : packed_kind::none;
+        }
+
+        void reserve(std::size_t n)
+        {
+            words_.reserve(kind_ == packed_kind::float32_value ? (n+1)/2 : n);
+        }
+
+        void clear() noexcept
+        {
+            words_.clear();
+            size_ = 0;
+            kind_ = packed_kind::none;
+        }
+
+        void shrink_to_fit()
+        {
+            words_.shrink_to_fit();
+        }
+
+        // Frees the buffer, after the numbers have been moved to generic elements
+        void release() noexcept
+        {
+            clear();
+            std::vector<uint64_t,word_allocator_type>(words_.get_allocator()).swap(words_);
+        }
+
+        void swap(packed_numbers& other) noexcept
+        {
+            words_.swap(other.words_);
+            std::swap(size_, other.size_);
+            std::swap(kind_, other.kind_);
+        }
+    private:
+        packed_numbers& operator=(const packed_numbers&) = delete;
+
+        template <class T>
+        static std::size_t words_needed(std::size_t n) noexcept
+        {
+            return (n*sizeof(T) + sizeof(uint64_t) - 1)/sizeof(uint64_t);
+        }
+    };
+
+    // The view of the elements of a json_array with a generic layout, of which there is never any
+
+    template <class Container,class Layout>
+    class packed_elements_view
+    {
+    public:
+        void reset() noexcept {}
+
+        void swap(packed_elements_view&) noexcept {}
+    };
+
+    // A copy of the numbers of a packed json_array as generic elements, for const access 
+    // that returns references. It is built on first use, and installed with a compare and 
+    // swap, so that const access from several threads does not race. It is dropped when the
+    // numbers change, and handed over to the array when the array is unpacked, which keeps
+    // iterators into it valid. It is held alongside the packed numbers, so while it exists
+    // the array takes more memory than generic elements alone would.
+
+    template <class Container>
+    class packed_elements_view<Container,packed_array_layout>
+    {
+        using container_allocator_type = typename std::allocator_traits<typename Container::allocator_type>:: template rebind_alloc<Container>;
+        using container_allocator_traits = std::allocator_traits<container_allocator_type>;
+
+        mutable std::atomic<Container*> ptr_;
+    public:
+        packed_elements_view() noexcept
+            : ptr_(nullptr)
+        {
+        }
+
+        // A copy builds its own view when it needs one
+        packed_elements_view(const packed_elements_view&) noexcept
+            : ptr_(nullptr)
+        {
+        }
+
+        packed_elements_view(packed_elements_view&& other) noexcept
+            : ptr_(other.ptr_.exchange(nullptr))
+        {
+        }
+
+        ~packed_elements_view() noexcept
+        {
+            reset();
+        }
+
+        // Returns the view, calling make(Container&) to fill it if there is none yet
+        template <class F>
+        const Container& get(const typename Container::allocator_type& alloc, F make) const
+        {
+            Container* p = ptr_.load(std::memory_order_acquire);
+            if (p == nullptr)
+            {
+                Container* q = create(alloc);
+                JSONCONS_TRY
+                {
+                    make(*q);
+                }
+                JSONCONS_CATCH(...)
+                {
+                    destroy(q);
+                    JSONCONS_RETHROW;
+                }
+                if (ptr_.compare_exchange_strong(p, q, std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    p = q;
+                }
+                else
+                {
+                    destroy(q); // another thread installed its view first
+                }
+            }
+            return *p;
+        }
+
+        // Swaps the view into elements, returns false if there is none
+        bool take(Container& elements) noexcept
+        {
+            Container* p = ptr_.exchange(nullptr);
+            if (p == nullptr)
+            {
+                return false;
+            }
+            elements.swap(*p);
+            destroy(p);
+            return true;
+        }
+
+        void reset() noexcept
+        {
+            Container* p = ptr_.exchange(nullptr);
+            if (p != nullptr)
+            {
+                destroy(p);
+            }
+        }
+
+        void swap(packed_elements_view& other) noexcept
+        {
+            Container* p = ptr_.exchange(nullptr);
+            ptr_.store(other.ptr_.exchange(p));
+        }
+    private:
+        packed_elements_view& operator=(const packed_elements_view&) = delete;
+
+        static Container* create(const typename Container::allocator_type& alloc)
+        {
+            container_allocator_type a(alloc);
+            Container* p = container_allocator_traits::allocate(a, 1);
+            JSONCONS_TRY
+            {
+                container_allocator_traits::construct(a, p, alloc);
+            }
+            JSONCONS_CATCH(...)
+            {
+                container_allocator_traits::deallocate(a, p, 1);
+                JSONCONS_RETHROW;
+            }
+            return p;
+        }
+
+        static void destroy(Container* p) noexcept
+        {
+            container_allocator_type a(p->get_allocator());
+            container_allocator_traits::destroy(a, p);
+            container_allocator_traits::deallocate(a, p, 1);
+        }
+    };
+
+} // namespace detail
+
     // json_array
 
     template <class Json>
-    class json_array : public allocator_holder<typename Json::allocator_type>
+    class json_array : public allocator_holder<typename Json::allocator_type>,
+                       private detail::packed_numbers<typename Json::allocator_type,typename Json::implementation_policy::array_layout>,
+                       private detail::packed_elements_view<typename Json::implementation_policy::template sequence_container_type<Json,
+                                                                typename std::allocator_traits<typename Json::allocator_type>:: template rebind_alloc<Json>>,
+                                                            typename Json::implementation_policy::array_layout>
     {
     public:
         using allocator_type = typename Json::allocator_type;
         using value_type = Json;
     private:
         using implementation_policy = typename Json::implementation_policy;
+        using array_layout = typename implementation_policy::array_layout;
+        using packed_numbers_type = detail::packed_numbers<allocator_type,array_layout>;
         using value_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<value_type>;                   
         using value_container_type = typename implementation_policy::template sequence_container_type<value_type,value_allocator_type>;
+        using elements_view_type = detail::packed_elements_view<value_container_type,array_layout>;
         value_container_type elements_;
     public:
         using iterator = typename value_container_type::iterator;
@@ -51,6 +385,7 @@ namespace jsoncons {
 
         explicit json_array(const allocator_type& alloc)
             : allocator_holder<allocator_type>(alloc), 
+              packed_numbers_type(alloc),
               elements_(value_allocator_type(alloc))
         {
         }
@@ -58,6 +393,7 @@ namespace jsoncons {
         explicit json_array(std::size_t n, 
                             const allocator_type& alloc = allocator_type())
             : allocator_holder<allocator_type>(alloc), 
+              packed_numbers_type(alloc),
               elements_(n,Json(),value_allocator_type(alloc))
         {
         }
@@ -66,6 +402,7 @@ namespace jsoncons {
                             const Json& value, 
                             const allocator_type& alloc = allocator_type())
             : allocator_holder<allocator_type>(alloc), 
+              packed_numbers_type(alloc),
               elements_(n,value,value_allocator_type(alloc))
         {
         }
@@ -73,27 +410,35 @@ namespace jsoncons {
         template <class InputIterator>
         json_array(InputIterator begin, InputIterator end, const allocator_type& alloc = allocator_type())
             : allocator_holder<allocator_type>(alloc), 
+              packed_numbers_type(alloc),
               elements_(begin,end,value_allocator_type(alloc))
         {
         }
         json_array(const json_array& val)
             : allocator_holder<allocator_type>(val.get_allocator()),
+              packed_numbers_type(val.numbers()),
+              elements_view_type(),
               elements_(val.elements_)
         {
         }
         json_array(const json_array& val, const allocator_type& alloc)
             : allocator_holder<allocator_type>(alloc), 
+              packed_numbers_type(val.numbers(),alloc),
+              elements_view_type(),
               elements_(val.elements_,value_allocator_type(alloc))
         {
         }
 
         json_array(json_array&& val) noexcept
             : allocator_holder<allocator_type>(val.get_allocator()), 
+              packed_numbers_type(std::move(val.numbers())),
+              elements_view_type(std::move(val.elements_view())),
               elements_(std::move(val.elements_))
         {
         }
         json_array(json_array&& val, const allocator_type& alloc)
             : allocator_holder<allocator_type>(alloc), 
+              packed_numbers_type(std::move(val.numbers()),alloc),
               elements_(std::move(val.elements_),value_allocator_type(alloc))
         {
         }
@@ -101,6 +446,7 @@ namespace jsoncons {
         json_array(const std::initializer_list<Json>& init, 
                    const allocator_type& alloc = allocator_type())
             : allocator_holder<allocator_type>(alloc), 
+              packed_numbers_type(alloc),
               elements_(init,value_allocator_type(alloc))
         {
         }
@@ -109,39 +455,83 @@ namespace jsoncons {
             destroy();
         }
 
+        // Packed numbers
+
+        // Returns true if the elements are held as packed numbers 
+        bool is_packed() const noexcept
+        {
+            return numbers().kind() != detail::packed_kind::none;
+        }
+
+        detail::packed_kind packing() const noexcept
+        {
+            return numbers().kind();
+        }
+
+        // Requires packing() == detail::packed_kind_of<T>::value
+        template <class T>
+        jsoncons::span<const T> packed_data() const noexcept
+        {
+            return numbers().template data<T>();
+        }
+
+        // Replaces the elements with the numbers in [data, data+length), packed if 
+        // the layout is packed_array_layout
+        template <class T>
+        void assign_numbers(const T* data, std::size_t length)
+        {
+            assign_numbers_(array_layout(), data, length);
+        }
+
+        // Converts packed numbers to generic elements
+        void unpack()
+        {
+            unpack_(array_layout());
+        }
+
         reference back()
         {
+            unpack();
             return elements_.back();
         }
 
         const_reference back() const
         {
-            return elements_.back();
+            return const_elements().back();
         }
 
         void pop_back()
         {
+            unpack();
             elements_.pop_back();
         }
 
         bool empty() const
         {
-            return elements_.empty();
+            return size() == 0;
         }
 
         void swap(json_array<Json>& val) noexcept
         {
+            numbers().swap(val.numbers());
+            elements_view().swap(val.elements_view());
             elements_.swap(val.elements_);
         }
 
-        std::size_t size() const {return elements_.size();}
+        std::size_t size() const {return is_packed() ? numbers().size() : elements_.size();}
 
-        std::size_t capacity() const {return elements_.capacity();}
+        std::size_t capacity() const {return is_packed() ? numbers().capacity() : elements_.capacity();}
 
-        void clear() {elements_.clear();}
+        void clear() 
+        {
+            numbers().clear();
+            elements_view().reset();
+            elements_.clear();
+        }
 
         void shrink_to_fit() 
         {
+            numbers().shrink_to_fit();
             for (std::size_t i = 0; i < elements_.size(); ++i)
             {
                 elements_[i].shrink_to_fit();
@@ -149,16 +539,28 @@ namespace jsoncons {
             elements_.shrink_to_fit();
         }
 
-        void reserve(std::size_t n) {elements_.reserve(n);}
+        void reserve(std::size_t n) 
+        {
+            reserve_(array_layout(), n);
+        }
 
-        void resize(std::size_t n) {elements_.resize(n);}
+        void resize(std::size_t n) 
+        {
+            unpack();
+            elements_.resize(n);
+        }
 
-        void resize(std::size_t n, const Json& val) {elements_.resize(n,val);}
+        void resize(std::size_t n, const Json& val) 
+        {
+            unpack();
+            elements_.resize(n,val);
+        }
 
     #if !defined(JSONCONS_NO_DEPRECATED)
         JSONCONS_DEPRECATED_MSG("Instead, use erase(const_iterator, const_iterator)")
         void remove_range(std::size_t from_index, std::size_t to_index) 
         {
+            unpack();
             JSONCONS_ASSERT(from_index <= to_index);
             JSONCONS_ASSERT(to_index <= elements_.size());
             elements_.erase(elements_.cbegin()+from_index,elements_.cbegin()+to_index);
@@ -166,6 +568,7 @@ namespace jsoncons {
     #endif
         void erase(const_iterator pos) 
         {
+            unpack();
     #if defined(JSONCONS_NO_ERASE_TAKING_CONST_ITERATOR)
             iterator it = elements_.begin() + (pos - elements_.begin());
             elements_.erase(it);
@@ -176,6 +579,7 @@ namespace jsoncons {
 
         void erase(const_iterator first, const_iterator last) 
         {
+            unpack();
     #if defined(JSONCONS_NO_ERASE_TAKING_CONST_ITERATOR)
             iterator it1 = elements_.begin() + (first - elements_.begin());
             iterator it2 = elements_.begin() + (last - elements_.begin());
@@ -185,9 +589,16 @@ namespace jsoncons {
     #endif
         }
 
-        Json& operator[](std::size_t i) {return elements_[i];}
+        Json& operator[](std::size_t i) 
+        {
+            unpack();
+            return elements_[i];
+        }
 
-        const Json& operator[](std::size_t i) const {return elements_[i];}
+        const Json& operator[](std::size_t i) const 
+        {
+            return const_elements()[i];
+        }
 
         // push_back
 
@@ -195,20 +606,29 @@ namespace jsoncons {
         typename std::enable_if<jsoncons::detail::is_stateless<A>::value,void>::type 
         push_back(T&& value)
         {
-            elements_.emplace_back(std::forward<T>(value));
+            if (!push_packed_(array_layout(), value))
+            {
+                unpack();
+                elements_.emplace_back(std::forward<T>(value));
+            }
         }
 
         template <class T, class A=allocator_type>
         typename std::enable_if<!jsoncons::detail::is_stateless<A>::value,void>::type 
         push_back(T&& value)
         {
-            elements_.emplace_back(std::forward<T>(value),get_allocator());
+            if (!push_packed_(array_layout(), value))
+            {
+                unpack();
+                elements_.emplace_back(std::forward<T>(value),get_allocator());
+            }
         }
 
         template <class T, class A=allocator_type>
         typename std::enable_if<jsoncons::detail::is_stateless<A>::value,iterator>::type 
         insert(const_iterator pos, T&& value)
         {
+            unpack();
     #if defined(JSONCONS_NO_ERASE_TAKING_CONST_ITERATOR)
             iterator it = elements_.begin() + (pos - elements_.begin());
             return elements_.emplace(it, std::forward<T>(value));
@@ -220,6 +640,7 @@ namespace jsoncons {
         typename std::enable_if<!jsoncons::detail::is_stateless<A>::value,iterator>::type 
         insert(const_iterator pos, T&& value)
         {
+            unpack();
     #if defined(JSONCONS_NO_ERASE_TAKING_CONST_ITERATOR)
             iterator it = elements_.begin() + (pos - elements_.begin());
             return elements_.emplace(it, std::forward<T>(value), get_allocator());
@@ -231,6 +652,7 @@ namespace jsoncons {
         template <class InputIt>
         iterator insert(const_iterator pos, InputIt first, InputIt last)
         {
+            unpack();
     #if defined(JSONCONS_NO_ERASE_TAKING_CONST_ITERATOR)
             iterator it = elements_.begin() + (pos - elements_.begin());
             elements_.insert(it, first, last);
@@ -244,6 +666,7 @@ namespace jsoncons {
         typename std::enable_if<jsoncons::detail::is_stateless<A>::value,iterator>::type 
         emplace(const_iterator pos, Args&&... args)
         {
+            unpack();
     #if defined(JSONCONS_NO_ERASE_TAKING_CONST_ITERATOR)
             iterator it = elements_.begin() + (pos - elements_.begin());
             return elements_.emplace(it, std::forward<Args>(args)...);
@@ -255,73 +678,345 @@ namespace jsoncons {
         template <class... Args>
         Json& emplace_back(Args&&... args)
         {
+            unpack();
             elements_.emplace_back(std::forward<Args>(args)...);
             return elements_.back();
         }
 
-        iterator begin() {return elements_.begin();}
+        iterator begin() 
+        {
+            unpack();
+            return elements_.begin();
+        }
 
-        iterator end() {return elements_.end();}
+        iterator end() 
+        {
+            unpack();
+            return elements_.end();
+        }
 
-        const_iterator begin() const {return elements_.begin();}
+        const_iterator begin() const 
+        {
+            return const_elements().begin();
+        }
 
-        const_iterator end() const {return elements_.end();}
+        const_iterator end() const 
+        {
+            return const_elements().end();
+        }
 
         bool operator==(const json_array<Json>& rhs) const noexcept
         {
-            return elements_ == rhs.elements_;
+            if (!is_packed() && !rhs.is_packed())
+            {
+                return elements_ == rhs.elements_;
+            }
+            if (size() != rhs.size())
+            {
+                return false;
+            }
+            Json lhs_temp;
+            Json rhs_temp;
+            for (std::size_t i = 0; i < size(); ++i)
+            {
+                if (!(item_(i, lhs_temp) == rhs.item_(i, rhs_temp)))
+                {
+                    return false;
+                }
+            }
+            return true;
         }
 
         bool operator<(const json_array<Json>& rhs) const noexcept
         {
-            return elements_ < rhs.elements_;
+            if (!is_packed() && !rhs.is_packed())
+            {
+                return elements_ < rhs.elements_;
+            }
+            Json lhs_temp;
+            Json rhs_temp;
+            for (std::size_t i = 0; i < size() && i < rhs.size(); ++i)
+            {
+                const Json& a = item_(i, lhs_temp);
+                const Json& b = rhs.item_(i, rhs_temp);
+                if (a < b)
+                {
+                    return true;
+                }
+                if (b < a)
+                {
+                    return false;
+                }
+            }
+            return size() < rhs.size();
         }
     private:
 
         json_array& operator=(const json_array<Json>&) = delete;
 
-        void destroy() noexcept
+        packed_numbers_type& numbers() noexcept
         {
-            while (!elements_.empty())
-            {
-                value_type current = std::move(elements_.back());
-                elements_.pop_back();
-                switch (current.storage())
-                {
-                    case storage_kind::array_value:
-                    {
-                        for (auto&& item : current.array_range())
-                        {
-                            if (item.size() > 0) // non-empty object or array
-                            {
-                                elements_.push_back(std::move(item));
-                                assert(item.size() == 0);
-                            }
-                        }
-                        current.clear();                           
-                        break;
-                    }
-                    case storage_kind::object_value:
-                    {
-                        for (auto&& kv : current.object_range())
-                        {
-                            if (kv.value().size() > 0) // non-empty object or array
-                            {
-                                elements_.push_back(std::move(kv.value()));
-                                assert(kv.value().size() == 0);
-                            }
-                        }
-                        current.clear();                           
-                        break;
-                    }
-                    default:
-                        break;
-                }
-            }
+            return *this;
         }
-    };
 
-    struct sorted_unique_range_tag
+        const packed_numbers_type& numbers() const noexcept
+        {
+            return *this;
+        }
+
+        elements_view_type& elements_view() noexcept
+        {
+            return *this;
+        }
+
+        const elements_view_type& elements_view() const noexcept
+        {
+            return *this;
+        }
+
+        // The elements for const access, without changing a packed array
+        const value_container_type& const_elements() const
+        {
+            return const_elements_(array_layout());
+        }
+
+        const value_container_type& const_elements_(generic_array_layout) const noexcept
+        {
+            return elements_;
+        }
+
+        const value_container_type& const_elements_(packed_array_layout) const
+        {
+            if (!is_packed())
+            {
+                return elements_;
+            }
+            // Sized to the numbers, as nothing is pushed back onto the copy
+            return elements_view().get(elements_.get_allocator(), 
+                                       [this](value_container_type& elements)
+                                       {
+                                           elements.reserve(numbers().size());
+                                           unpack_to_(elements);
+                                       });
+        }
+
+        // Returns element i, materializing a packed number in temp
+        const Json& item_(std::size_t i, Json& temp) const
+        {
+            switch (numbers().kind())
+            {
+                case detail::packed_kind::float32_value:
+                    temp = Json(numbers().template data<float>()[i], semantic_tag::none);
+                    return temp;
+                case detail::packed_kind::float64_value:
+                    temp = Json(numbers().template data<double>()[i], semantic_tag::none);
+                    return temp;
+                case detail::packed_kind::int64_value:
+                    temp = Json(numbers().template data<int64_t>()[i], semantic_tag::none);
+                    return temp;
+                case detail::packed_kind::uint64_value:
+                    temp = Json(numbers().template data<uint64_t>()[i], semantic_tag::none);
+                    return temp;
+                default:
+                    return elements_[i];
+            }
+        }
+
+        void unpack_(generic_array_layout) noexcept
+        {
+        }
+
+        void unpack_(packed_array_layout)
+        {
+            if (numbers().capacity() == 0)
+            {
+                return;
+            }
+            if (!elements_view().take(elements_))
+            {
+                elements_.reserve(numbers().capacity());
+                unpack_to_(elements_);
+            }
+            numbers().release();
+        }
+
+        void unpack_to_(value_container_type& elements) const
+        {
+            switch (numbers().kind())
+            {
+                case detail::packed_kind::float32_value:
+                    unpack_numbers_(numbers().template data<float>(), elements);
+                    break;
+                case detail::packed_kind::float64_value:
+                    unpack_numbers_(numbers().template data<double>(), elements);
+                    break;
+                case detail::packed_kind::int64_value:
+                    unpack_numbers_(numbers().template data<int64_t>(), elements);
+                    break;
+                case detail::packed_kind::uint64_value:
+                    unpack_numbers_(numbers().template data<uint64_t>(), elements);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        template <class T>
+        static void unpack_numbers_(const jsoncons::span<const T>& data, value_container_type& elements)
+        {
+            for (auto value : data)
+            {
+                elements.emplace_back(value, semantic_tag::none);
+            }
+        }
+
+        void reserve_(generic_array_layout, std::size_t n) 
+        {
+            elements_.reserve(n);
+        }
+
+        // An empty array reserves packed numbers, which are handed to the
+        // generic elements if the first element pushed back is not a number 
+        void reserve_(packed_array_layout, std::size_t n) 
+        {
+            if (is_packed() || elements_.empty())
+            {
+                numbers().reserve(n);
+            }
+            else
+            {
+                elements_.reserve(n);
+            }
+        }
+
+        template <class T>
+        void assign_numbers_(generic_array_layout, const T* data, std::size_t length)
+        {
+            elements_.clear();
+            elements_.reserve(length);
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                elements_.emplace_back(data[i], semantic_tag::none);
+            }
+        }
+
+        template <class T>
+        void assign_numbers_(packed_array_layout, const T* data, std::size_t length)
+        {
+            elements_.clear();
+            elements_view().reset();
+            numbers().assign(data, length);
+        }
+
+        template <class T>
+        bool push_packed_(generic_array_layout, const T&) noexcept
+        {
+            return false;
+        }
+
+        // Packs a number into an empty or packed array, returns false if the
+        // value is not a number of the kind packed
+        template <class T>
+        bool push_packed_(packed_array_layout, const T& value)
+        {
+            return elements_.empty() ? push_number_(value) : false;
+        }
+
+        bool push_number_(const Json& value)
+        {
+            if (value.tag() != semantic_tag::none)
+            {
+                return false;
+            }
+            switch (value.storage())
+            {
+                case storage_kind::double_value:
+                    return push_number_as_(value.template as<double>());
+                case storage_kind::int64_value:
+                    return push_number_as_(value.template as<int64_t>());
+                case storage_kind::uint64_value:
+                    return push_number_as_(value.template as<uint64_t>());
+                default:
+                    return false;
+            }
+        }
+
+        template <class T>
+        typename std::enable_if<std::is_arithmetic<T>::value,bool>::type
+        push_number_(T value)
+        {
+            return push_number_(Json(value));
+        }
+
+        template <class T>
+        typename std::enable_if<!std::is_arithmetic<T>::value && !std::is_same<T,Json>::value,bool>::type
+        push_number_(const T&)
+        {
+            return false;
+        }
+
+        template <class T>
+        bool push_number_as_(T value)
+        {
+            const detail::packed_kind kind = numbers().kind();
+            if (kind != detail::packed_kind::none && kind != detail::packed_kind_of<T>::value)
+            {
+                return false;
+            }
+            elements_view().reset();
+            numbers().push_back(value);
+            return true;
+        }
+
+        void destroy() noexcept
+        {
+            while (!elements_.empty())
+            {
+                value_type current = std::move(elements_.back());
+                elements_.pop_back();
+                if (current.use_count() > 1)
+                {
+                    continue; // shared with another value, and not destroyed here
+                }
+                switch (current.storage())
+                {
+                    case storage_kind::array_value:
+                    {
+                        if (!current.array_value().is_packed())
+                        {
+                            for (auto&& item : current.array_range())
+                            {
+                                if (item.size() > 0) // non-empty object or array
+                                {
+                                    elements_.push_back(std::move(item));
+                                    assert(item.size() == 0);
+                                }
+                            }
+                        }
+                        current.clear();                           
+                        break;
+                    }
+                    case storage_kind::object_value:
+                    {
+                        for (auto&& kv : current.object_range())
+                        {
+                            if (kv.value().size() > 0) // non-empty object or array
+                            {
+                                elements_.push_back(std::move(kv.value()));
+                                assert(kv.value().size() == 0);
+                            }
+                        }
+                        current.clear();                           
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            }
+        }
+    };
+
+    struct sorted_unique_range_tag
     {
         explicit sorted_unique_range_tag() = default; 
     };
@@ -485,6 +1180,82 @@ namespace jsoncons {
         }
     };
 
+    // key_value_view refers to the key and value of a member of an object that stores
+    // its keys apart from its values. ValueT is Json or const Json.
+
+    template <class KeyT, class ValueT>
+    class key_value_view
+    {
+    public:
+        using key_type = KeyT;
+        using value_type = typename std::remove_const<ValueT>::type;
+        using string_view_type = typename value_type::string_view_type;
+    private:
+        const key_type* key_;
+        ValueT* value_;
+    public:
+        key_value_view(const key_type* key, ValueT* value) noexcept
+            : key_(key), value_(value)
+        {
+        }
+
+        template <class V,
+                  class=typename std::enable_if<!std::is_same<V,ValueT>::value && std::is_convertible<V*,ValueT*>::value>::type>
+        key_value_view(const key_value_view<KeyT,V>& other) noexcept
+            : key_(std::addressof(other.key())), value_(std::addressof(other.value()))
+        {
+        }
+
+        const key_type& key() const
+        {
+            return *key_;
+        }
+
+        ValueT& value() const
+        {
+            return *value_;
+        }
+
+        template <class T>
+        void value(T&& value) const
+        {
+            *value_ = std::forward<T>(value);
+        }
+
+        void shrink_to_fit() const
+        {
+            value_->shrink_to_fit();
+        }
+
+        operator key_value<KeyT,value_type>() const
+        {
+            return key_value<KeyT,value_type>(*key_, *value_);
+        }
+
+        friend bool operator==(const key_value_view& lhs, const key_value_view& rhs) noexcept
+        {
+            return lhs.key() == rhs.key() && lhs.value() == rhs.value();
+        }
+
+        friend bool operator!=(const key_value_view& lhs, const key_value_view& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const key_value_view& lhs, const key_value_view& rhs) noexcept
+        {
+            if (lhs.key() < rhs.key())
+            {
+                return true;
+            }
+            if (lhs.key() == rhs.key() && lhs.value() < rhs.value())
+            {
+                return true;
+            }
+            return false;
+        }
+    };
+
     template <class KeyT, class ValueT>
     struct get_key_value
     {
@@ -510,6 +1281,11 @@ namespace jsoncons {
         {
             return std::move(p);
         }
+        template <class T1,class T2>
+        key_value_type operator()(const key_value_view<T1,T2>& p)
+        {
+            return key_value_type(p.key(),p.value());
+        }
     };
 
     struct sort_key_order
@@ -522,6 +1298,16 @@ namespace jsoncons {
         explicit preserve_key_order() = default; 
     };
 
+    struct hash_index_key_order
+    {
+        explicit hash_index_key_order() = default; 
+    };
+
+    struct shape_key_order
+    {
+        explicit shape_key_order() = default; 
+    };
+
     template <class KeyT,class Json,class Enable = void>
     class json_object
     {
@@ -1985,6 +2771,1448 @@ namespace jsoncons {
         json_object& operator=(const json_object&) = delete;
     };
 
+    // Preserve order, with a hash index for large objects
+    template <class KeyT,class Json>
+    class json_object<KeyT,Json,typename std::enable_if<std::is_same<typename Json::implementation_policy::key_order,hash_index_key_order>::value>::type> : 
+        public allocator_holder<typename Json::allocator_type>
+    {
+    public:
+        using allocator_type = typename Json::allocator_type;
+        using char_type = typename Json::char_type;
+        using key_type = KeyT;
+        //using mapped_type = Json;
+        using string_view_type = typename Json::string_view_type;
+        using key_value_type = key_value<KeyT,Json>;
+    private:
+        using implementation_policy = typename Json::implementation_policy;
+        using key_value_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<key_value_type>;                       
+        using key_value_container_type = typename implementation_policy::template sequence_container_type<key_value_type,key_value_allocator_type>;
+        typedef typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::size_t> index_allocator_type;
+        using index_container_type = typename implementation_policy::template sequence_container_type<std::size_t,index_allocator_type>;
+
+        // Objects with no more members than this are searched linearly, and have no index
+        static constexpr std::size_t max_unindexed_size = 16;
+
+        // members_ holds the members in insertion order. index_ is an open addressing hash table
+        // with linear probing, a power of two slots, and at most half of them used. A slot 
+        // holds the position of a member plus one, or zero if empty.
+        key_value_container_type members_;
+        index_container_type index_;
+    public:
+        using iterator = typename key_value_container_type::iterator;
+        using const_iterator = typename key_value_container_type::const_iterator;
+
+        using allocator_holder<allocator_type>::get_allocator;
+
+        json_object()
+        {
+        }
+        json_object(const allocator_type& alloc)
+            : allocator_holder<allocator_type>(alloc), 
+              members_(key_value_allocator_type(alloc)), 
+              index_(index_allocator_type(alloc))
+        {
+        }
+
+        json_object(const json_object& val)
+            : allocator_holder<allocator_type>(val.get_allocator()), 
+              members_(val.members_),
+              index_(val.index_)
+        {
+        }
+
+        json_object(json_object&& val)
+            : allocator_holder<allocator_type>(val.get_allocator()), 
+              members_(std::move(val.members_)),
+              index_(std::move(val.index_))
+        {
+        }
+
+        json_object(const json_object& val, const allocator_type& alloc) 
+            : allocator_holder<allocator_type>(alloc), 
+              members_(val.members_,key_value_allocator_type(alloc)),
+              index_(val.index_,index_allocator_type(alloc))
+        {
+        }
+
+        json_object(json_object&& val,const allocator_type& alloc) 
+            : allocator_holder<allocator_type>(alloc), 
+              members_(std::move(val.members_),key_value_allocator_type(alloc)),
+              index_(std::move(val.index_),index_allocator_type(alloc))
+        {
+        }
+
+        template<class InputIt>
+        json_object(InputIt first, InputIt last)
+        {
+            insert(first, last, get_key_value<KeyT,Json>());
+        }
+
+        template<class InputIt>
+        json_object(InputIt first, InputIt last, 
+                    const allocator_type& alloc)
+            : allocator_holder<allocator_type>(alloc), 
+              members_(key_value_allocator_type(alloc)), 
+              index_(index_allocator_type(alloc))
+        {
+            insert(first, last, get_key_value<KeyT,Json>());
+        }
+
+        json_object(std::initializer_list<std::pair<std::basic_string<char_type>,Json>> init, 
+                    const allocator_type& alloc = allocator_type())
+            : allocator_holder<allocator_type>(alloc), 
+              members_(key_value_allocator_type(alloc)), 
+              index_(index_allocator_type(alloc))
+        {
+            members_.reserve(init.size());
+            for (auto& item : init)
+            {
+                insert_or_assign(item.first, item.second);
+            }
+        }
+
+        ~json_object() noexcept
+        {
+            destroy();
+        }
+
+        void swap(json_object& val) noexcept
+        {
+            members_.swap(val.members_);
+            index_.swap(val.index_);
+        }
+
+        iterator begin()
+        {
+            return members_.begin();
+        }
+
+        iterator end()
+        {
+            return members_.end();
+        }
+
+        const_iterator begin() const
+        {
+            return members_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return members_.end();
+        }
+
+        std::size_t size() const {return members_.size();}
+
+        std::size_t capacity() const {return members_.capacity();}
+
+        void clear() 
+        {
+            members_.clear();
+            index_.clear();
+        }
+
+        void shrink_to_fit() 
+        {
+            for (std::size_t i = 0; i < members_.size(); ++i)
+            {
+                members_[i].shrink_to_fit();
+            }
+            members_.shrink_to_fit();
+            index_.shrink_to_fit();
+        }
+
+        void reserve(std::size_t n) {members_.reserve(n);}
+
+        Json& at(std::size_t i) 
+        {
+            if (i >= members_.size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            return members_[i].value();
+        }
+
+        const Json& at(std::size_t i) const 
+        {
+            if (i >= members_.size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            return members_[i].value();
+        }
+
+        iterator find(const string_view_type& name) noexcept
+        {
+            std::size_t slot;
+            return members_.begin() + find_position(name, slot);
+        }
+
+        const_iterator find(const string_view_type& name) const noexcept
+        {
+            std::size_t slot;
+            return members_.begin() + find_position(name, slot);
+        }
+
+        void erase(const_iterator pos) 
+        {
+            erase(pos, pos + 1);
+        }
+
+        void erase(const_iterator first, const_iterator last) 
+        {
+            if (first != last)
+            {
+    #if defined(JSONCONS_NO_ERASE_TAKING_CONST_ITERATOR)
+                iterator it1 = members_.begin() + (first - members_.begin());
+                iterator it2 = members_.begin() + (last - members_.begin());
+                members_.erase(it1,it2);
+    #else
+                members_.erase(first,last);
+    #endif
+                build_index();
+            }
+        }
+
+        void erase(const string_view_type& name) 
+        {
+            std::size_t slot;
+            std::size_t pos = find_position(name, slot);
+            if (pos != members_.size())
+            {
+                members_.erase(members_.begin() + pos);
+                build_index();
+            }
+        }
+
+        // Members with a key that is already present are dropped, as for the other policies
+        template<class InputIt, class Convert>
+        void insert(InputIt first, InputIt last, Convert convert)
+        {
+            std::size_t count = std::distance(first,last);
+            members_.reserve(members_.size() + count);
+            for (auto s = first; s != last; ++s)
+            {
+                key_value_type kv(convert(*s));
+                std::size_t slot;
+                if (find_position(kv.key(), slot) == members_.size())
+                {
+                    members_.emplace_back(std::move(kv));
+                    index_back(slot);
+                }
+            }
+        }
+
+        template<class InputIt, class Convert>
+        void insert(sorted_unique_range_tag, InputIt first, InputIt last, Convert convert)
+        {
+            std::size_t count = std::distance(first,last);
+
+            members_.reserve(members_.size() + count);
+            for (auto s = first; s != last; ++s)
+            {
+                members_.emplace_back(convert(*s));
+            }
+
+            build_index();
+        }
+
+        template <class T, class A=allocator_type>
+        typename std::enable_if<jsoncons::detail::is_stateless<A>::value,std::pair<iterator,bool>>::type
+        insert_or_assign(const string_view_type& name, T&& value)
+        {
+            std::size_t slot;
+            std::size_t pos = find_position(name, slot);
+            if (pos == members_.size())
+            {
+                members_.emplace_back(key_type(name.begin(), name.end()), std::forward<T>(value));
+                index_back(slot);
+                return std::make_pair(members_.begin() + pos,true);
+            }
+            else
+            {
+                auto it = members_.begin() + pos;
+                it->value(Json(std::forward<T>(value)));
+                return std::make_pair(it,false);
+            }
+        }
+
+        template <class T, class A=allocator_type>
+        typename std::enable_if<!jsoncons::detail::is_stateless<A>::value,std::pair<iterator,bool>>::type
+        insert_or_assign(const string_view_type& name, T&& value)
+        {
+            std::size_t slot;
+            std::size_t pos = find_position(name, slot);
+            if (pos == members_.size())
+            {
+                members_.emplace_back(key_type(name.begin(),name.end(),get_allocator()), 
+                                      std::forward<T>(value),get_allocator());
+                index_back(slot);
+                return std::make_pair(members_.begin() + pos,true);
+            }
+            else
+            {
+                auto it = members_.begin() + pos;
+                it->value(Json(std::forward<T>(value),get_allocator()));
+                return std::make_pair(it,false);
+            }
+        }
+
+        template <class A=allocator_type, class T>
+        typename std::enable_if<jsoncons::detail::is_stateless<A>::value,iterator>::type 
+        insert_or_assign(iterator hint, const string_view_type& key, T&& value)
+        {
+            if (hint == members_.end())
+            {
+                auto result = insert_or_assign(key, std::forward<T>(value));
+                return result.first;
+            }
+            else
+            {
+                std::size_t slot;
+                std::size_t pos = find_position(key, slot);
+                if (pos == members_.size())
+                {
+                    pos = hint - members_.begin();
+                    members_.emplace(hint, key_type(key.begin(), key.end()), std::forward<T>(value));
+                    build_index();
+                    return members_.begin() + pos;
+                }
+                else
+                {
+                    auto it = members_.begin() + pos;
+                    it->value(Json(std::forward<T>(value)));
+                    return it;
+                }
+            }
+        }
+
+        template <class A=allocator_type, class T>
+        typename std::enable_if<!jsoncons::detail::is_stateless<A>::value,iterator>::type 
+        insert_or_assign(iterator hint, const string_view_type& key, T&& value)
+        {
+            if (hint == members_.end())
+            {
+                auto result = insert_or_assign(key, std::forward<T>(value));
+                return result.first;
+            }
+            else
+            {
+                std::size_t slot;
+                std::size_t pos = find_position(key, slot);
+                if (pos == members_.size())
+                {
+                    pos = hint - members_.begin();
+                    members_.emplace(hint, 
+                                     key_type(key.begin(),key.end(),get_allocator()), 
+                                     std::forward<T>(value),get_allocator());
+                    build_index();
+                    return members_.begin() + pos;
+                }
+                else
+                {
+                    auto it = members_.begin() + pos;
+                    it->value(Json(std::forward<T>(value),get_allocator()));
+                    return it;
+                }
+            }
+        }
+
+        // merge
+
+        void merge(const json_object& source)
+        {
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                try_emplace(it->key(),it->value());
+            }
+        }
+
+        void merge(json_object&& source)
+        {
+            auto it = std::make_move_iterator(source.begin());
+            auto end = std::make_move_iterator(source.end());
+            for (; it != end; ++it)
+            {
+                try_emplace(it->key(),std::move(it->value()));
+            }
+        }
+
+        void merge(iterator hint, const json_object& source)
+        {
+            std::size_t pos = hint - members_.begin();
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                hint = try_emplace(hint, it->key(),it->value());
+                std::size_t newpos = hint - members_.begin();
+                if (newpos == pos)
+                {
+                    ++hint;
+                    pos = hint - members_.begin();
+                }
+                else
+                {
+                    hint = members_.begin() + pos;
+                }
+            }
+        }
+
+        void merge(iterator hint, json_object&& source)
+        {
+            std::size_t pos = hint - members_.begin();
+
+            auto it = std::make_move_iterator(source.begin());
+            auto end = std::make_move_iterator(source.end());
+            for (; it != end; ++it)
+            {
+                hint = try_emplace(hint, it->key(), std::move(it->value()));
+                std::size_t newpos = hint - members_.begin();
+                if (newpos == pos)
+                {
+                    ++hint;
+                    pos = hint - members_.begin();
+                }
+                else
+                {
+                    hint = members_.begin() + pos;
+                }
+            }
+        }
+
+        // merge_or_update
+
+        void merge_or_update(const json_object& source)
+        {
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                insert_or_assign(it->key(),it->value());
+            }
+        }
+
+        void merge_or_update(json_object&& source)
+        {
+            auto it = std::make_move_iterator(source.begin());
+            auto end = std::make_move_iterator(source.end());
+            for (; it != end; ++it)
+            {
+                insert_or_assign(it->key(),std::move(it->value()));
+            }
+        }
+
+        void merge_or_update(iterator hint, const json_object& source)
+        {
+            std::size_t pos = hint - members_.begin();
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                hint = insert_or_assign(hint, it->key(),it->value());
+                std::size_t newpos = hint - members_.begin();
+                if (newpos == pos)
+                {
+                    ++hint;
+                    pos = hint - members_.begin();
+                }
+                else
+                {
+                    hint = members_.begin() + pos;
+                }
+            }
+        }
+
+        void merge_or_update(iterator hint, json_object&& source)
+        {
+            std::size_t pos = hint - members_.begin();
+            auto it = std::make_move_iterator(source.begin());
+            auto end = std::make_move_iterator(source.end());
+            for (; it != end; ++it)
+            {
+                hint = insert_or_assign(hint, it->key(),std::move(it->value()));
+                std::size_t newpos = hint - members_.begin();
+                if (newpos == pos)
+                {
+                    ++hint;
+                    pos = hint - members_.begin();
+                }
+                else
+                {
+                    hint = members_.begin() + pos;
+                }
+            }
+        }
+
+        // try_emplace
+
+        template <class A=allocator_type, class... Args>
+        typename std::enable_if<jsoncons::detail::is_stateless<A>::value,std::pair<iterator,bool>>::type
+        try_emplace(const string_view_type& name, Args&&... args)
+        {
+            std::size_t slot;
+            std::size_t pos = find_position(name, slot);
+            if (pos == members_.size())
+            {
+                members_.emplace_back(key_type(name.begin(), name.end()), std::forward<Args>(args)...);
+                index_back(slot);
+                return std::make_pair(members_.begin() + pos,true);
+            }
+            else
+            {
+                return std::make_pair(members_.begin() + pos,false);
+            }
+        }
+
+        template <class A=allocator_type, class... Args>
+        typename std::enable_if<!jsoncons::detail::is_stateless<A>::value,std::pair<iterator,bool>>::type
+        try_emplace(const string_view_type& key, Args&&... args)
+        {
+            std::size_t slot;
+            std::size_t pos = find_position(key, slot);
+            if (pos == members_.size())
+            {
+                members_.emplace_back(key_type(key.begin(),key.end(), get_allocator()), 
+                                      std::forward<Args>(args)...);
+                index_back(slot);
+                return std::make_pair(members_.begin() + pos,true);
+            }
+            else
+            {
+                return std::make_pair(members_.begin() + pos,false);
+            }
+        }
+     
+        template <class A=allocator_type, class ... Args>
+        typename std::enable_if<jsoncons::detail::is_stateless<A>::value,iterator>::type
+        try_emplace(iterator hint, const string_view_type& key, Args&&... args)
+        {
+            if (hint == members_.end())
+            {
+                auto result = try_emplace(key, std::forward<Args>(args)...);
+                return result.first;
+            }
+            else
+            {
+                std::size_t slot;
+                std::size_t pos = find_position(key, slot);
+                if (pos == members_.size())
+                {
+                    pos = hint - members_.begin();
+                    members_.emplace(hint, key_type(key.begin(), key.end()), std::forward<Args>(args)...);
+                    build_index();
+                }
+                return members_.begin() + pos;
+            }
+        }
+
+        template <class A=allocator_type, class ... Args>
+        typename std::enable_if<!jsoncons::detail::is_stateless<A>::value,iterator>::type
+        try_emplace(iterator hint, const string_view_type& key, Args&&... args)
+        {
+            if (hint == members_.end())
+            {
+                auto result = try_emplace(key, std::forward<Args>(args)...);
+                return result.first;
+            }
+            else
+            {
+                std::size_t slot;
+                std::size_t pos = find_position(key, slot);
+                if (pos == members_.size())
+                {
+                    pos = hint - members_.begin();
+                    members_.emplace(hint, 
+                                     key_type(key.begin(),key.end(), get_allocator()), 
+                                     std::forward<Args>(args)...);
+                    build_index();
+                }
+                return members_.begin() + pos;
+            }
+        }
+
+        bool operator==(const json_object& rhs) const
+        {
+            return members_ == rhs.members_;
+        }
+     
+        bool operator<(const json_object& rhs) const
+        {
+            return members_ < rhs.members_;
+        }
+    private:
+
+        void destroy() noexcept
+        {
+            if (!members_.empty())
+            {
+                json_array<Json> temp(get_allocator());
+
+                for (auto&& kv : members_)
+                {
+                    if (kv.value().size() > 0)
+                    {
+                        temp.emplace_back(std::move(kv.value()));
+                        assert(kv.value().size() == 0);
+                    }
+                }
+            }
+        }
+
+        static std::size_t hash_key(const string_view_type& key) noexcept
+        {
+            // FNV-1a
+            uint64_t h = 14695981039346656037ull;
+            for (auto c : key)
+            {
+                h ^= static_cast<uint64_t>(c);
+                h *= 1099511628211ull;
+            }
+            return static_cast<std::size_t>(h ^ (h >> 32));
+        }
+
+        // Returns the position of the member with key name, or members_.size() if there is none.
+        // If there is none and the object is indexed, slot is set to the empty slot where 
+        // the key belongs.
+        std::size_t find_position(const string_view_type& name, std::size_t& slot) const noexcept
+        {
+            slot = 0;
+            if (index_.empty())
+            {
+                std::size_t pos = 0;
+                while (pos < members_.size() && !(members_[pos].key() == name))
+                {
+                    ++pos;
+                }
+                return pos;
+            }
+            const std::size_t mask = index_.size() - 1;
+            for (slot = hash_key(name) & mask; index_[slot] != 0; slot = (slot + 1) & mask)
+            {
+                if (members_[index_[slot] - 1].key() == name)
+                {
+                    return index_[slot] - 1;
+                }
+            }
+            return members_.size();
+        }
+
+        // Indexes the last member, which find_position placed at slot
+        void index_back(std::size_t slot)
+        {
+            if (index_.empty() ? members_.size() > max_unindexed_size : members_.size()*2 > index_.size())
+            {
+                build_index();
+            }
+            else if (!index_.empty())
+            {
+                index_[slot] = members_.size();
+            }
+        }
+
+        void build_index()
+        {
+            index_.clear();
+            if (members_.size() <= max_unindexed_size)
+            {
+                return;
+            }
+            std::size_t capacity = 4*max_unindexed_size;
+            while (capacity < members_.size()*2)
+            {
+                capacity *= 2;
+            }
+            index_.resize(capacity, 0);
+            const std::size_t mask = capacity - 1;
+            for (std::size_t i = 0; i < members_.size(); ++i)
+            {
+                std::size_t slot = hash_key(string_view_type(members_[i].key())) & mask;
+                while (index_[slot] != 0)
+                {
+                    slot = (slot + 1) & mask;
+                }
+                index_[slot] = i + 1;
+            }
+        }
+
+        json_object& operator=(const json_object&) = delete;
+    };
+
+namespace detail {
+
+    // Iterates over the members of an object that stores its keys apart from its values,
+    // yielding key_value_view. ValueT is Json or const Json.
+
+    template <class KeyT,class ValueT>
+    class key_value_view_iterator
+    {
+        const KeyT* keys_;
+        ValueT* values_;
+
+        template <class K,class V>
+        friend class key_value_view_iterator;
+    public:
+        using view_type = key_value_view<KeyT,ValueT>;
+
+        class pointer
+        {
+            view_type view_;
+        public:
+            explicit pointer(const view_type& view)
+                : view_(view)
+            {
+            }
+
+            const view_type* operator->() const
+            {
+                return std::addressof(view_);
+            }
+        };
+
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = key_value<KeyT,typename std::remove_const<ValueT>::type>;
+        using difference_type = std::ptrdiff_t;
+        using reference = const view_type;
+
+        key_value_view_iterator() noexcept
+            : keys_(nullptr), values_(nullptr)
+        {
+        }
+
+        key_value_view_iterator(const KeyT* keys, ValueT* values) noexcept
+            : keys_(keys), values_(values)
+        {
+        }
+
+        template <class V,
+                  class=typename std::enable_if<!std::is_same<V,ValueT>::value && std::is_convertible<V*,ValueT*>::value>::type>
+        key_value_view_iterator(const key_value_view_iterator<KeyT,V>& other) noexcept
+            : keys_(other.keys_), values_(other.values_)
+        {
+        }
+
+        reference operator*() const
+        {
+            return view_type(keys_, values_);
+        }
+
+        pointer operator->() const
+        {
+            return pointer(view_type(keys_, values_));
+        }
+
+        reference operator[](difference_type offset) const
+        {
+            return view_type(keys_ + offset, values_ + offset);
+        }
+
+        key_value_view_iterator& operator++()
+        {
+            ++keys_;
+            ++values_;
+            return *this;
+        }
+
+        key_value_view_iterator operator++(int)
+        {
+            key_value_view_iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+
+        key_value_view_iterator& operator--()
+        {
+            --keys_;
+            --values_;
+            return *this;
+        }
+
+        key_value_view_iterator operator--(int)
+        {
+            key_value_view_iterator temp = *this;
+            --*this;
+            return temp;
+        }
+
+        key_value_view_iterator& operator+=(difference_type offset)
+        {
+            keys_ += offset;
+            values_ += offset;
+            return *this;
+        }
+
+        key_value_view_iterator operator+(difference_type offset) const
+        {
+            key_value_view_iterator temp = *this;
+            return temp += offset;
+        }
+
+        friend key_value_view_iterator operator+(difference_type offset, const key_value_view_iterator& it)
+        {
+            return it + offset;
+        }
+
+        key_value_view_iterator& operator-=(difference_type offset)
+        {
+            return *this += -offset;
+        }
+
+        key_value_view_iterator operator-(difference_type offset) const
+        {
+            key_value_view_iterator temp = *this;
+            return temp -= offset;
+        }
+
+        difference_type operator-(const key_value_view_iterator& rhs) const noexcept
+        {
+            return values_ - rhs.values_;
+        }
+
+        bool operator==(const key_value_view_iterator& rhs) const noexcept
+        {
+            return values_ == rhs.values_;
+        }
+
+        bool operator!=(const key_value_view_iterator& rhs) const noexcept
+        {
+            return values_ != rhs.values_;
+        }
+
+        bool operator<(const key_value_view_iterator& rhs) const noexcept
+        {
+            return values_ < rhs.values_;
+        }
+
+        bool operator>(const key_value_view_iterator& rhs) const noexcept
+        {
+            return rhs < *this;
+        }
+
+        bool operator<=(const key_value_view_iterator& rhs) const noexcept
+        {
+            return !(rhs < *this);
+        }
+
+        bool operator>=(const key_value_view_iterator& rhs) const noexcept
+        {
+            return !(*this < rhs);
+        }
+    };
+
+} // namespace detail
+
+    // Preserve order, with the keys held in a shape that objects with the same keys share
+    template <class KeyT,class Json>
+    class json_object<KeyT,Json,typename std::enable_if<std::is_same<typename Json::implementation_policy::key_order,shape_key_order>::value>::type> : 
+        public allocator_holder<typename Json::allocator_type>
+    {
+    public:
+        using allocator_type = typename Json::allocator_type;
+        using char_type = typename Json::char_type;
+        using key_type = KeyT;
+        //using mapped_type = Json;
+        using string_view_type = typename Json::string_view_type;
+        using key_value_type = key_value<KeyT,Json>;
+        using shape_type = jsoncons::detail::object_shape<KeyT,Json>;
+        using shape_cache = jsoncons::detail::object_shape_cache<shape_type>;
+    private:
+        using shape_ref_type = jsoncons::detail::object_shape_ref<shape_type>;
+        using implementation_policy = typename Json::implementation_policy;
+        using value_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<Json>;                       
+        using value_container_type = typename implementation_policy::template sequence_container_type<Json,value_allocator_type>;
+
+        // shape_ holds the keys in insertion order, and is null if the object has never had
+        // a member. values_ holds the value of each key at the same position. shape_ is 
+        // copied before it is modified if another object shares it.
+        shape_ref_type shape_;
+        value_container_type values_;
+    public:
+        using iterator = jsoncons::detail::key_value_view_iterator<KeyT,Json>;
+        using const_iterator = jsoncons::detail::key_value_view_iterator<KeyT,const Json>;
+
+        using allocator_holder<allocator_type>::get_allocator;
+
+        json_object()
+        {
+        }
+        json_object(const allocator_type& alloc)
+            : allocator_holder<allocator_type>(alloc), 
+              values_(value_allocator_type(alloc))
+        {
+        }
+
+        json_object(const json_object& val)
+            : allocator_holder<allocator_type>(val.get_allocator()), 
+              shape_(val.shape_),
+              values_(val.values_)
+        {
+        }
+
+        json_object(json_object&& val)
+            : allocator_holder<allocator_type>(val.get_allocator()), 
+              shape_(std::move(val.shape_)),
+              values_(std::move(val.values_))
+        {
+        }
+
+        json_object(const json_object& val, const allocator_type& alloc) 
+            : allocator_holder<allocator_type>(alloc), 
+              shape_(share_shape(val.shape_, alloc)),
+              values_(val.values_,value_allocator_type(alloc))
+        {
+        }
+
+        json_object(json_object&& val,const allocator_type& alloc) 
+            : allocator_holder<allocator_type>(alloc), 
+              shape_(share_shape(val.shape_, alloc)),
+              values_(std::move(val.values_),value_allocator_type(alloc))
+        {
+        }
+
+        template<class InputIt>
+        json_object(InputIt first, InputIt last)
+        {
+            insert(first, last, get_key_value<KeyT,Json>());
+        }
+
+        template<class InputIt>
+        json_object(InputIt first, InputIt last, 
+                    const allocator_type& alloc)
+            : allocator_holder<allocator_type>(alloc), 
+              values_(value_allocator_type(alloc))
+        {
+            insert(first, last, get_key_value<KeyT,Json>());
+        }
+
+        json_object(std::initializer_list<std::pair<std::basic_string<char_type>,Json>> init, 
+                    const allocator_type& alloc = allocator_type())
+            : allocator_holder<allocator_type>(alloc), 
+              values_(value_allocator_type(alloc))
+        {
+            values_.reserve(init.size());
+            for (auto& item : init)
+            {
+                insert_or_assign(item.first, item.second);
+            }
+        }
+
+        ~json_object() noexcept
+        {
+            destroy();
+        }
+
+        void swap(json_object& val) noexcept
+        {
+            shape_.swap(val.shape_);
+            values_.swap(val.values_);
+        }
+
+        // Returns true if this object and other share their keys
+        bool shares_shape(const json_object& other) const noexcept
+        {
+            return shape_ && shape_.get() == other.shape_.get();
+        }
+
+        iterator begin()
+        {
+            return iterator(shape_ ? shape_->keys() : nullptr, values_.empty() ? nullptr : std::addressof(values_[0]));
+        }
+
+        iterator end()
+        {
+            return begin() + values_.size();
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(shape_ ? shape_->keys() : nullptr, values_.empty() ? nullptr : std::addressof(values_[0]));
+        }
+
+        const_iterator end() const
+        {
+            return begin() + values_.size();
+        }
+
+        std::size_t size() const {return values_.size();}
+
+        std::size_t capacity() const {return values_.capacity();}
+
+        void clear() 
+        {
+            values_.clear();
+            shape_.reset();
+        }
+
+        void shrink_to_fit() 
+        {
+            for (std::size_t i = 0; i < values_.size(); ++i)
+            {
+                values_[i].shrink_to_fit();
+            }
+            values_.shrink_to_fit();
+            if (shape_ && !shape_->shared())
+            {
+                shape_->shrink_to_fit();
+            }
+        }
+
+        void reserve(std::size_t n) {values_.reserve(n);}
+
+        Json& at(std::size_t i) 
+        {
+            if (i >= values_.size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            return values_[i];
+        }
+
+        const Json& at(std::size_t i) const 
+        {
+            if (i >= values_.size())
+            {
+                JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+            }
+            return values_[i];
+        }
+
+        iterator find(const string_view_type& name) noexcept
+        {
+            std::size_t slot;
+            return begin() + find_position(name, slot);
+        }
+
+        const_iterator find(const string_view_type& name) const noexcept
+        {
+            std::size_t slot;
+            return begin() + find_position(name, slot);
+        }
+
+        void erase(const_iterator pos) 
+        {
+            erase(pos, pos + 1);
+        }
+
+        void erase(const_iterator first, const_iterator last) 
+        {
+            std::size_t pos1 = position(first);
+            std::size_t pos2 = position(last);
+            if (pos1 != pos2)
+            {
+                mutable_shape().erase(pos1, pos2);
+                values_.erase(values_.begin() + pos1, values_.begin() + pos2);
+            }
+        }
+
+        void erase(const string_view_type& name) 
+        {
+            std::size_t slot;
+            std::size_t pos = find_position(name, slot);
+            if (pos != values_.size())
+            {
+                mutable_shape().erase(pos, pos + 1);
+                values_.erase(values_.begin() + pos);
+            }
+        }
+
+        // Members with a key that is already present are dropped, as for the other policies
+        template<class InputIt, class Convert>
+        void insert(InputIt first, InputIt last, Convert convert)
+        {
+            std::size_t count = std::distance(first,last);
+            values_.reserve(values_.size() + count);
+            for (auto s = first; s != last; ++s)
+            {
+                key_value_type kv(convert(*s));
+                try_emplace(kv.key(), std::move(kv.value()));
+            }
+        }
+
+        template<class InputIt, class Convert>
+        void insert(sorted_unique_range_tag, InputIt first, InputIt last, Convert convert)
+        {
+            insert(first, last, convert);
+        }
+
+        // Inserts the members of a decoded object, taking the key and value of each 
+        // with get_key and get_value. If cache has a shape with the same keys in the 
+        // same order, the object shares it, otherwise the object's new shape is 
+        // added to cache.
+        template<class InputIt, class GetKey, class GetValue>
+        void insert(InputIt first, InputIt last, GetKey get_key, GetValue get_value, shape_cache& cache)
+        {
+            const bool was_empty = values_.empty();
+            std::size_t count = std::distance(first,last);
+            if (was_empty && count > 0)
+            {
+                shape_ref_type shape = cache.find(first, last, get_key, get_allocator());
+                if (shape)
+                {
+                    values_.reserve(count);
+                    for (auto s = first; s != last; ++s)
+                    {
+                        values_.emplace_back(std::move(get_value(*s)));
+                    }
+                    shape_ = std::move(shape);
+                    return;
+                }
+            }
+            values_.reserve(values_.size() + count);
+            if (count > 0)
+            {
+                mutable_shape().reserve(values_.size() + count);
+            }
+            for (auto s = first; s != last; ++s)
+            {
+                auto&& key = get_key(*s);
+                std::size_t slot;
+                if (find_position(string_view_type(key.data(),key.size()), slot) == values_.size())
+                {
+                    emplace_back_(std::move(key), slot, std::move(get_value(*s)));
+                }
+            }
+            if (was_empty && count > 0 && values_.size() == count)
+            {
+                cache.add(shape_);
+            }
+        }
+
+        template <class T>
+        std::pair<iterator,bool> insert_or_assign(const string_view_type& name, T&& value)
+        {
+            std::size_t slot;
+            std::size_t pos = find_position(name, slot);
+            if (pos == values_.size())
+            {
+                emplace_back_(make_key(name), slot, make_value(std::forward<T>(value)));
+                return std::make_pair(begin() + pos,true);
+            }
+            else
+            {
+                values_[pos] = make_value(std::forward<T>(value));
+                return std::make_pair(begin() + pos,false);
+            }
+        }
+
+        template <class T>
+        iterator insert_or_assign(iterator hint, const string_view_type& key, T&& value)
+        {
+            if (hint == end())
+            {
+                auto result = insert_or_assign(key, std::forward<T>(value));
+                return result.first;
+            }
+            else
+            {
+                std::size_t slot;
+                std::size_t pos = find_position(key, slot);
+                if (pos == values_.size())
+                {
+                    pos = position(hint);
+                    emplace_(pos, make_key(key), make_value(std::forward<T>(value)));
+                }
+                else
+                {
+                    values_[pos] = make_value(std::forward<T>(value));
+                }
+                return begin() + pos;
+            }
+        }
+
+        // merge
+
+        void merge(const json_object& source)
+        {
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                try_emplace(it->key(),it->value());
+            }
+        }
+
+        void merge(json_object&& source)
+        {
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                try_emplace(it->key(),std::move(it->value()));
+            }
+        }
+
+        void merge(iterator hint, const json_object& source)
+        {
+            std::size_t pos = position(hint);
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                hint = try_emplace(hint, it->key(),it->value());
+                std::size_t newpos = position(hint);
+                if (newpos == pos)
+                {
+                    ++hint;
+                    pos = position(hint);
+                }
+                else
+                {
+                    hint = begin() + pos;
+                }
+            }
+        }
+
+        void merge(iterator hint, json_object&& source)
+        {
+            std::size_t pos = position(hint);
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                hint = try_emplace(hint, it->key(), std::move(it->value()));
+                std::size_t newpos = position(hint);
+                if (newpos == pos)
+                {
+                    ++hint;
+                    pos = position(hint);
+                }
+                else
+                {
+                    hint = begin() + pos;
+                }
+            }
+        }
+
+        // merge_or_update
+
+        void merge_or_update(const json_object& source)
+        {
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                insert_or_assign(it->key(),it->value());
+            }
+        }
+
+        void merge_or_update(json_object&& source)
+        {
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                insert_or_assign(it->key(),std::move(it->value()));
+            }
+        }
+
+        void merge_or_update(iterator hint, const json_object& source)
+        {
+            std::size_t pos = position(hint);
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                hint = insert_or_assign(hint, it->key(),it->value());
+                std::size_t newpos = position(hint);
+                if (newpos == pos)
+                {
+                    ++hint;
+                    pos = position(hint);
+                }
+                else
+                {
+                    hint = begin() + pos;
+                }
+            }
+        }
+
+        void merge_or_update(iterator hint, json_object&& source)
+        {
+            std::size_t pos = position(hint);
+            for (auto it = source.begin(); it != source.end(); ++it)
+            {
+                hint = insert_or_assign(hint, it->key(),std::move(it->value()));
+                std::size_t newpos = position(hint);
+                if (newpos == pos)
+                {
+                    ++hint;
+                    pos = position(hint);
+                }
+                else
+                {
+                    hint = begin() + pos;
+                }
+            }
+        }
+
+        // try_emplace
+
+        template <class... Args>
+        std::pair<iterator,bool> try_emplace(const string_view_type& name, Args&&... args)
+        {
+            std::size_t slot;
+            std::size_t pos = find_position(name, slot);
+            if (pos == values_.size())
+            {
+                emplace_back_(make_key(name), slot, std::forward<Args>(args)...);
+                return std::make_pair(begin() + pos,true);
+            }
+            else
+            {
+                return std::make_pair(begin() + pos,false);
+            }
+        }
+
+        template <class... Args>
+        iterator try_emplace(iterator hint, const string_view_type& key, Args&&... args)
+        {
+            if (hint == end())
+            {
+                auto result = try_emplace(key, std::forward<Args>(args)...);
+                return result.first;
+            }
+            else
+            {
+                std::size_t slot;
+                std::size_t pos = find_position(key, slot);
+                if (pos == values_.size())
+                {
+                    pos = position(hint);
+                    emplace_(pos, make_key(key), std::forward<Args>(args)...);
+                }
+                return begin() + pos;
+            }
+        }
+
+        bool operator==(const json_object& rhs) const
+        {
+            if (values_.size() != rhs.values_.size())
+            {
+                return false;
+            }
+            if (!shares_shape(rhs))
+            {
+                for (std::size_t i = 0; i < values_.size(); ++i)
+                {
+                    if (!(shape_->key(i) == rhs.shape_->key(i)))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return values_ == rhs.values_;
+        }
+     
+        bool operator<(const json_object& rhs) const
+        {
+            return std::lexicographical_compare(begin(), end(), rhs.begin(), rhs.end());
+        }
+    private:
+
+        void destroy() noexcept
+        {
+            if (!values_.empty())
+            {
+                json_array<Json> temp(get_allocator());
+
+                for (auto&& val : values_)
+                {
+                    if (val.size() > 0)
+                    {
+                        temp.emplace_back(std::move(val));
+                        assert(val.size() == 0);
+                    }
+                }
+            }
+        }
+
+        static shape_ref_type share_shape(const shape_ref_type& shape, const allocator_type& alloc)
+        {
+            if (!shape || shape->get_allocator() == alloc)
+            {
+                return shape;
+            }
+            return shape_ref_type::create(alloc, *shape);
+        }
+
+        // Returns the shape, after copying it if another object shares it
+        shape_type& mutable_shape()
+        {
+            if (!shape_)
+            {
+                shape_ = shape_ref_type::create(get_allocator());
+            }
+            else if (shape_->shared())
+            {
+                shape_ = shape_ref_type::create(get_allocator(), *shape_);
+            }
+            return *shape_;
+        }
+
+        std::size_t position(const_iterator it) const noexcept
+        {
+            return static_cast<std::size_t>(it - begin());
+        }
+
+        // Returns the position of the member with key name, or values_.size() if there is none.
+        // If there is none and the shape is indexed, slot is set to the empty slot where 
+        // the key belongs.
+        std::size_t find_position(const string_view_type& name, std::size_t& slot) const noexcept
+        {
+            slot = 0;
+            return shape_ ? shape_->find(name, slot) : 0;
+        }
+
+        // Appends a member with a key that find_position placed at slot
+        template <class... Args>
+        void emplace_back_(key_type&& key, std::size_t slot, Args&&... args)
+        {
+            shape_type& shape = mutable_shape();
+            values_.emplace_back(std::forward<Args>(args)...);
+            JSONCONS_TRY
+            {
+                shape.push_back(std::move(key), slot);
+            }
+            JSONCONS_CATCH(...)
+            {
+                values_.pop_back();
+                JSONCONS_RETHROW;
+            }
+        }
+
+        template <class... Args>
+        void emplace_(std::size_t pos, key_type&& key, Args&&... args)
+        {
+            shape_type& shape = mutable_shape();
+            values_.emplace(values_.begin() + pos, std::forward<Args>(args)...);
+            JSONCONS_TRY
+            {
+                shape.insert(pos, std::move(key));
+            }
+            JSONCONS_CATCH(...)
+            {
+                values_.erase(values_.begin() + pos);
+                JSONCONS_RETHROW;
+            }
+        }
+
+        key_type make_key(const string_view_type& name) const
+        {
+            return make_key(name, jsoncons::detail::is_stateless<allocator_type>());
+        }
+
+        key_type make_key(const string_view_type& name, std::true_type) const
+        {
+            return key_type(name.begin(), name.end());
+        }
+
+        key_type make_key(const string_view_type& name, std::false_type) const
+        {
+            return key_type(name.begin(), name.end(), get_allocator());
+        }
+
+        template <class T>
+        Json make_value(T&& value) const
+        {
+            return make_value(std::forward<T>(value), jsoncons::detail::is_stateless<allocator_type>());
+        }
+
+        template <class T>
+        Json make_value(T&& value, std::true_type) const
+        {
+            return Json(std::forward<T>(value));
+        }
+
+        template <class T>
+        Json make_value(T&& value, std::false_type) const
+        {
+            return Json(std::forward<T>(value), get_allocator());
+        }
+
+        json_object& operator=(const json_object&) = delete;
+    };
+
 } // namespace jsoncons
 
 #endif
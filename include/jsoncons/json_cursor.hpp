@@ -58,7 +58,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(),
                       const Allocator& alloc = Allocator(),
                       typename std::enable_if<!std::is_constructible<basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          cursor_visitor_(accept_all),
          buffer_(alloc),
@@ -145,7 +145,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler,
                       std::error_code& ec,
                       typename std::enable_if<!std::is_constructible<basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          cursor_visitor_(accept_all),
          buffer_(alloc),
@@ -245,6 +245,36 @@ public:
     }
 
     void read_buffer(std::error_code& ec)
+    {
+        read_buffer(ec, std::integral_constant<bool,has_read_buffer<source_type>::value>());
+    }
+
+    void read_buffer(std::error_code& ec, std::true_type)
+    {
+        auto s = source_.read_buffer();
+        if (s.size() == 0)
+        {
+            eof_ = true;
+        }
+        else if (begin_)
+        {
+            auto result = unicons::skip_bom(s.begin(), s.end());
+            if (result.ec != unicons::encoding_errc())
+            {
+                ec = result.ec;
+                return;
+            }
+            std::size_t offset = result.it - s.begin();
+            parser_.update(s.data()+offset,s.size()-offset);
+            begin_ = false;
+        }
+        else
+        {
+            parser_.update(s.data(),s.size());
+        }
+    }
+
+    void read_buffer(std::error_code& ec, std::false_type)
     {
         buffer_.clear();
         buffer_.resize(buffer_length_);
@@ -356,7 +386,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(),
                       const Allocator& alloc = Allocator(),
                       typename std::enable_if<!std::is_constructible<basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          cursor_visitor_(filter),
          buffer_(alloc),
@@ -452,7 +482,7 @@ public:
                       std::function<bool(json_errc,const ser_context&)> err_handler,
                       std::error_code& ec,
                       typename std::enable_if<!std::is_constructible<basic_string_view<CharT>,Source>::value>::type* = 0)
-       : source_(source),
+       : source_(std::forward<Source>(source)),
          parser_(options,err_handler,alloc),
          cursor_visitor_(filter),
          buffer_(alloc),
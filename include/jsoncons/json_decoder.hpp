@@ -15,6 +15,7 @@
 #include <utility> // std::move
 #include <jsoncons/json_exception.hpp>
 #include <jsoncons/json_visitor.hpp>
+#include <jsoncons/object_shape.hpp>
 
 namespace jsoncons {
 
@@ -67,6 +68,8 @@ private:
 
     };
 
+    using shape_cache_type = typename jsoncons::detail::object_shape_cache_of<object>::type;
+
     using temp_allocator_type = TempAllocator;
     typedef typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<stack_item> stack_item_allocator_type;
     typedef typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<structure_info> structure_info_allocator_type;
@@ -83,6 +86,7 @@ private:
     key_type name_;
     std::vector<stack_item,stack_item_allocator_type> item_stack_;
     std::vector<structure_info,structure_info_allocator_type> structure_stack_;
+    shape_cache_type shape_cache_;
     bool is_valid_;
 
 public:
@@ -200,11 +204,7 @@ private:
         const size_t count = item_stack_.size() - (structure_index + 1);
         auto first = item_stack_.begin() + (structure_index+1);
         auto last = first + count;
-        item_stack_[structure_index].value_.object_value().insert(
-            std::make_move_iterator(first),
-            std::make_move_iterator(last),
-            [](stack_item&& val){return key_value_type(std::move(val.name_), std::move(val.value_));}
-        );
+        insert_members(item_stack_[structure_index].value_.unshared_object_value(), first, last, shape_cache_);
         item_stack_.erase(item_stack_.begin()+structure_index+1, item_stack_.end());
         structure_stack_.pop_back();
         if (structure_stack_.back().type_ == structure_type::root_t)
@@ -217,6 +217,24 @@ private:
         return true;
     }
 
+    template <class InputIt>
+    static void insert_members(object& obj, InputIt first, InputIt last, jsoncons::detail::no_object_shape_cache&)
+    {
+        obj.insert(std::make_move_iterator(first),
+                   std::make_move_iterator(last),
+                   [](stack_item&& val){return key_value_type(std::move(val.name_), std::move(val.value_));});
+    }
+
+    // Objects decoded with the same keys in the same order share one shape
+    template <class InputIt,class ShapeCache>
+    static void insert_members(object& obj, InputIt first, InputIt last, ShapeCache& cache)
+    {
+        obj.insert(first, last,
+                   [](stack_item& val) -> key_type& {return val.name_;},
+                   [](stack_item& val) -> Json& {return val.value_;},
+                   cache);
+    }
+
     bool visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
     {
         if (structure_stack_.back().type_ == structure_type::root_t)
@@ -431,6 +449,58 @@ private:
         }
         return true;
     }
+
+    bool visit_typed_array(const span<const uint64_t>& s, 
+                           semantic_tag tag,
+                           const ser_context&, 
+                           std::error_code&) override
+    {
+        return typed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const span<const int64_t>& s, 
+                           semantic_tag tag,
+                           const ser_context&, 
+                           std::error_code&) override
+    {
+        return typed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const span<const float>& s, 
+                           semantic_tag tag,
+                           const ser_context&, 
+                           std::error_code&) override
+    {
+        return typed_array_value(s, tag);
+    }
+
+    bool visit_typed_array(const span<const double>& s, 
+                           semantic_tag tag,
+                           const ser_context&, 
+                           std::error_code&) override
+    {
+        return typed_array_value(s, tag);
+    }
+
+    // Typed arrays are assigned whole, and stay packed if Json packs arrays
+    template <class T>
+    bool typed_array_value(const span<const T>& s, semantic_tag tag)
+    {
+        Json value(json_array_arg, tag, array_allocator_);
+        value.unshared_array_value().assign_numbers(s.data(), s.size());
+        switch (structure_stack_.back().type_)
+        {
+            case structure_type::object_t:
+            case structure_type::array_t:
+                item_stack_.emplace_back(std::forward<key_type>(name_), std::move(value));
+                break;
+            case structure_type::root_t:
+                result_.swap(value);
+                is_valid_ = true;
+                return false;
+        }
+        return true;
+    }
 };
 
 }
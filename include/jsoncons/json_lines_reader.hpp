@@ -0,0 +1,434 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_JSON_LINES_READER_HPP
+#define JSONCONS_JSON_LINES_READER_HPP
+
+#include <memory> // std::allocator, std::unique_ptr
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <algorithm> // std::find, std::count
+#include <functional> // std::function
+#include <system_error>
+#include <exception> // std::exception_ptr
+#include <utility> // std::move
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <jsoncons/source.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_decoder.hpp>
+
+namespace jsoncons {
+
+enum class json_lines_order : uint8_t {input, completion};
+
+template <class Json>
+struct json_lines_record
+{
+    std::size_t line;
+    Json value;
+    std::error_code ec;
+    std::size_t column;
+
+    json_lines_record()
+        : line(0), value(), ec(), column(0)
+    {
+    }
+};
+
+class json_lines_options
+{
+    std::size_t num_threads_;
+    json_lines_order order_;
+    std::size_t batch_size_;
+public:
+    static constexpr std::size_t default_batch_size = 1024*1024;
+
+    json_lines_options()
+        : num_threads_(0), order_(json_lines_order::input), batch_size_(default_batch_size)
+    {
+    }
+
+    std::size_t num_threads() const
+    {
+        return num_threads_;
+    }
+
+    json_lines_options& num_threads(std::size_t value)
+    {
+        num_threads_ = value;
+        return *this;
+    }
+
+    json_lines_order order() const
+    {
+        return order_;
+    }
+
+    json_lines_options& order(json_lines_order value)
+    {
+        order_ = value;
+        return *this;
+    }
+
+    std::size_t batch_size() const
+    {
+        return batch_size_;
+    }
+
+    json_lines_options& batch_size(std::size_t value)
+    {
+        batch_size_ = value == 0 ? 1 : value;
+        return *this;
+    }
+};
+
+template <class Json,class Src=jsoncons::stream_source<typename Json::char_type>,class TempAllocator=std::allocator<char>>
+class json_lines_reader
+{
+public:
+    using char_type = typename Json::char_type;
+    using source_type = Src;
+    using record_type = json_lines_record<Json>;
+    using record_handler = std::function<void(record_type&&)>;
+private:
+    using char_allocator_type = typename std::allocator_traits<TempAllocator>:: template rebind_alloc<char_type>;
+
+    struct batch
+    {
+        std::size_t sequence;
+        std::size_t first_line;
+        std::vector<char_type,char_allocator_type> text;
+        std::vector<record_type> records;
+        std::exception_ptr error;
+
+        batch(std::size_t sequence, std::size_t first_line, const TempAllocator& alloc)
+            : sequence(sequence), first_line(first_line), text(alloc)
+        {
+        }
+    };
+
+    // Joins the workers however read() exits
+    class worker_pool
+    {
+        json_lines_reader* reader_;
+        std::vector<std::thread> threads_;
+    public:
+        worker_pool(json_lines_reader* reader, std::size_t num_threads)
+            : reader_(reader)
+        {
+            reader_->stop_ = false;
+            JSONCONS_TRY
+            {
+                for (std::size_t i = 0; i < num_threads; ++i)
+                {
+                    threads_.emplace_back(&json_lines_reader::run_worker, reader_);
+                }
+            }
+            JSONCONS_CATCH(...)
+            {
+                join();
+                JSONCONS_RETHROW;
+            }
+        }
+
+        ~worker_pool() noexcept
+        {
+            join();
+        }
+
+        void join()
+        {
+            {
+                std::lock_guard<std::mutex> lock(reader_->mutex_);
+                reader_->stop_ = true;
+            }
+            reader_->work_available_.notify_all();
+            for (auto& t : threads_)
+            {
+                if (t.joinable())
+                {
+                    t.join();
+                }
+            }
+            threads_.clear();
+        }
+    };
+
+    source_type source_;
+    record_handler handler_;
+    json_lines_options lines_options_;
+    basic_json_decode_options<char_type> options_;
+    TempAllocator alloc_;
+
+    std::vector<char_type,char_allocator_type> carry_;
+    std::size_t line_;
+    std::size_t next_sequence_;
+
+    std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable batch_done_;
+    std::deque<std::unique_ptr<batch>> pending_;
+    std::map<std::size_t,std::unique_ptr<batch>> finished_;
+    bool stop_;
+
+public:
+    template <class Source>
+    json_lines_reader(Source&& source,
+                      record_handler handler,
+                      const json_lines_options& lines_options = json_lines_options(),
+                      const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>(),
+                      const TempAllocator& alloc = TempAllocator())
+       : source_(std::forward<Source>(source)),
+         handler_(handler),
+         lines_options_(lines_options),
+         options_(options),
+         alloc_(alloc),
+         carry_(alloc),
+         line_(1),
+         next_sequence_(0),
+         stop_(false)
+    {
+    }
+
+    json_lines_reader(const json_lines_reader&) = delete;
+    json_lines_reader& operator=(const json_lines_reader&) = delete;
+
+    // Parses every record in the source, passing each one to the handler on the calling thread.
+    // A record that fails to parse is reported with its error code, it does not stop the read.
+    void read()
+    {
+        std::size_t num_threads = lines_options_.num_threads();
+        if (num_threads == 0)
+        {
+            num_threads = std::thread::hardware_concurrency();
+            if (num_threads == 0)
+            {
+                num_threads = 1;
+            }
+        }
+        // Bounds the text held in memory while the handler falls behind
+        const std::size_t max_in_flight = 2*num_threads;
+
+        worker_pool pool(this, num_threads);
+
+        std::size_t in_flight = 0;
+        std::size_t next_to_deliver = next_sequence_;
+        while (true)
+        {
+            while (in_flight < max_in_flight)
+            {
+                std::unique_ptr<batch> b = read_batch();
+                if (!b)
+                {
+                    break;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    pending_.push_back(std::move(b));
+                }
+                work_available_.notify_one();
+                ++in_flight;
+            }
+            if (in_flight == 0)
+            {
+                break;
+            }
+
+            std::unique_ptr<batch> b;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (lines_options_.order() == json_lines_order::input)
+                {
+                    batch_done_.wait(lock, [&]() {return finished_.count(next_to_deliver) != 0;});
+                    auto it = finished_.find(next_to_deliver);
+                    b = std::move(it->second);
+                    finished_.erase(it);
+                    ++next_to_deliver;
+                }
+                else
+                {
+                    batch_done_.wait(lock, [&]() {return !finished_.empty();});
+                    auto it = finished_.begin();
+                    b = std::move(it->second);
+                    finished_.erase(it);
+                }
+            }
+            --in_flight;
+
+            if (b->error)
+            {
+                std::rethrow_exception(b->error);
+            }
+            for (auto& record : b->records)
+            {
+                handler_(std::move(record));
+            }
+        }
+        if (source_.is_error())
+        {
+            JSONCONS_THROW(ser_error(json_errc::source_error, line_, 1));
+        }
+    }
+
+    std::size_t line() const
+    {
+        return line_;
+    }
+
+private:
+    // Reads whole lines up to about batch_size characters, the last partial line is kept for the next batch
+    std::unique_ptr<batch> read_batch()
+    {
+        if (carry_.empty() && (source_.eof() || source_.is_error()))
+        {
+            return std::unique_ptr<batch>();
+        }
+
+        std::unique_ptr<batch> b(new batch(next_sequence_, line_, alloc_));
+        b->text.swap(carry_);
+
+        const std::size_t batch_size = lines_options_.batch_size();
+        std::size_t scanned = 0;
+        std::size_t end = 0;
+        bool found = false;
+        while (!source_.eof() && !source_.is_error())
+        {
+            std::size_t old_size = b->text.size();
+            std::size_t want = old_size < batch_size ? batch_size - old_size : batch_size;
+            b->text.resize(old_size + want);
+            std::size_t count = source_.read(b->text.data() + old_size, want);
+            b->text.resize(old_size + count);
+            if (b->text.size() >= batch_size)
+            {
+                // Find the last line break, the text before it is at least one complete line
+                auto rit = std::find(b->text.rbegin(), b->text.rend() - scanned, '\n');
+                if (rit != b->text.rend() - scanned)
+                {
+                    end = b->text.size() - (rit - b->text.rbegin());
+                    found = true;
+                    break;
+                }
+                scanned = b->text.size();
+            }
+        }
+        if (found)
+        {
+            carry_.assign(b->text.begin() + end, b->text.end());
+            b->text.resize(end);
+        }
+
+        line_ += std::count(b->text.begin(), b->text.end(), '\n');
+        ++next_sequence_;
+        return b;
+    }
+
+    void run_worker()
+    {
+        basic_json_parser<char_type,TempAllocator> parser(options_, alloc_);
+        json_decoder<Json,TempAllocator> decoder(alloc_);
+
+        while (true)
+        {
+            std::unique_ptr<batch> b;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                work_available_.wait(lock, [&]() {return stop_ || !pending_.empty();});
+                if (stop_)
+                {
+                    return;
+                }
+                b = std::move(pending_.front());
+                pending_.pop_front();
+            }
+
+            JSONCONS_TRY
+            {
+                parse_batch(*b, parser, decoder);
+            }
+            JSONCONS_CATCH(...)
+            {
+                b->error = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                std::size_t sequence = b->sequence;
+                finished_.emplace(sequence, std::move(b));
+            }
+            batch_done_.notify_one();
+        }
+    }
+
+    static void parse_batch(batch& b,
+                            basic_json_parser<char_type,TempAllocator>& parser,
+                            json_decoder<Json,TempAllocator>& decoder)
+    {
+        const char_type* p = b.text.data();
+        const char_type* last = p + b.text.size();
+        std::size_t line = b.first_line;
+
+        while (p < last)
+        {
+            const char_type* eol = std::find(p, last, '\n');
+            if (!is_blank(p, eol))
+            {
+                record_type record;
+                record.line = line;
+
+                std::error_code ec;
+                parser.reset();
+                parser.update(p, eol - p);
+                parser.finish_parse(decoder, ec);
+                if (!ec)
+                {
+                    parser.check_done(ec);
+                }
+                if (!ec && decoder.is_valid())
+                {
+                    record.value = decoder.get_result();
+                }
+                else
+                {
+                    record.ec = ec;
+                    record.column = parser.column();
+                }
+                decoder.reset();
+                b.records.push_back(std::move(record));
+            }
+            p = eol + 1;
+            ++line;
+        }
+        // The text is not needed once the batch is parsed
+        b.text.clear();
+        b.text.shrink_to_fit();
+    }
+
+    static bool is_blank(const char_type* p, const char_type* last)
+    {
+        for (; p != last; ++p)
+        {
+            switch (*p)
+            {
+                case ' ':case '\t':case '\r':
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+};
+
+}
+
+#endif
+
@@ -8,6 +8,7 @@
 #define JSONCONS_JSON_PARSER_HPP
 
 #include <memory> // std::allocator
+#include <algorithm> // std::lower_bound
 #include <string>
 #include <vector>
 #include <stdexcept>
@@ -21,6 +22,8 @@
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/json_error.hpp>
 #include <jsoncons/detail/parse_number.hpp>
+#include <jsoncons/detail/simd_scan.hpp>
+#include <jsoncons/detail/structural_index.hpp>
 
 #define JSONCONS_ILLEGAL_CONTROL_CHARACTER \
         case 0x00:case 0x01:case 0x02:case 0x03:case 0x04:case 0x05:case 0x06:case 0x07:case 0x08:case 0x0b: \
@@ -108,12 +111,35 @@ struct strict_json_parsing
     }
 };
 
+// A parse policy fixes at compile time what the parser accepts beyond RFC 8259, 
+// a policy that rules something out removes the code that supports it
+
+struct default_json_parse_policy
+{
+    // Comments are accepted if the error handler recovers from json_errc::illegal_comment
+    static constexpr bool allow_comments = true;
+    // The error handler may continue parsing after other errors
+    static constexpr bool allow_recovery = true;
+    // Strings may be read as NaN or infinity (the nan_to_str, inf_to_str and neginf_to_str options)
+    static constexpr bool allow_nan_replacement = true;
+};
+
+// Strict RFC 8259 JSON. The error handler is still called to report an error, 
+// but parsing always stops.
+
+struct strict_json_parse_policy
+{
+    static constexpr bool allow_comments = false;
+    static constexpr bool allow_recovery = false;
+    static constexpr bool allow_nan_replacement = false;
+};
+
 #if !defined(JSONCONS_NO_DEPRECATED)
 JSONCONS_DEPRECATED_MSG("Instead, use default_json_parsing") typedef default_json_parsing default_parse_error_handler;
 JSONCONS_DEPRECATED_MSG("Instead, use strict_json_parsing") typedef strict_json_parsing strict_parse_error_handler;
 #endif
 
-template <class CharT, class TempAllocator = std::allocator<char>>
+template <class CharT, class TempAllocator = std::allocator<char>, class ParsePolicy = default_json_parse_policy>
 class basic_json_parser : public ser_context
 {
 public:
@@ -133,6 +159,9 @@ private:
     using temp_allocator_type = TempAllocator;
     using char_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<CharT>;
     using parse_state_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<json_parse_state>;
+    using index_allocator_type = typename std::allocator_traits<temp_allocator_type>:: template rebind_alloc<uint32_t>;
+
+    enum class index_status : uint8_t {none, built, unusable};
 
     static constexpr size_t initial_string_buffer_capacity_ = 1024;
     static constexpr int default_initial_stack_capacity_ = 100;
@@ -145,7 +174,7 @@ private:
     uint32_t cp_;
     uint32_t cp2_;
     std::size_t line_;
-    std::size_t position_;
+    std::size_t input_position_; // position of begin_input_, see current_position()
     std::size_t mark_position_;
     std::size_t saved_position_;
     const CharT* begin_input_;
@@ -161,6 +190,13 @@ private:
     std::vector<json_parse_state,parse_state_allocator_type> state_stack_;
     std::vector<std::pair<string_view_type,double>> string_double_map_;
 
+    // Structural index of the buffer passed to update, offsets are from index_base_
+    std::vector<uint32_t,index_allocator_type> structural_index_;
+    const CharT* index_base_;
+    std::size_t index_pos_;
+    index_status index_status_;
+    bool indexed_;
+
     // Noncopyable and nonmoveable
     basic_json_parser(const basic_json_parser&) = delete;
     basic_json_parser& operator=(const basic_json_parser&) = delete;
@@ -193,8 +229,9 @@ public:
          cp_(0),
          cp2_(0),
          line_(1),
-         position_(0),
+         input_position_(0),
          mark_position_(0),
+         saved_position_(0),
          begin_input_(nullptr),
          input_end_(nullptr),
          input_ptr_(nullptr),
@@ -202,24 +239,32 @@ public:
          more_(true),
          done_(false),
          string_buffer_(alloc),
-         state_stack_(alloc)
+         state_stack_(alloc),
+         structural_index_(alloc),
+         index_base_(nullptr),
+         index_pos_(0),
+         index_status_(index_status::none),
+         indexed_(false)
     {
         string_buffer_.reserve(initial_string_buffer_capacity_);
 
         state_stack_.reserve(initial_stack_capacity_);
         push_state(json_parse_state::root);
 
-        if (options_.enable_str_to_nan())
+        if (ParsePolicy::allow_nan_replacement)
         {
-            string_double_map_.emplace_back(options_.nan_to_str(),std::nan(""));
-        }
-        if (options_.enable_str_to_inf())
-        {
-            string_double_map_.emplace_back(options_.inf_to_str(),std::numeric_limits<double>::infinity());
-        }
-        if (options_.enable_str_to_neginf())
-        {
-            string_double_map_.emplace_back(options_.neginf_to_str(),-std::numeric_limits<double>::infinity());
+            if (options_.enable_str_to_nan())
+            {
+                string_double_map_.emplace_back(options_.nan_to_str(),std::nan(""));
+            }
+            if (options_.enable_str_to_inf())
+            {
+                string_double_map_.emplace_back(options_.inf_to_str(),std::numeric_limits<double>::infinity());
+            }
+            if (options_.enable_str_to_neginf())
+            {
+                string_double_map_.emplace_back(options_.neginf_to_str(),-std::numeric_limits<double>::infinity());
+            }
         }
     }
 
@@ -262,21 +307,21 @@ public:
             {
                 case ' ':
                 case '\t':
-                    ++input_ptr_;
-                    ++position_;
+                {
+                    const CharT* p = jsoncons::detail::skip_blanks(input_ptr_ + 1, local_input_end);
+                    input_ptr_ = p;
                     break;
+                }
                 case '\r': 
                     push_state(state_);
                     ++input_ptr_;
-                    ++position_;
                     state_ = json_parse_state::cr;
                     return; 
                 case '\n': 
                     ++input_ptr_;
                     ++line_;
-                    ++position_;
-                    mark_position_ = position_;
-                    return;   
+                    mark_position_ = current_position();
+                    break; // continue with the indentation that follows  
                 default:
                     return;
             }
@@ -293,13 +338,11 @@ public:
             {
                 case json_parse_state::cr:
                     ++line_;
-                    ++position_;
-                    mark_position_ = position_;
+                    mark_position_ = current_position();
                     switch (*input_ptr_)
                     {
                         case '\n':
                             ++input_ptr_;
-                            ++position_;
                             state_ = pop_state();
                             break;
                         default:
@@ -329,7 +372,7 @@ public:
     {
         if (JSONCONS_UNLIKELY(++nesting_depth_ > options_.max_nesting_depth()))
         {
-            more_ = err_handler_(json_errc::max_nesting_depth_exceeded, *this);
+            more_ = recover(json_errc::max_nesting_depth_exceeded);
             if (!more_)
             {
                 ec = json_errc::max_nesting_depth_exceeded;
@@ -346,7 +389,7 @@ public:
     {
         if (JSONCONS_UNLIKELY(nesting_depth_ < 1))
         {
-            err_handler_(json_errc::unexpected_right_brace, *this);
+            recover(json_errc::unexpected_right_brace);
             ec = json_errc::unexpected_right_brace;
             more_ = false;
             return;
@@ -359,14 +402,14 @@ public:
         }
         else if (state_ == json_parse_state::array)
         {
-            err_handler_(json_errc::expected_comma_or_right_bracket, *this);
+            recover(json_errc::expected_comma_or_right_bracket);
             ec = json_errc::expected_comma_or_right_bracket;
             more_ = false;
             return;
         }
         else
         {
-            err_handler_(json_errc::unexpected_right_brace, *this);
+            recover(json_errc::unexpected_right_brace);
             ec = json_errc::unexpected_right_brace;
             more_ = false;
             return;
@@ -386,7 +429,7 @@ public:
     {
         if (++nesting_depth_ > options_.max_nesting_depth())
         {
-            more_ = err_handler_(json_errc::max_nesting_depth_exceeded, *this);
+            more_ = recover(json_errc::max_nesting_depth_exceeded);
             if (!more_)
             {
                 ec = json_errc::max_nesting_depth_exceeded;
@@ -403,7 +446,7 @@ public:
     {
         if (nesting_depth_ < 1)
         {
-            err_handler_(json_errc::unexpected_right_bracket, *this);
+            recover(json_errc::unexpected_right_bracket);
             ec = json_errc::unexpected_right_bracket;
             more_ = false;
             return;
@@ -416,14 +459,14 @@ public:
         }
         else if (state_ == json_parse_state::object)
         {
-            err_handler_(json_errc::expected_comma_or_right_brace, *this);
+            recover(json_errc::expected_comma_or_right_brace);
             ec = json_errc::expected_comma_or_right_brace;
             more_ = false;
             return;
         }
         else
         {
-            err_handler_(json_errc::unexpected_right_bracket, *this);
+            recover(json_errc::unexpected_right_bracket);
             ec = json_errc::unexpected_right_bracket;
             more_ = false;
             return;
@@ -447,9 +490,10 @@ public:
         more_ = true;
         done_ = false;
         line_ = 1;
-        position_ = 0;
+        input_position_ = 0 - static_cast<std::size_t>(input_ptr_ - begin_input_);
         mark_position_ = 0;
         nesting_depth_ = 0;
+        indexed_ = false;
     }
 
     void restart()
@@ -467,27 +511,21 @@ public:
         }
     }
 
+    // Reports extra_character at the line and column of the first non-whitespace
+    // character after the JSON text, however the input is split into buffers
     void check_done(std::error_code& ec)
     {
-        for (; input_ptr_ != input_end_; ++input_ptr_)
+        skip_whitespace();
+        while (input_ptr_ != input_end_)
         {
-            CharT curr_char_ = *input_ptr_;
-            switch (curr_char_)
+            more_ = recover(json_errc::extra_character);
+            if (!more_)
             {
-                case '\n':
-                case '\r':
-                case '\t':
-                case ' ':
-                    break;
-                default:
-                    more_ = err_handler_(json_errc::extra_character, *this);
-                    if (!more_)
-                    {
-                        ec = json_errc::extra_character;
-                        return;
-                    }
-                    break;
+                ec = json_errc::extra_character;
+                return;
             }
+            ++input_ptr_;
+            skip_whitespace();
         }
     }
 
@@ -503,9 +541,12 @@ public:
 
     void update(const CharT* data, std::size_t length)
     {
+        input_position_ = current_position();
         begin_input_ = data;
         input_end_ = data + length;
         input_ptr_ = begin_input_;
+        index_status_ = index_status::none;
+        indexed_ = false;
     }
 
     void parse_some(basic_json_visitor<CharT>& visitor)
@@ -535,6 +576,11 @@ public:
 
     void finish_parse(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
+        if (state_ == json_parse_state::start && options_.structural_index())
+        {
+            // No more input is coming, so the rest of the JSON text is in the buffer 
+            begin_indexed_parse();
+        }
         while (!finished())
         {
             parse_some(visitor, ec);
@@ -543,6 +589,11 @@ public:
 
     void parse_some_(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
+        if (indexed_)
+        {
+            parse_indexed(visitor, ec);
+            return;
+        }
         if (state_ == json_parse_state::before_done)
         {
             visitor.flush();
@@ -582,8 +633,12 @@ public:
                 case json_parse_state::cr:
                     state_ = pop_state();
                     break;
+                case json_parse_state::string:
+                    // An unterminated string is reported one past the end of input, as in earlier releases
+                    ++input_position_;
+                    JSONCONS_FALLTHROUGH;
                 default:
-                    err_handler_(json_errc::unexpected_eof, *this);
+                    recover(json_errc::unexpected_eof);
                     ec = json_errc::unexpected_eof;
                     more_ = false;
                     return;
@@ -602,12 +657,11 @@ public:
                     break;
                 case json_parse_state::cr:
                     ++line_;
-                    mark_position_ = position_;
+                    mark_position_ = current_position();
                     switch (*input_ptr_)
                     {
                         case '\n':
                             ++input_ptr_;
-                            ++position_;
                             state_ = pop_state();
                             break;
                         default:
@@ -620,7 +674,7 @@ public:
                         switch (*input_ptr_)
                         {
                             JSONCONS_ILLEGAL_CONTROL_CHARACTER:
-                                more_ = err_handler_(json_errc::illegal_control_character, *this);
+                                more_ = recover(json_errc::illegal_control_character);
                                 if (!more_)
                                 {
                                     ec = json_errc::illegal_control_character;
@@ -630,21 +684,14 @@ public:
                             case '\r': 
                                 push_state(state_);
                                 ++input_ptr_;
-                                ++position_;
                                 state_ = json_parse_state::cr;
                                 break; 
                             case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
                             case ' ':case '\t':
                                 skip_space();
                                 break;
                             case '/': 
                                 ++input_ptr_;
-                                ++position_;
                                 push_state(state_);
                                 state_ = json_parse_state::slash;
                                 break;
@@ -652,18 +699,15 @@ public:
                                 begin_object(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case '[':
                                 begin_array(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case '\"':
                                 state_ = json_parse_state::string;
                                 ++input_ptr_;
-                                ++position_;
                                 string_buffer_.clear();
                                 parse_string(visitor, ec);
                                 if (ec) return;
@@ -672,7 +716,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back('-');
                                 ++input_ptr_;
-                                ++position_;
                                 state_ = json_parse_state::minus;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -682,7 +725,6 @@ public:
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                                 state_ = json_parse_state::zero;
                                 ++input_ptr_;
-                                ++position_;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
                                 break;
@@ -690,7 +732,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                                 ++input_ptr_;
-                                ++position_;
                                 state_ = json_parse_state::integer;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -708,17 +749,17 @@ public:
                                 if (ec) {return;}
                                 break;
                             case '}':
-                                err_handler_(json_errc::unexpected_right_brace, *this);
+                                recover(json_errc::unexpected_right_brace);
                                 ec = json_errc::unexpected_right_brace;
                                 more_ = false;
                                 return;
                             case ']':
-                                err_handler_(json_errc::unexpected_right_bracket, *this);
+                                recover(json_errc::unexpected_right_bracket);
                                 ec = json_errc::unexpected_right_bracket;
                                 more_ = false;
                                 return;
                             default:
-                                err_handler_(json_errc::syntax_error, *this);
+                                recover(json_errc::syntax_error);
                                 ec = json_errc::syntax_error;
                                 more_ = false;
                                 return;
@@ -731,33 +772,25 @@ public:
                         switch (*input_ptr_)
                         {
                             JSONCONS_ILLEGAL_CONTROL_CHARACTER:
-                                more_ = err_handler_(json_errc::illegal_control_character, *this);
+                                more_ = recover(json_errc::illegal_control_character);
                                 if (!more_)
                                 {
                                     ec = json_errc::illegal_control_character;
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case '\r': 
                                 ++input_ptr_;
-                                ++position_;
                                 push_state(state_);
                                 state_ = json_parse_state::cr;
                                 break; 
                             case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
                             case ' ':case '\t':
                                 skip_space();
                                 break;
                             case '/':
                                 ++input_ptr_;
-                                ++position_;
                                 push_state(state_); 
                                 state_ = json_parse_state::slash;
                                 break;
@@ -765,24 +798,21 @@ public:
                                 end_object(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case ']':
                                 end_array(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case ',':
                                 begin_member_or_element(ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             default:
                                 if (parent() == json_parse_state::array)
                                 {
-                                    more_ = err_handler_(json_errc::expected_comma_or_right_bracket, *this);
+                                    more_ = recover(json_errc::expected_comma_or_right_bracket);
                                     if (!more_)
                                     {
                                         ec = json_errc::expected_comma_or_right_bracket;
@@ -791,7 +821,7 @@ public:
                                 }
                                 else if (parent() == json_parse_state::object)
                                 {
-                                    more_ = err_handler_(json_errc::expected_comma_or_right_brace, *this);
+                                    more_ = recover(json_errc::expected_comma_or_right_brace);
                                     if (!more_)
                                     {
                                         ec = json_errc::expected_comma_or_right_brace;
@@ -799,7 +829,6 @@ public:
                                     }
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                         }
                     }
@@ -809,33 +838,25 @@ public:
                         switch (*input_ptr_)
                         {
                             JSONCONS_ILLEGAL_CONTROL_CHARACTER:
-                                more_ = err_handler_(json_errc::illegal_control_character, *this);
+                                more_ = recover(json_errc::illegal_control_character);
                                 if (!more_)
                                 {
                                     ec = json_errc::illegal_control_character;
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case '\r': 
                                 ++input_ptr_;
-                                ++position_;
                                 push_state(state_);
                                 state_ = json_parse_state::cr;
                                 break; 
                             case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
                             case ' ':case '\t':
                                 skip_space();
                                 break;
                             case '/':
                                 ++input_ptr_;
-                                ++position_;
                                 push_state(state_); 
                                 state_ = json_parse_state::slash;
                                 break;
@@ -843,11 +864,9 @@ public:
                                 end_object(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case '\"':
                                 ++input_ptr_;
-                                ++position_;
                                 push_state(json_parse_state::member_name);
                                 state_ = json_parse_state::string;
                                 string_buffer_.clear();
@@ -855,24 +874,22 @@ public:
                                 if (ec) return;
                                 break;
                             case '\'':
-                                more_ = err_handler_(json_errc::single_quote, *this);
+                                more_ = recover(json_errc::single_quote);
                                 if (!more_)
                                 {
                                     ec = json_errc::single_quote;
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             default:
-                                more_ = err_handler_(json_errc::expected_key, *this);
+                                more_ = recover(json_errc::expected_key);
                                 if (!more_)
                                 {
                                     ec = json_errc::expected_key;
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                         }
                     }
@@ -882,39 +899,30 @@ public:
                         switch (*input_ptr_)
                         {
                             JSONCONS_ILLEGAL_CONTROL_CHARACTER:
-                                more_ = err_handler_(json_errc::illegal_control_character, *this);
+                                more_ = recover(json_errc::illegal_control_character);
                                 if (!more_)
                                 {
                                     ec = json_errc::illegal_control_character;
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case '\r': 
                                 ++input_ptr_;
-                                ++position_;
                                 push_state(state_);
                                 state_ = json_parse_state::cr;
                                 break; 
                             case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
                             case ' ':case '\t':
                                 skip_space();
                                 break;
                             case '/': 
                                 ++input_ptr_;
-                                ++position_;
                                 push_state(state_);
                                 state_ = json_parse_state::slash;
                                 break;
                             case '\"':
                                 ++input_ptr_;
-                                ++position_;
                                 push_state(json_parse_state::member_name);
                                 state_ = json_parse_state::string;
                                 string_buffer_.clear();
@@ -922,7 +930,7 @@ public:
                                 if (ec) return;
                                 break;
                             case '}':
-                                more_ = err_handler_(json_errc::extra_comma, *this);
+                                more_ = recover(json_errc::extra_comma);
                                 if (!more_)
                                 {
                                     ec = json_errc::extra_comma;
@@ -931,27 +939,24 @@ public:
                                 end_object(visitor, ec);  // Recover
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case '\'':
-                                more_ = err_handler_(json_errc::single_quote, *this);
+                                more_ = recover(json_errc::single_quote);
                                 if (!more_)
                                 {
                                     ec = json_errc::single_quote;
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             default:
-                                more_ = err_handler_(json_errc::expected_key, *this);
+                                more_ = recover(json_errc::expected_key);
                                 if (!more_)
                                 {
                                     ec = json_errc::expected_key;
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                         }
                     }
@@ -961,27 +966,20 @@ public:
                         switch (*input_ptr_)
                         {
                             JSONCONS_ILLEGAL_CONTROL_CHARACTER:
-                                more_ = err_handler_(json_errc::illegal_control_character, *this);
+                                more_ = recover(json_errc::illegal_control_character);
                                 if (!more_)
                                 {
                                     ec = json_errc::illegal_control_character;
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case '\r': 
                                 push_state(state_);
                                 state_ = json_parse_state::cr;
                                 ++input_ptr_;
-                                ++position_;
                                 break; 
                             case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
                             case ' ':case '\t':
                                 skip_space();
                                 break;
@@ -989,22 +987,19 @@ public:
                                 push_state(state_);
                                 state_ = json_parse_state::slash;
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case ':':
                                 state_ = json_parse_state::expect_value;
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             default:
-                                more_ = err_handler_(json_errc::expected_colon, *this);
+                                more_ = recover(json_errc::expected_colon);
                                 if (!more_)
                                 {
                                     ec = json_errc::expected_colon;
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                         }
                     }
@@ -1015,51 +1010,40 @@ public:
                         switch (*input_ptr_)
                         {
                             JSONCONS_ILLEGAL_CONTROL_CHARACTER:
-                                more_ = err_handler_(json_errc::illegal_control_character, *this);
+                                more_ = recover(json_errc::illegal_control_character);
                                 if (!more_)
                                 {
                                     ec = json_errc::illegal_control_character;
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case '\r': 
                                 push_state(state_);
                                 ++input_ptr_;
-                                ++position_;
                                 state_ = json_parse_state::cr;
                                 break; 
                             case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
                             case ' ':case '\t':
                                 skip_space();
                                 break;
                             case '/': 
                                 push_state(state_);
                                 ++input_ptr_;
-                                ++position_;
                                 state_ = json_parse_state::slash;
                                 break;
                             case '{':
                                 begin_object(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case '[':
                                 begin_array(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case '\"':
                                 ++input_ptr_;
-                                ++position_;
                                 state_ = json_parse_state::string;
                                 string_buffer_.clear();
                                 parse_string(visitor, ec);
@@ -1069,7 +1053,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back('-');
                                 ++input_ptr_;
-                                ++position_;
                                 state_ = json_parse_state::minus;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -1078,7 +1061,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                                 ++input_ptr_;
-                                ++position_;
                                 state_ = json_parse_state::zero;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -1087,7 +1069,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                                 ++input_ptr_;
-                                ++position_;
                                 state_ = json_parse_state::integer;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -1107,7 +1088,7 @@ public:
                             case ']':
                                 if (parent() == json_parse_state::array)
                                 {
-                                    more_ = err_handler_(json_errc::extra_comma, *this);
+                                    more_ = recover(json_errc::extra_comma);
                                     if (!more_)
                                     {
                                         ec = json_errc::extra_comma;
@@ -1118,7 +1099,7 @@ public:
                                 }
                                 else
                                 {
-                                    more_ = err_handler_(json_errc::expected_value, *this);
+                                    more_ = recover(json_errc::expected_value);
                                     if (!more_)
                                     {
                                         ec = json_errc::expected_value;
@@ -1126,27 +1107,24 @@ public:
                                     }
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case '\'':
-                                more_ = err_handler_(json_errc::single_quote, *this);
+                                more_ = recover(json_errc::single_quote);
                                 if (!more_)
                                 {
                                     ec = json_errc::single_quote;
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             default:
-                                more_ = err_handler_(json_errc::expected_value, *this);
+                                more_ = recover(json_errc::expected_value);
                                 if (!more_)
                                 {
                                     ec = json_errc::expected_value;
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                         }
                     }
@@ -1156,33 +1134,25 @@ public:
                         switch (*input_ptr_)
                         {
                             JSONCONS_ILLEGAL_CONTROL_CHARACTER:
-                                more_ = err_handler_(json_errc::illegal_control_character, *this);
+                                more_ = recover(json_errc::illegal_control_character);
                                 if (!more_)
                                 {
                                     ec = json_errc::illegal_control_character;
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case '\r': 
                                 ++input_ptr_;
-                                ++position_;
                                 push_state(state_);
                                 state_ = json_parse_state::cr;
                                 break; 
                             case '\n': 
-                                ++input_ptr_;
-                                ++line_;
-                                ++position_;
-                                mark_position_ = position_;
-                                break;   
                             case ' ':case '\t':
                                 skip_space();
                                 break;
                             case '/': 
                                 ++input_ptr_;
-                                ++position_;
                                 push_state(state_);
                                 state_ = json_parse_state::slash;
                                 break;
@@ -1190,23 +1160,19 @@ public:
                                 begin_object(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case '[':
                                 begin_array(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case ']':
                                 end_array(visitor, ec);
                                 if (ec) return;
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             case '\"':
                                 ++input_ptr_;
-                                ++position_;
                                 state_ = json_parse_state::string;
                                 string_buffer_.clear();
                                 parse_string(visitor, ec);
@@ -1216,7 +1182,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back('-');
                                 ++input_ptr_;
-                                ++position_;
                                 state_ = json_parse_state::minus;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -1225,7 +1190,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                                 ++input_ptr_;
-                                ++position_;
                                 state_ = json_parse_state::zero;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -1234,7 +1198,6 @@ public:
                                 string_buffer_.clear();
                                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                                 ++input_ptr_;
-                                ++position_;
                                 state_ = json_parse_state::integer;
                                 parse_number(visitor, ec);
                                 if (ec) {return;}
@@ -1252,24 +1215,22 @@ public:
                                 if (ec) {return;}
                                 break;
                             case '\'':
-                                more_ = err_handler_(json_errc::single_quote, *this);
+                                more_ = recover(json_errc::single_quote);
                                 if (!more_)
                                 {
                                     ec = json_errc::single_quote;
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             default:
-                                more_ = err_handler_(json_errc::expected_value, *this);
+                                more_ = recover(json_errc::expected_value);
                                 if (!more_)
                                 {
                                     ec = json_errc::expected_value;
                                     return;
                                 }
                                 ++input_ptr_;
-                                ++position_;
                                 break;
                             }
                         }
@@ -1305,11 +1266,10 @@ public:
                     {
                         case 'r':
                             ++input_ptr_;
-                            ++position_;
                             state_ = json_parse_state::tr;
                             break;
                         default:
-                            err_handler_(json_errc::invalid_value, *this);
+                            recover(json_errc::invalid_value);
                             ec = json_errc::invalid_value;
                             more_ = false;
                             return;
@@ -1322,13 +1282,12 @@ public:
                             state_ = json_parse_state::tru;
                             break;
                         default:
-                            err_handler_(json_errc::invalid_value, *this);
+                            recover(json_errc::invalid_value);
                             ec = json_errc::invalid_value;
                             more_ = false;
                             return;
                     }
                     ++input_ptr_;
-                    ++position_;
                     break;
                 case json_parse_state::tru: 
                     switch (*input_ptr_)
@@ -1345,24 +1304,22 @@ public:
                             }
                             break;
                         default:
-                            err_handler_(json_errc::invalid_value, *this);
+                            recover(json_errc::invalid_value);
                             ec = json_errc::invalid_value;
                             more_ = false;
                             return;
                     }
                     ++input_ptr_;
-                    ++position_;
                     break;
                 case json_parse_state::f: 
                     switch (*input_ptr_)
                     {
                         case 'a':
                             ++input_ptr_;
-                            ++position_;
                             state_ = json_parse_state::fa;
                             break;
                         default:
-                            err_handler_(json_errc::invalid_value, *this);
+                            recover(json_errc::invalid_value);
                             ec = json_errc::invalid_value;
                             more_ = false;
                             return;
@@ -1375,13 +1332,12 @@ public:
                             state_ = json_parse_state::fal;
                             break;
                         default:
-                            err_handler_(json_errc::invalid_value, *this);
+                            recover(json_errc::invalid_value);
                             ec = json_errc::invalid_value;
                             more_ = false;
                             return;
                     }
                     ++input_ptr_;
-                    ++position_;
                     break;
                 case json_parse_state::fal: 
                     switch (*input_ptr_)
@@ -1390,13 +1346,12 @@ public:
                             state_ = json_parse_state::fals;
                             break;
                         default:
-                            err_handler_(json_errc::invalid_value, *this);
+                            recover(json_errc::invalid_value);
                             ec = json_errc::invalid_value;
                             more_ = false;
                             return;
                     }
                     ++input_ptr_;
-                    ++position_;
                     break;
                 case json_parse_state::fals: 
                     switch (*input_ptr_)
@@ -1413,24 +1368,22 @@ public:
                             }
                             break;
                         default:
-                            err_handler_(json_errc::invalid_value, *this);
+                            recover(json_errc::invalid_value);
                             ec = json_errc::invalid_value;
                             more_ = false;
                             return;
                     }
                     ++input_ptr_;
-                    ++position_;
                     break;
                 case json_parse_state::n: 
                     switch (*input_ptr_)
                     {
                         case 'u':
                             ++input_ptr_;
-                            ++position_;
                             state_ = json_parse_state::nu;
                             break;
                         default:
-                            err_handler_(json_errc::invalid_value, *this);
+                            recover(json_errc::invalid_value);
                             ec = json_errc::invalid_value;
                             more_ = false;
                             return;
@@ -1443,13 +1396,12 @@ public:
                             state_ = json_parse_state::nul;
                             break;
                         default:
-                            err_handler_(json_errc::invalid_value, *this);
+                            recover(json_errc::invalid_value);
                             ec = json_errc::invalid_value;
                             more_ = false;
                             return;
                     }
                     ++input_ptr_;
-                    ++position_;
                     break;
                 case json_parse_state::nul: 
                     switch (*input_ptr_)
@@ -1466,13 +1418,12 @@ public:
                         }
                         break;
                     default:
-                        err_handler_(json_errc::invalid_value, *this);
+                        recover(json_errc::invalid_value);
                         ec = json_errc::invalid_value;
                         more_ = false;
                         return;
                     }
                     ++input_ptr_;
-                    ++position_;
                     break;
                 case json_parse_state::slash: 
                 {
@@ -1480,7 +1431,7 @@ public:
                     {
                     case '*':
                         state_ = json_parse_state::slash_star;
-                        more_ = err_handler_(json_errc::illegal_comment, *this);
+                        more_ = accept_comment();
                         if (!more_)
                         {
                             ec = json_errc::illegal_comment;
@@ -1489,7 +1440,7 @@ public:
                         break;
                     case '/':
                         state_ = json_parse_state::slash_slash;
-                        more_ = err_handler_(json_errc::illegal_comment, *this);
+                        more_ = accept_comment();
                         if (!more_)
                         {
                             ec = json_errc::illegal_comment;
@@ -1497,7 +1448,7 @@ public:
                         }
                         break;
                     default:    
-                        more_ = err_handler_(json_errc::syntax_error, *this);
+                        more_ = recover(json_errc::syntax_error);
                         if (!more_)
                         {
                             ec = json_errc::syntax_error;
@@ -1506,7 +1457,6 @@ public:
                         break;
                     }
                     ++input_ptr_;
-                    ++position_;
                     break;
                 }
                 case json_parse_state::slash_star:  
@@ -1516,23 +1466,19 @@ public:
                         case '\r':
                             push_state(state_);
                             ++input_ptr_;
-                            ++position_;
                             state_ = json_parse_state::cr;
                             break;
                         case '\n':
                             ++input_ptr_;
                             ++line_;
-                            ++position_;
-                            mark_position_ = position_;
+                            mark_position_ = current_position();
                             break;
                         case '*':
                             ++input_ptr_;
-                            ++position_;
                             state_ = json_parse_state::slash_star_star;
                             break;
                         default:
                             ++input_ptr_;
-                            ++position_;
                             break;
                     }
                     break;
@@ -1549,7 +1495,6 @@ public:
                         break;
                     default:
                         ++input_ptr_;
-                        ++position_;
                     }
                     break;
                 }
@@ -1565,7 +1510,6 @@ public:
                         break;
                     }
                     ++input_ptr_;
-                    ++position_;
                     break;
                 }
                 default:
@@ -1577,14 +1521,13 @@ public:
 
     void parse_true(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
-        saved_position_ = position_;
+        saved_position_ = current_position();
         if (JSONCONS_LIKELY(input_end_ - input_ptr_ >= 4))
         {
             if (*(input_ptr_+1) == 'r' && *(input_ptr_+2) == 'u' && *(input_ptr_+3) == 'e')
             {
                 more_ = visitor.bool_value(true, semantic_tag::none, *this, ec);
                 input_ptr_ += 4;
-                position_ += 4;
                 if (parent() == json_parse_state::root)
                 {
                     state_ = json_parse_state::before_done;
@@ -1596,7 +1539,7 @@ public:
             }
             else
             {
-                err_handler_(json_errc::invalid_value, *this);
+                recover(json_errc::invalid_value);
                 ec = json_errc::invalid_value;
                 more_ = false;
                 return;
@@ -1605,21 +1548,19 @@ public:
         else
         {
             ++input_ptr_;
-            ++position_;
             state_ = json_parse_state::t;
         }
     }
 
     void parse_null(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
-        saved_position_ = position_;
+        saved_position_ = current_position();
         if (JSONCONS_LIKELY(input_end_ - input_ptr_ >= 4))
         {
             if (*(input_ptr_+1) == 'u' && *(input_ptr_+2) == 'l' && *(input_ptr_+3) == 'l')
             {
                 more_ = visitor.null_value(semantic_tag::none, *this, ec);
                 input_ptr_ += 4;
-                position_ += 4;
                 if (parent() == json_parse_state::root)
                 {
                     state_ = json_parse_state::before_done;
@@ -1631,7 +1572,7 @@ public:
             }
             else
             {
-                err_handler_(json_errc::invalid_value, *this);
+                recover(json_errc::invalid_value);
                 ec = json_errc::invalid_value;
                 more_ = false;
                 return;
@@ -1640,21 +1581,19 @@ public:
         else
         {
             ++input_ptr_;
-            ++position_;
             state_ = json_parse_state::n;
         }
     }
 
     void parse_false(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
-        saved_position_ = position_;
+        saved_position_ = current_position();
         if (JSONCONS_LIKELY(input_end_ - input_ptr_ >= 5))
         {
             if (*(input_ptr_+1) == 'a' && *(input_ptr_+2) == 'l' && *(input_ptr_+3) == 's' && *(input_ptr_+4) == 'e')
             {
                 more_ = visitor.bool_value(false, semantic_tag::none, *this, ec);
                 input_ptr_ += 5;
-                position_ += 5;
                 if (parent() == json_parse_state::root)
                 {
                     state_ = json_parse_state::before_done;
@@ -1666,7 +1605,7 @@ public:
             }
             else
             {
-                err_handler_(json_errc::invalid_value, *this);
+                recover(json_errc::invalid_value);
                 ec = json_errc::invalid_value;
                 more_ = false;
                 return;
@@ -1675,14 +1614,13 @@ public:
         else
         {
             ++input_ptr_;
-            ++position_;
             state_ = json_parse_state::f;
         }
     }
 
     void parse_number(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
-        saved_position_ = position_ - 1;
+        saved_position_ = current_position() - 1;
         const CharT* local_input_end = input_end_;
 
         switch (state_)
@@ -1717,15 +1655,13 @@ minus_sign:
             case '0': 
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++position_;
                 goto zero;
             case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++position_;
                 goto integer;
             default:
-                err_handler_(json_errc::expected_value, *this);
+                recover(json_errc::expected_value);
                 ec = json_errc::expected_value;
                 more_ = false;
                 return;
@@ -1742,7 +1678,6 @@ zero:
                 end_integer_value(visitor, ec);
                 if (ec) return;
                 ++input_ptr_;
-                ++position_;
                 push_state(state_);
                 state_ = json_parse_state::cr;
                 return; 
@@ -1751,8 +1686,7 @@ zero:
                 if (ec) return;
                 ++input_ptr_;
                 ++line_;
-                ++position_;
-                mark_position_ = position_;
+                mark_position_ = current_position();
                 return;   
             case ' ':case '\t':
                 end_integer_value(visitor, ec);
@@ -1763,7 +1697,6 @@ zero:
                 end_integer_value(visitor, ec);
                 if (ec) return;
                 ++input_ptr_;
-                ++position_;
                 push_state(state_);
                 state_ = json_parse_state::slash;
                 return;
@@ -1780,12 +1713,10 @@ zero:
             case '.':
                 string_buffer_.push_back(to_double_.get_decimal_point());
                 ++input_ptr_;
-                ++position_;
                 goto fraction1;
             case 'e':case 'E':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++position_;
                 goto exp1;
             case ',':
                 end_integer_value(visitor, ec);
@@ -1793,16 +1724,15 @@ zero:
                 begin_member_or_element(ec);
                 if (ec) return;
                 ++input_ptr_;
-                ++position_;
                 return;
             case '0': case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
-                err_handler_(json_errc::leading_zero, *this);
+                recover(json_errc::leading_zero);
                 ec = json_errc::leading_zero;
                 more_ = false;
                 state_ = json_parse_state::zero;
                 return;
             default:
-                err_handler_(json_errc::invalid_number, *this);
+                recover(json_errc::invalid_number);
                 ec = json_errc::invalid_number;
                 more_ = false;
                 state_ = json_parse_state::zero;
@@ -1821,7 +1751,6 @@ integer:
                 if (ec) return;
                 push_state(state_);
                 ++input_ptr_;
-                ++position_;
                 state_ = json_parse_state::cr;
                 return; 
             case '\n': 
@@ -1829,8 +1758,7 @@ integer:
                 if (ec) return;
                 ++input_ptr_;
                 ++line_;
-                ++position_;
-                mark_position_ = position_;
+                mark_position_ = current_position();
                 return;   
             case ' ':case '\t':
                 end_integer_value(visitor, ec);
@@ -1842,7 +1770,6 @@ integer:
                 if (ec) return;
                 push_state(state_);
                 ++input_ptr_;
-                ++position_;
                 state_ = json_parse_state::slash;
                 return;
             case '}':
@@ -1858,17 +1785,14 @@ integer:
             case '0': case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++position_;
                 goto integer;
             case '.':
                 string_buffer_.push_back(to_double_.get_decimal_point());
                 ++input_ptr_;
-                ++position_;
                 goto fraction1;
             case 'e':case 'E':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++position_;
                 goto exp1;
             case ',':
                 end_integer_value(visitor, ec);
@@ -1876,10 +1800,9 @@ integer:
                 begin_member_or_element(ec);
                 if (ec) return;
                 ++input_ptr_;
-                ++position_;
                 return;
             default:
-                err_handler_(json_errc::invalid_number, *this);
+                recover(json_errc::invalid_number);
                 ec = json_errc::invalid_number;
                 more_ = false;
                 state_ = json_parse_state::integer;
@@ -1896,10 +1819,9 @@ fraction1:
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++position_;
                 goto fraction2;
             default:
-                err_handler_(json_errc::invalid_number, *this);
+                recover(json_errc::invalid_number);
                 ec = json_errc::invalid_number;
                 more_ = false;
                 state_ = json_parse_state::fraction1;
@@ -1918,7 +1840,6 @@ fraction2:
                 if (ec) return;
                 push_state(state_);
                 ++input_ptr_;
-                ++position_;
                 state_ = json_parse_state::cr;
                 return; 
             case '\n': 
@@ -1926,8 +1847,7 @@ fraction2:
                 if (ec) return;
                 ++input_ptr_;
                 ++line_;
-                ++position_;
-                mark_position_ = position_;
+                mark_position_ = current_position();
                 return;   
             case ' ':case '\t':
                 end_fraction_value(visitor, ec);
@@ -1939,7 +1859,6 @@ fraction2:
                 if (ec) return;
                 push_state(state_);
                 ++input_ptr_;
-                ++position_;
                 state_ = json_parse_state::slash;
                 return;
             case '}':
@@ -1958,20 +1877,17 @@ fraction2:
                 begin_member_or_element(ec);
                 if (ec) return;
                 ++input_ptr_;
-                ++position_;
                 return;
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++position_;
                 goto fraction2;
             case 'e':case 'E':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++position_;
                 goto exp1;
             default:
-                err_handler_(json_errc::invalid_number, *this);
+                recover(json_errc::invalid_number);
                 ec = json_errc::invalid_number;
                 more_ = false;
                 state_ = json_parse_state::fraction2;
@@ -1987,20 +1903,17 @@ exp1:
         {
             case '+':
                 ++input_ptr_;
-                ++position_;
                 goto exp2;
             case '-':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++position_;
                 goto exp2;
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++position_;
                 goto exp3;
             default:
-                err_handler_(json_errc::expected_value, *this);
+                recover(json_errc::expected_value);
                 ec = json_errc::expected_value;
                 more_ = false;
                 state_ = json_parse_state::exp1;
@@ -2017,10 +1930,9 @@ exp2:
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++position_;
                 goto exp3;
             default:
-                err_handler_(json_errc::expected_value, *this);
+                recover(json_errc::expected_value);
                 ec = json_errc::expected_value;
                 more_ = false;
                 state_ = json_parse_state::exp2;
@@ -2039,7 +1951,6 @@ exp3:
                 end_fraction_value(visitor, ec);
                 if (ec) return;
                 ++input_ptr_;
-                ++position_;
                 push_state(state_);
                 state_ = json_parse_state::cr;
                 return; 
@@ -2048,8 +1959,7 @@ exp3:
                 if (ec) return;
                 ++input_ptr_;
                 ++line_;
-                ++position_;
-                mark_position_ = position_;
+                mark_position_ = current_position();
                 return;   
             case ' ':case '\t':
                 end_fraction_value(visitor, ec);
@@ -2061,7 +1971,6 @@ exp3:
                 if (ec) return;
                 push_state(state_);
                 ++input_ptr_;
-                ++position_;
                 state_ = json_parse_state::slash;
                 return;
             case '}':
@@ -2080,15 +1989,13 @@ exp3:
                 begin_member_or_element(ec);
                 if (ec) return;
                 ++input_ptr_;
-                ++position_;
                 return;
             case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
                 string_buffer_.push_back(static_cast<char>(*input_ptr_));
                 ++input_ptr_;
-                ++position_;
                 goto exp3;
             default:
-                err_handler_(json_errc::invalid_number, *this);
+                recover(json_errc::invalid_number);
                 ec = json_errc::invalid_number;
                 more_ = false;
                 state_ = json_parse_state::exp3;
@@ -2100,7 +2007,7 @@ exp3:
 
     void parse_string(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
-        saved_position_ = position_ - 1;
+        saved_position_ = current_position() - 1;
         const CharT* local_input_end = input_end_;
         const CharT* sb = input_ptr_;
 
@@ -2137,12 +2044,18 @@ exp3:
 string_u1:
         while (input_ptr_ < local_input_end)
         {
+            input_ptr_ = jsoncons::detail::find_string_special(input_ptr_, local_input_end);
+            if (input_ptr_ == local_input_end)
+            {
+                break;
+            }
             switch (*input_ptr_)
             {
                 JSONCONS_ILLEGAL_CONTROL_CHARACTER:
                 {
-                    position_ += (input_ptr_ - sb + 1);
-                    more_ = err_handler_(json_errc::illegal_control_character, *this);
+                    // Errors in strings are reported past the offending character
+                    ++input_ptr_;
+                    more_ = recover(json_errc::illegal_control_character);
                     if (!more_)
                     {
                         ec = json_errc::illegal_control_character;
@@ -2150,15 +2063,14 @@ string_u1:
                         return;
                     }
                     // recovery - skip
-                    string_buffer_.append(sb,input_ptr_-sb);
-                    ++input_ptr_;
+                    string_buffer_.append(sb,input_ptr_-sb-1);
                     state_ = json_parse_state::string;
                     return;
                 }
                 case '\r':
                 {
-                    position_ += (input_ptr_ - sb + 1);
-                    more_ = err_handler_(json_errc::illegal_character_in_string, *this);
+                    ++input_ptr_;
+                    more_ = recover(json_errc::illegal_character_in_string);
                     if (!more_)
                     {
                         ec = json_errc::illegal_character_in_string;
@@ -2166,18 +2078,17 @@ string_u1:
                         return;
                     }
                     // recovery - keep
-                    string_buffer_.append(sb, input_ptr_ - sb + 1);
-                    ++input_ptr_;
+                    string_buffer_.append(sb, input_ptr_ - sb);
                     push_state(state_);
                     state_ = json_parse_state::cr;
                     return;
                 }
                 case '\n':
                 {
+                    ++input_ptr_;
                     ++line_;
-                    ++position_;
-                    mark_position_ = position_;
-                    more_ = err_handler_(json_errc::illegal_character_in_string, *this);
+                    mark_position_ = current_position();
+                    more_ = recover(json_errc::illegal_character_in_string);
                     if (!more_)
                     {
                         ec = json_errc::illegal_character_in_string;
@@ -2185,14 +2096,13 @@ string_u1:
                         return;
                     }
                     // recovery - keep
-                    string_buffer_.append(sb, input_ptr_ - sb + 1);
-                    ++input_ptr_;
+                    string_buffer_.append(sb, input_ptr_ - sb);
                     return;
                 }
                 case '\t':
                 {
-                    position_ += (input_ptr_ - sb + 1);
-                    more_ = err_handler_(json_errc::illegal_character_in_string, *this);
+                    ++input_ptr_;
+                    more_ = recover(json_errc::illegal_character_in_string);
                     if (!more_)
                     {
                         ec = json_errc::illegal_character_in_string;
@@ -2200,33 +2110,33 @@ string_u1:
                         return;
                     }
                     // recovery - keep
-                    string_buffer_.append(sb, input_ptr_ - sb + 1);
-                    ++input_ptr_;
+                    string_buffer_.append(sb, input_ptr_ - sb);
                     state_ = json_parse_state::string;
                     return;
                 }
                 case '\\': 
                 {
                     string_buffer_.append(sb,input_ptr_-sb);
-                    position_ += (input_ptr_ - sb + 1);
                     ++input_ptr_;
                     goto escape;
                 }
                 case '\"':
                 {
+                    // The visitor sees the position of the start of the string
+                    const CharT* quote = input_ptr_;
+                    input_ptr_ = sb;
                     if (string_buffer_.length() == 0)
                     {
-                        end_string_value(sb,input_ptr_-sb, visitor, ec);
+                        end_string_value(sb,quote-sb, visitor, ec);
                         if (ec) {return;}
                     }
                     else
                     {
-                        string_buffer_.append(sb,input_ptr_-sb);
+                        string_buffer_.append(sb,quote-sb);
                         end_string_value(string_buffer_.data(),string_buffer_.length(), visitor, ec);
                         if (ec) {return;}
                     }
-                    position_ += (input_ptr_ - sb + 1);
-                    ++input_ptr_;
+                    input_ptr_ = quote + 1;
                     return;
                 }
             default:
@@ -2238,7 +2148,6 @@ string_u1:
         // Buffer exhausted               
         {
             string_buffer_.append(sb,input_ptr_-sb);
-            position_ += (input_ptr_ - sb + 1);
             state_ = json_parse_state::string;
             return;
         }
@@ -2254,50 +2163,41 @@ escape:
         case '\"':
             string_buffer_.push_back('\"');
             sb = ++input_ptr_;
-            ++position_;
             goto string_u1;
         case '\\': 
             string_buffer_.push_back('\\');
             sb = ++input_ptr_;
-            ++position_;
             goto string_u1;
         case '/':
             string_buffer_.push_back('/');
             sb = ++input_ptr_;
-            ++position_;
             goto string_u1;
         case 'b':
             string_buffer_.push_back('\b');
             sb = ++input_ptr_;
-            ++position_;
             goto string_u1;
         case 'f':
             string_buffer_.push_back('\f');
             sb = ++input_ptr_;
-            ++position_;
             goto string_u1;
         case 'n':
             string_buffer_.push_back('\n');
             sb = ++input_ptr_;
-            ++position_;
             goto string_u1;
         case 'r':
             string_buffer_.push_back('\r');
             sb = ++input_ptr_;
-            ++position_;
             goto string_u1;
         case 't':
             string_buffer_.push_back('\t');
             sb = ++input_ptr_;
-            ++position_;
             goto string_u1;
         case 'u':
              cp_ = 0;
              ++input_ptr_;
-             ++position_;
              goto escape_u1;
         default:    
-            err_handler_(json_errc::illegal_escaped_character, *this);
+            recover(json_errc::illegal_escaped_character);
             ec = json_errc::illegal_escaped_character;
             more_ = false;
             state_ = json_parse_state::escape;
@@ -2318,7 +2218,6 @@ escape_u1:
                 return;
             }
             ++input_ptr_;
-            ++position_;
             goto escape_u2;
         }
 
@@ -2336,7 +2235,6 @@ escape_u2:
                 return;
             }
             ++input_ptr_;
-            ++position_;
             goto escape_u3;
         }
 
@@ -2354,7 +2252,6 @@ escape_u3:
                 return;
             }
             ++input_ptr_;
-            ++position_;
             goto escape_u4;
         }
 
@@ -2374,14 +2271,12 @@ escape_u4:
             if (unicons::is_high_surrogate(cp_))
             {
                 ++input_ptr_;
-                ++position_;
                 goto escape_expect_surrogate_pair1;
             }
             else
             {
                 unicons::convert(&cp_, &cp_ + 1, std::back_inserter(string_buffer_));
                 sb = ++input_ptr_;
-                ++position_;
                 state_ = json_parse_state::string;
                 return;
             }
@@ -2399,10 +2294,9 @@ escape_expect_surrogate_pair1:
             case '\\': 
                 cp2_ = 0;
                 ++input_ptr_;
-                ++position_;
                 goto escape_expect_surrogate_pair2;
             default:
-                err_handler_(json_errc::expected_codepoint_surrogate_pair, *this);
+                recover(json_errc::expected_codepoint_surrogate_pair);
                 ec = json_errc::expected_codepoint_surrogate_pair;
                 more_ = false;
                 state_ = json_parse_state::escape_expect_surrogate_pair1;
@@ -2421,10 +2315,9 @@ escape_expect_surrogate_pair2:
             {
             case 'u':
                 ++input_ptr_;
-                ++position_;
                 goto escape_u5;
             default:
-                err_handler_(json_errc::expected_codepoint_surrogate_pair, *this);
+                recover(json_errc::expected_codepoint_surrogate_pair);
                 ec = json_errc::expected_codepoint_surrogate_pair;
                 more_ = false;
                 state_ = json_parse_state::escape_expect_surrogate_pair2;
@@ -2447,7 +2340,6 @@ escape_u5:
             }
         }
         ++input_ptr_;
-        ++position_;
         goto escape_u6;
 
 escape_u6:
@@ -2464,7 +2356,6 @@ escape_u6:
                 return;
             }
             ++input_ptr_;
-            ++position_;
             goto escape_u7;
         }
 
@@ -2482,7 +2373,6 @@ escape_u7:
                 return;
             }
             ++input_ptr_;
-            ++position_;
             goto escape_u8;
         }
 
@@ -2502,7 +2392,6 @@ escape_u8:
             uint32_t cp = 0x10000 + ((cp_ & 0x3FF) << 10) + (cp2_ & 0x3FF);
             unicons::convert(&cp, &cp + 1, std::back_inserter(string_buffer_));
             sb = ++input_ptr_;
-            ++position_;
             goto string_u1;
         }
 
@@ -2516,7 +2405,7 @@ escape_u8:
         case unicons::conv_errc():
             break;
         case unicons::conv_errc::over_long_utf8_sequence:
-            more_ = err_handler_(json_errc::over_long_utf8_sequence, *this);
+            more_ = recover(json_errc::over_long_utf8_sequence);
             if (!more_)
             {
                 ec = json_errc::over_long_utf8_sequence;
@@ -2524,7 +2413,7 @@ escape_u8:
             }
             break;
         case unicons::conv_errc::unpaired_high_surrogate:
-            more_ = err_handler_(json_errc::unpaired_high_surrogate, *this);
+            more_ = recover(json_errc::unpaired_high_surrogate);
             if (!more_)
             {
                 ec = json_errc::unpaired_high_surrogate;
@@ -2532,7 +2421,7 @@ escape_u8:
             }
             break;
         case unicons::conv_errc::expected_continuation_byte:
-            more_ = err_handler_(json_errc::expected_continuation_byte, *this);
+            more_ = recover(json_errc::expected_continuation_byte);
             if (!more_)
             {
                 ec = json_errc::expected_continuation_byte;
@@ -2540,7 +2429,7 @@ escape_u8:
             }
             break;
         case unicons::conv_errc::illegal_surrogate_value:
-            more_ = err_handler_(json_errc::illegal_surrogate_value, *this);
+            more_ = recover(json_errc::illegal_surrogate_value);
             if (!more_)
             {
                 ec = json_errc::illegal_surrogate_value;
@@ -2548,7 +2437,7 @@ escape_u8:
             }
             break;
         default:
-            more_ = err_handler_(json_errc::illegal_codepoint, *this);
+            more_ = recover(json_errc::illegal_codepoint);
             if (!more_)
             {
                 ec = json_errc::illegal_codepoint;
@@ -2583,9 +2472,7 @@ escape_u8:
     JSONCONS_DEPRECATED_MSG("Instead, use update(const CharT*, std::size_t)")
     void set_source(const CharT* data, std::size_t length)
     {
-        begin_input_ = data;
-        input_end_ = data + length;
-        input_ptr_ = begin_input_;
+        update(data, length);
     }
 #endif
 
@@ -2596,7 +2483,7 @@ escape_u8:
 
     std::size_t column() const override
     {
-        return (position_ - mark_position_) + 1;
+        return (current_position() - mark_position_) + 1;
     }
 
     std::size_t position() const override
@@ -2605,63 +2492,80 @@ escape_u8:
     }
 private:
 
+    // The position of input_ptr_ follows from its offset in the buffer, so that 
+    // the parser doesn't have to count characters as it consumes them
+    std::size_t current_position() const
+    {
+        return input_position_ + static_cast<std::size_t>(input_ptr_ - begin_input_);
+    }
+
     void end_integer_value(basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
-        if (string_buffer_[0] == '-')
+        end_integer_value(string_buffer_.data(), string_buffer_.length(), visitor, ec);
+    }
+
+    void end_integer_value(const CharT* s, std::size_t length, basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        if (s[0] == '-')
         {
-            end_negative_value(visitor, ec);
+            end_negative_value(s, length, visitor, ec);
         }
         else
         {
-            end_positive_value(visitor, ec);
+            end_positive_value(s, length, visitor, ec);
         }
     }
 
-    void end_negative_value(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    void end_negative_value(const CharT* s, std::size_t length, basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
-        auto result = jsoncons::detail::to_integer_unchecked<int64_t>(string_buffer_.data(), string_buffer_.length());
+        auto result = jsoncons::detail::to_integer_unchecked<int64_t>(s, length);
         if (result)
         {
             more_ = visitor.int64_value(result.value(), semantic_tag::none, *this, ec);
         }
         else // Must be overflow
         {
-            more_ = visitor.string_value(string_buffer_, semantic_tag::bigint, *this, ec);
+            more_ = visitor.string_value(string_view_type(s, length), semantic_tag::bigint, *this, ec);
         }
         after_value(ec);
     }
 
-    void end_positive_value(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    void end_positive_value(const CharT* s, std::size_t length, basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
-        auto result = jsoncons::detail::to_integer_unchecked<uint64_t>(string_buffer_.data(), string_buffer_.length());
+        auto result = jsoncons::detail::to_integer_unchecked<uint64_t>(s, length);
         if (result)
         {
             more_ = visitor.uint64_value(result.value(), semantic_tag::none, *this, ec);
         }
         else // Must be overflow
         {
-            more_ = visitor.string_value(string_buffer_, semantic_tag::bigint, *this, ec);
+            more_ = visitor.string_value(string_view_type(s, length), semantic_tag::bigint, *this, ec);
         }
         after_value(ec);
     }
 
     void end_fraction_value(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        end_fraction_value(string_buffer_.data(), string_buffer_.length(), visitor, ec);
+    }
+
+    void end_fraction_value(const CharT* s, std::size_t length, basic_json_visitor<CharT>& visitor, std::error_code& ec)
     {
         JSONCONS_TRY
         {
             if (options_.lossless_number())
             {
-                more_ = visitor.string_value(string_buffer_, semantic_tag::bigdec, *this, ec);
+                more_ = visitor.string_value(string_view_type(s, length), semantic_tag::bigdec, *this, ec);
             }
             else
             {
-                double d = to_double_(string_buffer_.c_str(), string_buffer_.length());
+                double d = to_double_(s, length);
                 more_ = visitor.double_value(d, semantic_tag::none, *this, ec);
             }
         }
         JSONCONS_CATCH(...)
         {
-            more_ = err_handler_(json_errc::invalid_number, *this);
+            more_ = recover(json_errc::invalid_number);
             if (!more_)
             {
                 ec = json_errc::invalid_number;
@@ -2676,11 +2580,12 @@ private:
     void end_string_value(const CharT* s, std::size_t length, basic_json_visitor<CharT>& visitor, std::error_code& ec) 
     {
         string_view_type sv(s, length);
-        auto result = unicons::validate(s,s+length);
+        // Only the part of the string past the leading run of ascii characters needs validating
+        auto result = unicons::validate(jsoncons::detail::skip_ascii(s, s+length), s+length);
         if (result.ec != unicons::conv_errc())
         {
             translate_conv_errc(result.ec,ec);
-            position_ += (result.it - s);
+            input_position_ += static_cast<std::size_t>(result.it - s);
             return;
         }
         switch (parent())
@@ -2692,35 +2597,15 @@ private:
             break;
         case json_parse_state::object:
         case json_parse_state::array:
-        {
-            auto it = std::find_if(string_double_map_.begin(), string_double_map_.end(), string_maps_to_double{ sv });
-            if (it != string_double_map_.end())
-            {
-                more_ = visitor.double_value(it->second, semantic_tag::none, *this, ec);
-            }
-            else
-            {
-                more_ = visitor.string_value(sv, semantic_tag::none, *this, ec);
-            }
+            string_or_double_value(sv, visitor, ec);
             state_ = json_parse_state::expect_comma_or_end;
             break;
-        }
         case json_parse_state::root:
-        {
-            auto it = std::find_if(string_double_map_.begin(),string_double_map_.end(),string_maps_to_double{sv});
-            if (it != string_double_map_.end())
-            {
-                more_ = visitor.double_value(it->second, semantic_tag::none, *this, ec);
-            }
-            else
-            {
-                more_ = visitor.string_value(sv, semantic_tag::none, *this, ec);
-            }
+            string_or_double_value(sv, visitor, ec);
             state_ = json_parse_state::before_done;
             break;
-        }
         default:
-            more_ = err_handler_(json_errc::syntax_error, *this);
+            more_ = recover(json_errc::syntax_error);
             if (!more_)
             {
                 ec = json_errc::syntax_error;
@@ -2730,6 +2615,33 @@ private:
         }
     }
 
+    void string_or_double_value(const string_view_type& sv, basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        if (ParsePolicy::allow_nan_replacement && !string_double_map_.empty())
+        {
+            auto it = std::find_if(string_double_map_.begin(), string_double_map_.end(), string_maps_to_double{ sv });
+            if (it != string_double_map_.end())
+            {
+                more_ = visitor.double_value(it->second, semantic_tag::none, *this, ec);
+                return;
+            }
+        }
+        more_ = visitor.string_value(sv, semantic_tag::none, *this, ec);
+    }
+
+    // Reports err to the error handler, returns true if parsing is to continue
+    bool recover(json_errc err)
+    {
+        bool resume = err_handler_(err, *this);
+        return ParsePolicy::allow_recovery && resume;
+    }
+
+    bool accept_comment()
+    {
+        bool resume = err_handler_(json_errc::illegal_comment, *this);
+        return ParsePolicy::allow_comments && resume;
+    }
+
     void begin_member_or_element(std::error_code& ec) 
     {
         switch (parent())
@@ -2743,7 +2655,7 @@ private:
         case json_parse_state::root:
             break;
         default:
-            more_ = err_handler_(json_errc::syntax_error, *this);
+            more_ = recover(json_errc::syntax_error);
             if (!more_)
             {
                 ec = json_errc::syntax_error;
@@ -2765,7 +2677,7 @@ private:
             state_ = json_parse_state::before_done;
             break;
         default:
-            more_ = err_handler_(json_errc::syntax_error, *this);
+            more_ = recover(json_errc::syntax_error);
             if (!more_)
             {
                 ec = json_errc::syntax_error;
@@ -2775,6 +2687,453 @@ private:
         }
     }
 
+    // Parsing with a structural index, for input that is entirely in the buffer
+
+    void begin_indexed_parse()
+    {
+        begin_indexed_parse(std::integral_constant<bool,std::is_same<CharT,char>::value>());
+    }
+
+    void begin_indexed_parse(std::false_type)
+    {
+    }
+
+    void begin_indexed_parse(std::true_type)
+    {
+        // Only the incremental parser can recover from errors other than comments
+        if (ParsePolicy::allow_recovery &&
+            err_handler_.template target<default_json_parsing>() == nullptr &&
+            err_handler_.template target<strict_json_parsing>() == nullptr)
+        {
+            return;
+        }
+        if (index_status_ == index_status::none)
+        {
+            index_base_ = input_ptr_;
+            index_status_ = jsoncons::detail::build_structural_index(input_ptr_, input_end_ - input_ptr_, structural_index_)
+                          ? index_status::built : index_status::unusable;
+        }
+        if (index_status_ != index_status::built || input_ptr_ < index_base_)
+        {
+            return;
+        }
+        // Later JSON texts in the same buffer reuse the index
+        auto it = std::lower_bound(structural_index_.begin(), structural_index_.end(), 
+                                   static_cast<uint32_t>(input_ptr_ - index_base_));
+        index_pos_ = static_cast<std::size_t>(it - structural_index_.begin());
+        indexed_ = true;
+    }
+
+    void parse_indexed(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        const std::size_t index_length = structural_index_.size();
+
+        while (more_ || state_ == json_parse_state::before_done)
+        {
+            if (state_ == json_parse_state::before_done)
+            {
+                visitor.flush();
+                done_ = true;
+                state_ = json_parse_state::done;
+                more_ = false;
+                return;
+            }
+            if (state_ == json_parse_state::done)
+            {
+                more_ = false;
+                return;
+            }
+
+            const CharT* p = index_pos_ < index_length ? index_base_ + structural_index_[index_pos_] : input_end_;
+            if (input_ptr_ < p && !is_whitespace(*input_ptr_))
+            {
+                // Not in the index, a character that directly follows a literal
+                p = input_ptr_;
+            }
+            else if (p != input_end_)
+            {
+                ++index_pos_;
+            }
+            input_ptr_ = p;
+            if (p == input_end_)
+            {
+                report_error(json_errc::unexpected_eof, ec);
+                return;
+            }
+
+            switch (*p)
+            {
+                case '\r':
+                    if (p + 1 != input_end_)
+                    {
+                        ++line_;
+                        mark_position_ = current_position() + 1;
+                    }
+                    ++input_ptr_;
+                    continue;
+                case '\n':
+                    if (p == begin_input_ || *(p - 1) != '\r')
+                    {
+                        ++line_;
+                        mark_position_ = current_position() + 1;
+                    }
+                    ++input_ptr_;
+                    continue;
+                default:
+                    break;
+            }
+
+            switch (state_)
+            {
+                case json_parse_state::start:
+                case json_parse_state::expect_value:
+                case json_parse_state::expect_value_or_end:
+                    switch (*p)
+                    {
+                        case '{':
+                            begin_object(visitor, ec);
+                            if (ec) return;
+                            ++input_ptr_;
+                            break;
+                        case '[':
+                            begin_array(visitor, ec);
+                            if (ec) return;
+                            ++input_ptr_;
+                            break;
+                        case '\"':
+                            ++input_ptr_;
+                            state_ = json_parse_state::string;
+                            string_buffer_.clear();
+                            parse_indexed_string(visitor, ec);
+                            if (ec) return;
+                            break;
+                        case '-':case '0':case '1':case '2':case '3':case '4':case '5':case '6':case '7':case '8': case '9':
+                            parse_indexed_number(visitor, ec);
+                            if (ec) return;
+                            break;
+                        case 't':
+                            if (input_end_ - input_ptr_ >= 4)
+                            {
+                                parse_true(visitor, ec);
+                                if (ec) return;
+                            }
+                            else
+                            {
+                                parse_indexed_partial_literal("true", ec);
+                                return;
+                            }
+                            break;
+                        case 'f':
+                            if (input_end_ - input_ptr_ >= 5)
+                            {
+                                parse_false(visitor, ec);
+                                if (ec) return;
+                            }
+                            else
+                            {
+                                parse_indexed_partial_literal("false", ec);
+                                return;
+                            }
+                            break;
+                        case 'n':
+                            if (input_end_ - input_ptr_ >= 4)
+                            {
+                                parse_null(visitor, ec);
+                                if (ec) return;
+                            }
+                            else
+                            {
+                                parse_indexed_partial_literal("null", ec);
+                                return;
+                            }
+                            break;
+                        case ']':
+                            if (state_ == json_parse_state::expect_value_or_end)
+                            {
+                                end_array(visitor, ec);
+                                if (ec) return;
+                                ++input_ptr_;
+                            }
+                            else if (state_ == json_parse_state::start)
+                            {
+                                report_error(json_errc::unexpected_right_bracket, ec);
+                                return;
+                            }
+                            else
+                            {
+                                report_error(parent() == json_parse_state::array ? json_errc::extra_comma : json_errc::expected_value, ec);
+                                return;
+                            }
+                            break;
+                        JSONCONS_ILLEGAL_CONTROL_CHARACTER:
+                            report_error(json_errc::illegal_control_character, ec);
+                            return;
+                        case '}':
+                            report_error(state_ == json_parse_state::start ? json_errc::unexpected_right_brace : json_errc::expected_value, ec);
+                            return;
+                        case '\'':
+                            report_error(state_ == json_parse_state::start ? json_errc::syntax_error : json_errc::single_quote, ec);
+                            return;
+                        default:
+                            report_error(state_ == json_parse_state::start ? json_errc::syntax_error : json_errc::expected_value, ec);
+                            return;
+                    }
+                    break;
+                case json_parse_state::expect_comma_or_end:
+                    switch (*p)
+                    {
+                        case '}':
+                            end_object(visitor, ec);
+                            if (ec) return;
+                            ++input_ptr_;
+                            break;
+                        case ']':
+                            end_array(visitor, ec);
+                            if (ec) return;
+                            ++input_ptr_;
+                            break;
+                        case ',':
+                            begin_member_or_element(ec);
+                            if (ec) return;
+                            ++input_ptr_;
+                            break;
+                        JSONCONS_ILLEGAL_CONTROL_CHARACTER:
+                            report_error(json_errc::illegal_control_character, ec);
+                            return;
+                        default:
+                            report_error(parent() == json_parse_state::array ? json_errc::expected_comma_or_right_bracket : json_errc::expected_comma_or_right_brace, ec);
+                            return;
+                    }
+                    break;
+                case json_parse_state::expect_member_name_or_end:
+                case json_parse_state::expect_member_name:
+                    switch (*p)
+                    {
+                        case '\"':
+                            ++input_ptr_;
+                            push_state(json_parse_state::member_name);
+                            state_ = json_parse_state::string;
+                            string_buffer_.clear();
+                            parse_indexed_string(visitor, ec);
+                            if (ec) return;
+                            break;
+                        case '}':
+                            if (state_ == json_parse_state::expect_member_name)
+                            {
+                                report_error(json_errc::extra_comma, ec);
+                                return;
+                            }
+                            end_object(visitor, ec);
+                            if (ec) return;
+                            ++input_ptr_;
+                            break;
+                        JSONCONS_ILLEGAL_CONTROL_CHARACTER:
+                            report_error(json_errc::illegal_control_character, ec);
+                            return;
+                        case '\'':
+                            report_error(json_errc::single_quote, ec);
+                            return;
+                        default:
+                            report_error(json_errc::expected_key, ec);
+                            return;
+                    }
+                    break;
+                case json_parse_state::expect_colon:
+                    switch (*p)
+                    {
+                        case ':':
+                            state_ = json_parse_state::expect_value;
+                            ++input_ptr_;
+                            break;
+                        JSONCONS_ILLEGAL_CONTROL_CHARACTER:
+                            report_error(json_errc::illegal_control_character, ec);
+                            return;
+                        default:
+                            report_error(json_errc::expected_colon, ec);
+                            return;
+                    }
+                    break;
+                default:
+                    JSONCONS_UNREACHABLE();
+            }
+        }
+    }
+
+    void parse_indexed_string(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        // parse_string returns after some escapes, the input is complete so carry on
+        bool in_string = true;
+        while (in_string && input_ptr_ != input_end_)
+        {
+            parse_string(visitor, ec);
+            if (ec) return;
+            switch (state_)
+            {
+                case json_parse_state::string:
+                case json_parse_state::escape:
+                case json_parse_state::escape_u1:
+                case json_parse_state::escape_u2:
+                case json_parse_state::escape_u3:
+                case json_parse_state::escape_u4:
+                case json_parse_state::escape_expect_surrogate_pair1:
+                case json_parse_state::escape_expect_surrogate_pair2:
+                case json_parse_state::escape_u5:
+                case json_parse_state::escape_u6:
+                case json_parse_state::escape_u7:
+                case json_parse_state::escape_u8:
+                    break;
+                default:
+                    in_string = false;
+                    break;
+            }
+        }
+    }
+
+    // Reports the same errors at the same positions as parse_number
+    void parse_indexed_number(basic_json_visitor<CharT>& visitor, std::error_code& ec)
+    {
+        const CharT* local_input_end = input_end_;
+        const CharT* first = input_ptr_;
+        const CharT* p = first;
+        bool is_integer = true;
+        json_errc err = json_errc();
+
+        saved_position_ = current_position();
+        if (*p == '-')
+        {
+            ++p;
+            if (p == local_input_end)
+            {
+                err = json_errc::unexpected_eof;
+                goto error;
+            }
+            if (!is_digit(*p))
+            {
+                err = json_errc::expected_value;
+                goto error;
+            }
+        }
+        if (*p == '0')
+        {
+            ++p;
+            if (p != local_input_end && is_digit(*p))
+            {
+                err = json_errc::leading_zero;
+                goto error;
+            }
+        }
+        else
+        {
+            ++p;
+            while (p != local_input_end && is_digit(*p))
+            {
+                ++p;
+            }
+        }
+        if (p != local_input_end && *p == '.')
+        {
+            is_integer = false;
+            ++p;
+            if (p == local_input_end)
+            {
+                err = json_errc::unexpected_eof;
+                goto error;
+            }
+            if (!is_digit(*p))
+            {
+                err = json_errc::invalid_number;
+                goto error;
+            }
+            while (p != local_input_end && is_digit(*p))
+            {
+                ++p;
+            }
+        }
+        if (p != local_input_end && (*p == 'e' || *p == 'E'))
+        {
+            is_integer = false;
+            ++p;
+            if (p != local_input_end && (*p == '+' || *p == '-'))
+            {
+                ++p;
+            }
+            if (p == local_input_end)
+            {
+                err = json_errc::unexpected_eof;
+                goto error;
+            }
+            if (!is_digit(*p))
+            {
+                err = json_errc::expected_value;
+                goto error;
+            }
+            while (p != local_input_end && is_digit(*p))
+            {
+                ++p;
+            }
+        }
+        if (p != local_input_end)
+        {
+            switch (*p)
+            {
+                case ' ':case '\t':case '\n':case '\r':case ',':case ']':case '}':
+                    break;
+                default:
+                    err = json_errc::invalid_number;
+                    goto error;
+            }
+        }
+
+        input_ptr_ = p;
+        if (is_integer)
+        {
+            end_integer_value(first, p - first, visitor, ec);
+        }
+        else
+        {
+            end_fraction_value(first, p - first, visitor, ec);
+        }
+        return;
+
+    error:
+        input_ptr_ = p;
+        report_error(err, ec);
+    }
+
+    // A literal cut short by the end of the input
+    void parse_indexed_partial_literal(const char* literal, std::error_code& ec)
+    {
+        const CharT* p = input_ptr_;
+        for (++p, ++literal; p != input_end_; ++p, ++literal)
+        {
+            if (*p != *literal)
+            {
+                input_ptr_ = p;
+                report_error(json_errc::invalid_value, ec);
+                return;
+            }
+        }
+        input_ptr_ = p;
+        report_error(json_errc::unexpected_eof, ec);
+    }
+
+    void report_error(json_errc err, std::error_code& ec)
+    {
+        err_handler_(err, *this);
+        ec = err;
+        more_ = false;
+    }
+
+    static bool is_digit(CharT c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    static bool is_whitespace(CharT c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
     void push_state(json_parse_state state)
     {
         state_stack_.push_back(state);
@@ -2805,7 +3164,7 @@ private:
         }
         else
         {
-            more_ = err_handler_(json_errc::invalid_unicode_escape_sequence, *this);
+            more_ = recover(json_errc::invalid_unicode_escape_sequence);
             if (!more_)
             {
                 ec = json_errc::invalid_unicode_escape_sequence;
@@ -34,7 +34,7 @@ private:
     //std::function<bool(json_errc,const ser_context&)> err_handler_;
 
     // noncopyable and nonmoveable
-    json_utf8_to_other_visitor_adaptor<CharT>(const json_utf8_to_other_visitor_adaptor<CharT>&) = delete;
+    json_utf8_to_other_visitor_adaptor(const json_utf8_to_other_visitor_adaptor&) = delete;
     json_utf8_to_other_visitor_adaptor<CharT>& operator=(const json_utf8_to_other_visitor_adaptor<CharT>&) = delete;
 
 public:
@@ -147,7 +147,7 @@ private:
     }
 };
 
-template<class CharT,class Src=jsoncons::stream_source<CharT>,class Allocator=std::allocator<char>>
+template<class CharT,class Src=jsoncons::stream_source<CharT>,class Allocator=std::allocator<char>,class ParsePolicy=default_json_parse_policy>
 class basic_json_reader 
 {
 public:
@@ -164,7 +164,7 @@ private:
 
     basic_json_visitor<CharT>& visitor_;
 
-    basic_json_parser<CharT,Allocator> parser_;
+    basic_json_parser<CharT,Allocator,ParsePolicy> parser_;
 
     source_type source_;
     bool eof_;
@@ -359,7 +359,15 @@ public:
                     eof_ = true;
                 }
             }
-            parser_.parse_some(visitor_, ec);
+            if (source_.eof())
+            {
+                // The parser has the rest of the input
+                parser_.finish_parse(visitor_, ec);
+            }
+            else
+            {
+                parser_.parse_some(visitor_, ec);
+            }
             if (ec) return;
         }
         
@@ -481,6 +489,41 @@ public:
 private:
 
     void read_buffer(std::error_code& ec)
+    {
+        read_buffer(ec, std::integral_constant<bool,has_read_buffer<source_type>::value>());
+    }
+
+    void read_buffer(std::error_code& ec, std::true_type)
+    {
+        auto s = source_.read_buffer();
+        if (s.size() == 0)
+        {
+            if (source_.is_error())
+            {
+                ec = json_errc::source_error;
+                return;
+            }
+            eof_ = true;
+        }
+        else if (begin_)
+        {
+            auto result = unicons::skip_bom(s.begin(), s.end());
+            if (result.ec != unicons::encoding_errc())
+            {
+                ec = result.ec;
+                return;
+            }
+            std::size_t offset = result.it - s.begin();
+            parser_.update(s.data()+offset,s.size()-offset);
+            begin_ = false;
+        }
+        else
+        {
+            parser_.update(s.data(),s.size());
+        }
+    }
+
+    void read_buffer(std::error_code& ec, std::false_type)
     {
         buffer_.clear();
         buffer_.resize(buffer_length_);
@@ -488,6 +531,11 @@ private:
         buffer_.resize(static_cast<std::size_t>(count));
         if (buffer_.size() == 0)
         {
+            if (source_.is_error())
+            {
+                ec = json_errc::source_error;
+                return;
+            }
             eof_ = true;
         }
         else if (begin_)
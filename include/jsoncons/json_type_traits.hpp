@@ -20,6 +20,7 @@
 #include <type_traits> // std::enable_if
 #include <iterator> // std::iterator_traits, std::input_iterator_tag
 #include <jsoncons/json_type.hpp>
+#include <jsoncons/json_container_types.hpp>
 #include <jsoncons/bigint.hpp>
 #include <jsoncons/json_visitor.hpp>
 #include <jsoncons/detail/more_type_traits.hpp>
@@ -462,6 +463,94 @@ namespace detail {
         }
     };
 
+    namespace detail {
+
+        // Read the numbers of a packed array without converting it to generic elements
+
+        template <class Json,class T,class N>
+        bool packed_numbers_are(const jsoncons::span<const N>& data) noexcept
+        {
+            for (auto value : data)
+            {
+                if (!Json(value, semantic_tag::none).template is<T>())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <class Json,class T>
+        bool packed_array_is(const typename Json::array& a) noexcept
+        {
+            switch (a.packing())
+            {
+                case packed_kind::float32_value:
+                    return packed_numbers_are<Json,T>(a.template packed_data<float>());
+                case packed_kind::float64_value:
+                    return packed_numbers_are<Json,T>(a.template packed_data<double>());
+                case packed_kind::int64_value:
+                    return packed_numbers_are<Json,T>(a.template packed_data<int64_t>());
+                case packed_kind::uint64_value:
+                    return packed_numbers_are<Json,T>(a.template packed_data<uint64_t>());
+                default:
+                    return false;
+            }
+        }
+
+        template <class Json,class Container,class N>
+        void append_packed_numbers(Container& result, const jsoncons::span<const N>& data, std::true_type)
+        {
+            using value_type = typename Container::value_type;
+            for (auto value : data)
+            {
+                result.push_back(static_cast<value_type>(value));
+            }
+        }
+
+        template <class Json,class T,class A>
+        void append_packed_numbers(std::vector<T,A>& result, const jsoncons::span<const T>& data, std::true_type)
+        {
+            result.insert(result.end(), data.begin(), data.end());
+        }
+
+        template <class Json,class Container,class N>
+        void append_packed_numbers(Container& result, const jsoncons::span<const N>& data, std::false_type)
+        {
+            using value_type = typename Container::value_type;
+            for (auto value : data)
+            {
+                result.push_back(Json(value, semantic_tag::none).template as<value_type>());
+            }
+        }
+
+        template <class Json,class Container>
+        void append_packed_array(Container& result, const typename Json::array& a)
+        {
+            using value_type = typename Container::value_type;
+            using is_number = std::integral_constant<bool,std::is_arithmetic<value_type>::value && !std::is_same<value_type,bool>::value>;
+
+            switch (a.packing())
+            {
+                case packed_kind::float32_value:
+                    append_packed_numbers<Json>(result, a.template packed_data<float>(), is_number());
+                    break;
+                case packed_kind::float64_value:
+                    append_packed_numbers<Json>(result, a.template packed_data<double>(), is_number());
+                    break;
+                case packed_kind::int64_value:
+                    append_packed_numbers<Json>(result, a.template packed_data<int64_t>(), is_number());
+                    break;
+                case packed_kind::uint64_value:
+                    append_packed_numbers<Json>(result, a.template packed_data<uint64_t>(), is_number());
+                    break;
+                default:
+                    break;
+            }
+        }
+
+    } // namespace detail
+
     // array back insertable
 
     template<class Json, typename T>
@@ -477,7 +566,11 @@ namespace detail {
         static bool is(const Json& j) noexcept
         {
             bool result = j.is_array();
-            if (result)
+            if (result && j.array_value().is_packed())
+            {
+                result = jsoncons::detail::packed_array_is<Json,value_type>(j.array_value());
+            }
+            else if (result)
             {
                 for (auto e : j.array_range())
                 {
@@ -501,6 +594,11 @@ namespace detail {
             {
                 T result;
                 visit_reserve_(typename std::integral_constant<bool, jsoncons::detail::has_reserve<T>::value>::type(),result,j.size());
+                if (j.array_value().is_packed())
+                {
+                    jsoncons::detail::append_packed_array<Json>(result, j.array_value());
+                    return result;
+                }
                 for (const auto& item : j.array_range())
                 {
                     result.push_back(item.template as<value_type>());
@@ -0,0 +1,994 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_LAZY_JSON_HPP
+#define JSONCONS_LAZY_JSON_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits> // std::numeric_limits
+#include <memory> // std::allocator
+#include <string>
+#include <vector>
+#include <iterator>
+#include <istream> // std::basic_istream
+#include <system_error>
+#include <type_traits> // std::enable_if
+#include <utility> // std::move
+#include <jsoncons/json_type.hpp>
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/json_visitor.hpp>
+#include <jsoncons/json_options.hpp>
+#include <jsoncons/json_parser.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_decoder.hpp>
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/unicode_traits.hpp>
+#include <jsoncons/detail/more_type_traits.hpp>
+
+namespace jsoncons {
+
+namespace detail {
+
+    // One entry of a tape. Containers are followed by their contents, an object's
+    // contents alternate between key and value entries.
+    struct tape_entry
+    {
+        json_type type;
+        semantic_tag tag;
+        // Characters of a string, bytes of a byte string, elements of an array, members of an object
+        std::size_t length;
+        union
+        {
+            int64_t int64_value;
+            uint64_t uint64_value;
+            double double_value;
+            bool bool_value;
+            uint16_t half_value;
+            // Where a string or byte string starts in the document's character or byte buffer
+            std::size_t offset;
+            // Of an array or object, the index of the entry that follows its contents
+            std::size_t next;
+        };
+
+        tape_entry(json_type type, semantic_tag tag)
+            : type(type), tag(tag), length(0), uint64_value(0)
+        {
+        }
+    };
+
+    // Records the events of one JSON value on a tape
+
+    template <class CharT,class Allocator>
+    class tape_builder : public basic_json_visitor<CharT>
+    {
+    public:
+        using typename basic_json_visitor<CharT>::string_view_type;
+
+        using entry_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<tape_entry>;
+        using char_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<CharT>;
+        using byte_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<uint8_t>;
+        using size_t_allocator_type = typename std::allocator_traits<Allocator>:: template rebind_alloc<std::size_t>;
+
+        std::vector<tape_entry,entry_allocator_type> entries;
+        std::vector<CharT,char_allocator_type> chars;
+        std::vector<uint8_t,byte_allocator_type> bytes;
+    private:
+        // Indices of the open containers
+        std::vector<std::size_t,size_t_allocator_type> stack_;
+        bool is_valid_;
+    public:
+        tape_builder(const Allocator& alloc)
+            : entries(alloc), chars(alloc), bytes(alloc), stack_(alloc), is_valid_(false)
+        {
+        }
+
+        bool is_valid() const
+        {
+            return is_valid_;
+        }
+
+    private:
+        void begin_value()
+        {
+            if (stack_.empty())
+            {
+                entries.clear();
+                chars.clear();
+                bytes.clear();
+                is_valid_ = false;
+            }
+            else if (entries[stack_.back()].type == json_type::array_value)
+            {
+                ++entries[stack_.back()].length;
+            }
+        }
+
+        bool end_value()
+        {
+            if (stack_.empty())
+            {
+                is_valid_ = true;
+                return false;
+            }
+            return true;
+        }
+
+        std::size_t add_chars(const string_view_type& sv)
+        {
+            std::size_t offset = chars.size();
+            chars.insert(chars.end(), sv.begin(), sv.end());
+            return offset;
+        }
+
+        void visit_flush() override
+        {
+        }
+
+        bool visit_begin_object(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            stack_.push_back(entries.size());
+            entries.emplace_back(json_type::object_value, tag);
+            return true;
+        }
+
+        bool visit_end_object(const ser_context&, std::error_code&) override
+        {
+            JSONCONS_ASSERT(!stack_.empty());
+            entries[stack_.back()].next = entries.size();
+            stack_.pop_back();
+            return end_value();
+        }
+
+        bool visit_begin_array(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            stack_.push_back(entries.size());
+            entries.emplace_back(json_type::array_value, tag);
+            return true;
+        }
+
+        bool visit_end_array(const ser_context&, std::error_code&) override
+        {
+            JSONCONS_ASSERT(!stack_.empty());
+            entries[stack_.back()].next = entries.size();
+            stack_.pop_back();
+            return end_value();
+        }
+
+        bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            ++entries[stack_.back()].length;
+            entries.emplace_back(json_type::string_value, semantic_tag::none);
+            entries.back().length = name.length();
+            entries.back().offset = add_chars(name);
+            return true;
+        }
+
+        bool visit_string(const string_view_type& sv, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            entries.emplace_back(json_type::string_value, tag);
+            entries.back().length = sv.length();
+            entries.back().offset = add_chars(sv);
+            return end_value();
+        }
+
+        bool visit_byte_string(const byte_string_view& b,
+                               semantic_tag tag,
+                               const ser_context&,
+                               std::error_code&) override
+        {
+            begin_value();
+            entries.emplace_back(json_type::byte_string_value, tag);
+            entries.back().length = b.size();
+            entries.back().offset = bytes.size();
+            bytes.insert(bytes.end(), b.begin(), b.end());
+            return end_value();
+        }
+
+        bool visit_int64(int64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            entries.emplace_back(json_type::int64_value, tag);
+            entries.back().int64_value = value;
+            return end_value();
+        }
+
+        bool visit_uint64(uint64_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            entries.emplace_back(json_type::uint64_value, tag);
+            entries.back().uint64_value = value;
+            return end_value();
+        }
+
+        bool visit_half(uint16_t value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            entries.emplace_back(json_type::half_value, tag);
+            entries.back().half_value = value;
+            return end_value();
+        }
+
+        bool visit_double(double value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            entries.emplace_back(json_type::double_value, tag);
+            entries.back().double_value = value;
+            return end_value();
+        }
+
+        bool visit_bool(bool value, semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            entries.emplace_back(json_type::bool_value, tag);
+            entries.back().bool_value = value;
+            return end_value();
+        }
+
+        bool visit_null(semantic_tag tag, const ser_context&, std::error_code&) override
+        {
+            begin_value();
+            entries.emplace_back(json_type::null_value, tag);
+            return end_value();
+        }
+    };
+
+} // namespace detail
+
+template <class CharT>
+class basic_lazy_member;
+
+// A value on the tape of a basic_lazy_document, valid as long as the document
+
+template <class CharT>
+class basic_lazy_value
+{
+public:
+    using char_type = CharT;
+    using string_view_type = basic_string_view<CharT>;
+    using member_type = basic_lazy_member<CharT>;
+
+    class const_array_iterator
+    {
+        const detail::tape_entry* entries_;
+        const CharT* chars_;
+        const uint8_t* bytes_;
+        std::size_t index_;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = basic_lazy_value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const basic_lazy_value*;
+        using reference = basic_lazy_value;
+
+        const_array_iterator()
+            : entries_(nullptr), chars_(nullptr), bytes_(nullptr), index_(0)
+        {
+        }
+
+        const_array_iterator(const detail::tape_entry* entries, const CharT* chars, const uint8_t* bytes, std::size_t index)
+            : entries_(entries), chars_(chars), bytes_(bytes), index_(index)
+        {
+        }
+
+        basic_lazy_value operator*() const
+        {
+            return basic_lazy_value(entries_, chars_, bytes_, index_);
+        }
+
+        const_array_iterator& operator++()
+        {
+            index_ = next_index(entries_, index_);
+            return *this;
+        }
+
+        const_array_iterator operator++(int)
+        {
+            const_array_iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        friend bool operator==(const const_array_iterator& lhs, const const_array_iterator& rhs)
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const const_array_iterator& lhs, const const_array_iterator& rhs)
+        {
+            return lhs.index_ != rhs.index_;
+        }
+    };
+
+    class const_object_iterator
+    {
+        const detail::tape_entry* entries_;
+        const CharT* chars_;
+        const uint8_t* bytes_;
+        std::size_t index_;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = member_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const member_type*;
+        using reference = member_type;
+
+        const_object_iterator()
+            : entries_(nullptr), chars_(nullptr), bytes_(nullptr), index_(0)
+        {
+        }
+
+        const_object_iterator(const detail::tape_entry* entries, const CharT* chars, const uint8_t* bytes, std::size_t index)
+            : entries_(entries), chars_(chars), bytes_(bytes), index_(index)
+        {
+        }
+
+        member_type operator*() const
+        {
+            return member_type(basic_lazy_value(entries_, chars_, bytes_, index_),
+                               basic_lazy_value(entries_, chars_, bytes_, index_ + 1));
+        }
+
+        const_object_iterator& operator++()
+        {
+            index_ = next_index(entries_, index_ + 1);
+            return *this;
+        }
+
+        const_object_iterator operator++(int)
+        {
+            const_object_iterator temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        friend bool operator==(const const_object_iterator& lhs, const const_object_iterator& rhs)
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const const_object_iterator& lhs, const const_object_iterator& rhs)
+        {
+            return lhs.index_ != rhs.index_;
+        }
+    };
+
+    template <class IteratorT>
+    class range
+    {
+        IteratorT first_;
+        IteratorT last_;
+    public:
+        range(const IteratorT& first, const IteratorT& last)
+            : first_(first), last_(last)
+        {
+        }
+
+        IteratorT begin() const
+        {
+            return first_;
+        }
+        IteratorT end() const
+        {
+            return last_;
+        }
+    };
+
+private:
+    const detail::tape_entry* entries_;
+    const CharT* chars_;
+    const uint8_t* bytes_;
+    std::size_t index_;
+
+    const detail::tape_entry& entry() const
+    {
+        return entries_[index_];
+    }
+
+    basic_lazy_value value_at(std::size_t index) const
+    {
+        return basic_lazy_value(entries_, chars_, bytes_, index);
+    }
+
+    // Skips the value at index
+    static std::size_t next_index(const detail::tape_entry* entries, std::size_t index)
+    {
+        const detail::tape_entry& e = entries[index];
+        return e.type == json_type::object_value || e.type == json_type::array_value ? e.next : index + 1;
+    }
+
+    string_view_type key_at(std::size_t index) const
+    {
+        return string_view_type(chars_ + entries_[index].offset, entries_[index].length);
+    }
+public:
+    basic_lazy_value(const detail::tape_entry* entries, const CharT* chars, const uint8_t* bytes, std::size_t index)
+        : entries_(entries), chars_(chars), bytes_(bytes), index_(index)
+    {
+    }
+
+    json_type type() const
+    {
+        return entry().type;
+    }
+
+    semantic_tag tag() const
+    {
+        return entry().tag;
+    }
+
+    bool is_null() const noexcept
+    {
+        return entry().type == json_type::null_value;
+    }
+
+    bool is_bool() const noexcept
+    {
+        return entry().type == json_type::bool_value;
+    }
+
+    bool is_int64() const noexcept
+    {
+        switch (entry().type)
+        {
+            case json_type::int64_value:
+                return true;
+            case json_type::uint64_value:
+                return entry().uint64_value <= static_cast<uint64_t>((std::numeric_limits<int64_t>::max)());
+            default:
+                return false;
+        }
+    }
+
+    bool is_uint64() const noexcept
+    {
+        switch (entry().type)
+        {
+            case json_type::uint64_value:
+                return true;
+            case json_type::int64_value:
+                return entry().int64_value >= 0;
+            default:
+                return false;
+        }
+    }
+
+    bool is_half() const noexcept
+    {
+        return entry().type == json_type::half_value;
+    }
+
+    bool is_double() const noexcept
+    {
+        return entry().type == json_type::double_value;
+    }
+
+    bool is_number() const noexcept
+    {
+        switch (entry().type)
+        {
+            case json_type::int64_value:
+            case json_type::uint64_value:
+            case json_type::half_value:
+            case json_type::double_value:
+                return true;
+            case json_type::string_value:
+                return entry().tag == semantic_tag::bigint ||
+                       entry().tag == semantic_tag::bigdec ||
+                       entry().tag == semantic_tag::bigfloat;
+            default:
+                return false;
+        }
+    }
+
+    bool is_string() const noexcept
+    {
+        return entry().type == json_type::string_value;
+    }
+
+    bool is_byte_string() const noexcept
+    {
+        return entry().type == json_type::byte_string_value;
+    }
+
+    bool is_object() const noexcept
+    {
+        return entry().type == json_type::object_value;
+    }
+
+    bool is_array() const noexcept
+    {
+        return entry().type == json_type::array_value;
+    }
+
+    std::size_t size() const noexcept
+    {
+        switch (entry().type)
+        {
+            case json_type::object_value:
+            case json_type::array_value:
+                return entry().length;
+            default:
+                return 0;
+        }
+    }
+
+    bool empty() const noexcept
+    {
+        switch (entry().type)
+        {
+            case json_type::string_value:
+            case json_type::byte_string_value:
+            case json_type::object_value:
+            case json_type::array_value:
+                return entry().length == 0;
+            default:
+                return false;
+        }
+    }
+
+    bool contains(const string_view_type& key) const noexcept
+    {
+        return find_member(key) != 0;
+    }
+
+    basic_lazy_value at(const string_view_type& key) const
+    {
+        if (!is_object())
+        {
+            JSONCONS_THROW(not_an_object(key.data(),key.length()));
+        }
+        std::size_t index = find_member(key);
+        if (index == 0)
+        {
+            JSONCONS_THROW(key_not_found(key.data(),key.length()));
+        }
+        return value_at(index);
+    }
+
+    basic_lazy_value operator[](const string_view_type& key) const
+    {
+        return at(key);
+    }
+
+    basic_lazy_value at(std::size_t i) const
+    {
+        switch (entry().type)
+        {
+            case json_type::array_value:
+            case json_type::object_value:
+            {
+                if (i >= entry().length)
+                {
+                    JSONCONS_THROW(json_runtime_error<std::out_of_range>("Invalid array subscript"));
+                }
+                // An object's i'th value, as with basic_json
+                bool is_object = entry().type == json_type::object_value;
+                std::size_t index = index_ + 1;
+                for (std::size_t n = 0; n < i; ++n)
+                {
+                    index = next_index(entries_, is_object ? index + 1 : index);
+                }
+                return value_at(is_object ? index + 1 : index);
+            }
+            default:
+                JSONCONS_THROW(json_runtime_error<std::domain_error>("Index on non-array value not supported"));
+        }
+    }
+
+    basic_lazy_value operator[](std::size_t i) const
+    {
+        return at(i);
+    }
+
+    range<const_object_iterator> object_range() const
+    {
+        if (!is_object())
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an object"));
+        }
+        return range<const_object_iterator>(const_object_iterator(entries_, chars_, bytes_, index_ + 1),
+                                            const_object_iterator(entries_, chars_, bytes_, entry().next));
+    }
+
+    range<const_array_iterator> array_range() const
+    {
+        if (!is_array())
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not an array"));
+        }
+        return range<const_array_iterator>(const_array_iterator(entries_, chars_, bytes_, index_ + 1),
+                                           const_array_iterator(entries_, chars_, bytes_, entry().next));
+    }
+
+    string_view_type as_string_view() const
+    {
+        if (!is_string())
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a string"));
+        }
+        return string_view_type(chars_ + entry().offset, entry().length);
+    }
+
+    byte_string_view as_byte_string_view() const
+    {
+        if (!is_byte_string())
+        {
+            JSONCONS_THROW(json_runtime_error<std::domain_error>("Not a byte string"));
+        }
+        return byte_string_view(bytes_ + entry().offset, entry().length);
+    }
+
+    // Scalars and strings are read from the tape, other types are converted
+    // by way of basic_json, so the conversions are those of basic_json
+
+    template <class T>
+    typename std::enable_if<is_basic_json<T>::value,T>::type
+    as() const
+    {
+        json_decoder<T> decoder;
+        dump(decoder);
+        return decoder.get_result();
+    }
+
+    template <class T>
+    typename std::enable_if<!is_basic_json<T>::value,T>::type
+    as() const
+    {
+        T val;
+        if (try_as(val))
+        {
+            return val;
+        }
+        return as<basic_json<CharT>>().template as<T>();
+    }
+
+    void dump(basic_json_visitor<CharT>& visitor) const
+    {
+        std::error_code ec;
+        dump(visitor, ec);
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec));
+        }
+    }
+
+    void dump(basic_json_visitor<CharT>& visitor, std::error_code& ec) const
+    {
+        std::size_t index = index_;
+        dump_noflush(index, visitor, ec);
+        visitor.flush();
+    }
+
+private:
+    // Returns the index of the member's value, or 0
+    std::size_t find_member(const string_view_type& key) const noexcept
+    {
+        if (!is_object())
+        {
+            return 0;
+        }
+        std::size_t last = entry().next;
+        for (std::size_t index = index_ + 1; index < last; index = next_index(entries_, index + 1))
+        {
+            if (key_at(index) == key)
+            {
+                return index + 1;
+            }
+        }
+        return 0;
+    }
+
+    bool try_as(bool& val) const
+    {
+        if (!is_bool())
+        {
+            return false;
+        }
+        val = entry().bool_value;
+        return true;
+    }
+
+    template <class T>
+    typename std::enable_if<jsoncons::detail::is_integer<T>::value || std::is_floating_point<T>::value,bool>::type
+    try_as(T& val) const
+    {
+        switch (entry().type)
+        {
+            case json_type::int64_value:
+                val = static_cast<T>(entry().int64_value);
+                return true;
+            case json_type::uint64_value:
+                val = static_cast<T>(entry().uint64_value);
+                return true;
+            case json_type::double_value:
+                val = static_cast<T>(entry().double_value);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    template <class T>
+    typename std::enable_if<jsoncons::detail::is_basic_string<T>::value &&
+                            std::is_same<typename T::value_type,CharT>::value,bool>::type
+    try_as(T& val) const
+    {
+        if (!is_string() || entry().tag != semantic_tag::none)
+        {
+            return false;
+        }
+        val = T(chars_ + entry().offset, entry().length);
+        return true;
+    }
+
+    template <class T>
+    typename std::enable_if<jsoncons::detail::is_basic_string_view<T>::value &&
+                            std::is_same<typename T::value_type,CharT>::value,bool>::type
+    try_as(T& val) const
+    {
+        // A view of a converted value would outlive it
+        string_view_type sv = as_string_view();
+        val = T(sv.data(), sv.length());
+        return true;
+    }
+
+    template <class T>
+    typename std::enable_if<!std::is_same<T,bool>::value &&
+                            !jsoncons::detail::is_integer<T>::value &&
+                            !std::is_floating_point<T>::value &&
+                            !(jsoncons::detail::is_string_or_string_view<T>::value &&
+                              std::is_same<typename T::value_type,CharT>::value),bool>::type
+    try_as(T&) const
+    {
+        return false;
+    }
+
+    // Visits the value at index and advances index past it. Returns false if the
+    // visitor asked to stop or set ec
+    bool dump_noflush(std::size_t& index, basic_json_visitor<CharT>& visitor, std::error_code& ec) const
+    {
+        const ser_context context{};
+        const detail::tape_entry& e = entries_[index];
+        bool more = true;
+        switch (e.type)
+        {
+            case json_type::string_value:
+                more = visitor.string_value(string_view_type(chars_ + e.offset, e.length), e.tag, context, ec);
+                break;
+            case json_type::byte_string_value:
+                more = visitor.byte_string_value(byte_string_view(bytes_ + e.offset, e.length), e.tag, context, ec);
+                break;
+            case json_type::half_value:
+                more = visitor.half_value(e.half_value, e.tag, context, ec);
+                break;
+            case json_type::double_value:
+                more = visitor.double_value(e.double_value, e.tag, context, ec);
+                break;
+            case json_type::int64_value:
+                more = visitor.int64_value(e.int64_value, e.tag, context, ec);
+                break;
+            case json_type::uint64_value:
+                more = visitor.uint64_value(e.uint64_value, e.tag, context, ec);
+                break;
+            case json_type::bool_value:
+                more = visitor.bool_value(e.bool_value, e.tag, context, ec);
+                break;
+            case json_type::null_value:
+                more = visitor.null_value(e.tag, context, ec);
+                break;
+            case json_type::object_value:
+            {
+                more = visitor.begin_object(e.length, e.tag, context, ec);
+                std::size_t i = index + 1;
+                while (more && !ec && i < e.next)
+                {
+                    more = visitor.key(key_at(i), context, ec);
+                    if (!more || ec)
+                    {
+                        return false;
+                    }
+                    ++i;
+                    more = dump_noflush(i, visitor, ec);
+                }
+                if (!more || ec)
+                {
+                    return false;
+                }
+                more = visitor.end_object(context, ec);
+                index = e.next;
+                return more && !ec;
+            }
+            case json_type::array_value:
+            {
+                more = visitor.begin_array(e.length, e.tag, context, ec);
+                std::size_t i = index + 1;
+                while (more && !ec && i < e.next)
+                {
+                    more = dump_noflush(i, visitor, ec);
+                }
+                if (!more || ec)
+                {
+                    return false;
+                }
+                more = visitor.end_array(context, ec);
+                index = e.next;
+                return more && !ec;
+            }
+        }
+        ++index;
+        return more && !ec;
+    }
+};
+
+template <class CharT>
+class basic_lazy_member
+{
+    basic_lazy_value<CharT> key_;
+    basic_lazy_value<CharT> value_;
+public:
+    using string_view_type = basic_string_view<CharT>;
+
+    basic_lazy_member(const basic_lazy_value<CharT>& key, const basic_lazy_value<CharT>& value)
+        : key_(key), value_(value)
+    {
+    }
+
+    string_view_type key() const
+    {
+        return key_.as_string_view();
+    }
+
+    const basic_lazy_value<CharT>& value() const
+    {
+        return value_;
+    }
+};
+
+// basic_lazy_document validates a JSON text and records it on a tape, an array of
+// entries with one entry per value or key. Values are materialized only when read.
+
+template <class CharT,class Allocator=std::allocator<char>>
+class basic_lazy_document
+{
+public:
+    using char_type = CharT;
+    using allocator_type = Allocator;
+    using string_view_type = basic_string_view<CharT>;
+    using value_type = basic_lazy_value<CharT>;
+private:
+    detail::tape_builder<CharT,Allocator> tape_;
+public:
+    basic_lazy_document(const Allocator& alloc = Allocator())
+        : tape_(alloc)
+    {
+        tape_.entries.emplace_back(json_type::null_value, semantic_tag::none);
+    }
+
+    basic_lazy_document(basic_lazy_document&&) = default;
+    basic_lazy_document& operator=(basic_lazy_document&&) = default;
+
+    template <class Source>
+    static
+    typename std::enable_if<jsoncons::detail::is_sequence_of<Source,char_type>::value,basic_lazy_document>::type
+    parse(const Source& s,
+          const basic_json_decode_options<char_type>& options = basic_json_decode_options<CharT>(),
+          std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(),
+          const Allocator& alloc = Allocator())
+    {
+        basic_lazy_document doc(alloc);
+        basic_json_parser<char_type,Allocator> parser(options,err_handler,alloc);
+
+        auto result = unicons::skip_bom(s.begin(), s.end());
+        if (result.ec != unicons::encoding_errc())
+        {
+            JSONCONS_THROW(ser_error(result.ec));
+        }
+        std::size_t offset = result.it - s.begin();
+        parser.update(s.data()+offset,s.size()-offset);
+        parser.finish_parse(doc.tape_);
+        parser.check_done();
+        if (!doc.tape_.is_valid())
+        {
+            JSONCONS_THROW(json_runtime_error<std::runtime_error>("Failed to parse json string"));
+        }
+        return doc;
+    }
+
+    static basic_lazy_document parse(const char_type* s,
+                                     const basic_json_decode_options<char_type>& options = basic_json_decode_options<char_type>(),
+                                     std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing())
+    {
+        return parse(basic_string_view<char_type>(s), options, err_handler);
+    }
+
+    static basic_lazy_document parse(std::basic_istream<char_type>& is,
+                                     const basic_json_decode_options<char_type>& options = basic_json_decode_options<CharT>(),
+                                     std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing(),
+                                     const Allocator& alloc = Allocator())
+    {
+        basic_lazy_document doc(alloc);
+        basic_json_reader<char_type,stream_source<char_type>,Allocator> reader(is, doc.tape_, options, err_handler, alloc);
+        reader.read_next();
+        reader.check_done();
+        if (!doc.tape_.is_valid())
+        {
+            JSONCONS_THROW(json_runtime_error<std::runtime_error>("Failed to parse json stream"));
+        }
+        return doc;
+    }
+
+    // Records the events of one value, e.g. a basic_json_reader or cbor_stream_reader
+    // can write to this visitor
+    basic_json_visitor<CharT>& visitor()
+    {
+        return tape_;
+    }
+
+    value_type root() const
+    {
+        return value_type(tape_.entries.data(), tape_.chars.data(), tape_.bytes.data(), 0);
+    }
+
+    json_type type() const
+    {
+        return root().type();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return root().size();
+    }
+
+    bool contains(const string_view_type& key) const noexcept
+    {
+        return root().contains(key);
+    }
+
+    value_type at(const string_view_type& key) const
+    {
+        return root().at(key);
+    }
+
+    value_type operator[](const string_view_type& key) const
+    {
+        return root().at(key);
+    }
+
+    value_type at(std::size_t i) const
+    {
+        return root().at(i);
+    }
+
+    value_type operator[](std::size_t i) const
+    {
+        return root().at(i);
+    }
+
+    template <class T>
+    T as() const
+    {
+        return root().template as<T>();
+    }
+
+    // The number of entries on the tape
+    std::size_t tape_size() const
+    {
+        return tape_.entries.size();
+    }
+};
+
+using lazy_document = basic_lazy_document<char>;
+using wlazy_document = basic_lazy_document<wchar_t>;
+using lazy_value = basic_lazy_value<char>;
+using wlazy_value = basic_lazy_value<wchar_t>;
+
+}
+
+#endif
@@ -0,0 +1,426 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_MMAP_SOURCE_HPP
+#define JSONCONS_MMAP_SOURCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <string>
+#include <utility> // std::swap
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/source.hpp>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace jsoncons {
+
+namespace detail {
+
+    // A read only view of a whole file, unmapped on destruction
+
+    class mapped_file
+    {
+        const uint8_t* data_;
+        std::size_t size_;
+        bool is_error_;
+
+        // Noncopyable
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+    public:
+        mapped_file()
+            : data_(nullptr), size_(0), is_error_(false)
+        {
+        }
+
+        explicit mapped_file(const std::string& filename)
+            : data_(nullptr), size_(0), is_error_(false)
+        {
+            map(filename);
+        }
+
+        mapped_file(mapped_file&& other) noexcept
+            : data_(nullptr), size_(0), is_error_(false)
+        {
+            swap(other);
+        }
+
+        mapped_file& operator=(mapped_file&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        ~mapped_file() noexcept
+        {
+            unmap();
+        }
+
+        const uint8_t* data() const
+        {
+            return data_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        bool is_error() const
+        {
+            return is_error_;
+        }
+
+        void swap(mapped_file& other) noexcept
+        {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(is_error_, other.is_error_);
+        }
+
+    private:
+#if defined(_WIN32)
+        void map(const std::string& filename)
+        {
+            HANDLE file = ::CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                is_error_ = true;
+                return;
+            }
+            LARGE_INTEGER size;
+            if (!::GetFileSizeEx(file, &size))
+            {
+                ::CloseHandle(file);
+                is_error_ = true;
+                return;
+            }
+            if (size.QuadPart == 0)
+            {
+                ::CloseHandle(file); // an empty file cannot be mapped, and need not be
+                return;
+            }
+            HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            ::CloseHandle(file);
+            if (mapping == nullptr)
+            {
+                is_error_ = true;
+                return;
+            }
+            void* p = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            ::CloseHandle(mapping); // the view keeps the mapping open
+            if (p == nullptr)
+            {
+                is_error_ = true;
+                return;
+            }
+            data_ = static_cast<const uint8_t*>(p);
+            size_ = static_cast<std::size_t>(size.QuadPart);
+        }
+
+        void unmap()
+        {
+            if (data_ != nullptr)
+            {
+                ::UnmapViewOfFile(data_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+#else
+        void map(const std::string& filename)
+        {
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd == -1)
+            {
+                is_error_ = true;
+                return;
+            }
+            struct stat st;
+            if (::fstat(fd, &st) == -1)
+            {
+                ::close(fd);
+                is_error_ = true;
+                return;
+            }
+            if (st.st_size == 0)
+            {
+                ::close(fd); // an empty file cannot be mapped, and need not be
+                return;
+            }
+            std::size_t size = static_cast<std::size_t>(st.st_size);
+            void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd); // the mapping keeps the file open
+            if (p == MAP_FAILED)
+            {
+                is_error_ = true;
+                return;
+            }
+    #if defined(MADV_SEQUENTIAL)
+            ::madvise(p, size, MADV_SEQUENTIAL); // only a hint, failure is harmless
+    #endif
+            data_ = static_cast<const uint8_t*>(p);
+            size_ = size;
+        }
+
+        void unmap()
+        {
+            if (data_ != nullptr)
+            {
+                ::munmap(const_cast<uint8_t*>(data_), size_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+#endif
+    };
+
+} // namespace detail
+
+    // mmap_source reads a file mapped into memory. If the file cannot be opened
+    // or mapped, is_error() returns true and there is no input.
+
+    template <class CharT>
+    class mmap_source
+    {
+    public:
+        using value_type = CharT;
+        using string_view_type = basic_string_view<value_type>;
+    private:
+        detail::mapped_file file_;
+        const value_type* data_;
+        const value_type* current_;
+        const value_type* end_;
+
+        // Noncopyable
+        mmap_source(const mmap_source&) = delete;
+        mmap_source& operator=(const mmap_source&) = delete;
+    public:
+        mmap_source()
+            : data_(nullptr), current_(nullptr), end_(nullptr)
+        {
+        }
+
+        explicit mmap_source(const std::string& filename)
+            : file_(filename),
+              data_(reinterpret_cast<const value_type*>(file_.data())),
+              current_(data_),
+              end_(data_ + file_.size()/sizeof(value_type))
+        {
+        }
+
+        mmap_source(mmap_source&& val)
+            : data_(nullptr), current_(nullptr), end_(nullptr)
+        {
+            file_.swap(val.file_);
+            std::swap(data_,val.data_);
+            std::swap(current_,val.current_);
+            std::swap(end_,val.end_);
+        }
+
+        mmap_source& operator=(mmap_source&& val)
+        {
+            file_.swap(val.file_);
+            std::swap(data_,val.data_);
+            std::swap(current_,val.current_);
+            std::swap(end_,val.end_);
+            return *this;
+        }
+
+        bool eof() const
+        {
+            return current_ == end_;
+        }
+
+        bool is_error() const
+        {
+            return file_.is_error();
+        }
+
+        std::size_t position() const
+        {
+            return (current_ - data_) + 1;
+        }
+
+        character_result<value_type> get_character()
+        {
+            if (current_ < end_)
+            {
+                return character_result<value_type>(*current_++);
+            }
+            else
+            {
+                return character_result<value_type>();
+            }
+        }
+
+        void ignore(std::size_t count)
+        {
+            std::size_t len;
+            if ((std::size_t)(end_ - current_) < count)
+            {
+                len = end_ - current_;
+            }
+            else
+            {
+                len = count;
+            }
+            current_ += len;
+        }
+
+        character_result<value_type> peek_character()
+        {
+            return current_ < end_ ? character_result<value_type>(*current_) : character_result<value_type>();
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t len;
+            if ((std::size_t)(end_ - current_) < length)
+            {
+                len = end_ - current_;
+            }
+            else
+            {
+                len = length;
+            }
+            std::memcpy(p, current_, len*sizeof(value_type));
+            current_  += len;
+            return len;
+        }
+
+        span<const value_type> read_buffer()
+        {
+            span<const value_type> s(current_, end_ - current_);
+            current_ = end_;
+            return s;
+        }
+    };
+
+    class binary_mmap_source
+    {
+    public:
+        typedef uint8_t value_type;
+    private:
+        detail::mapped_file file_;
+        const value_type* current_;
+        const value_type* end_;
+
+        // Noncopyable
+        binary_mmap_source(const binary_mmap_source&) = delete;
+        binary_mmap_source& operator=(const binary_mmap_source&) = delete;
+    public:
+        binary_mmap_source()
+            : current_(nullptr), end_(nullptr)
+        {
+        }
+
+        explicit binary_mmap_source(const std::string& filename)
+            : file_(filename),
+              current_(file_.data()),
+              end_(file_.data() + file_.size())
+        {
+        }
+
+        binary_mmap_source(binary_mmap_source&& val)
+            : current_(nullptr), end_(nullptr)
+        {
+            file_.swap(val.file_);
+            std::swap(current_,val.current_);
+            std::swap(end_,val.end_);
+        }
+
+        binary_mmap_source& operator=(binary_mmap_source&& val)
+        {
+            file_.swap(val.file_);
+            std::swap(current_,val.current_);
+            std::swap(end_,val.end_);
+            return *this;
+        }
+
+        bool eof() const
+        {
+            return current_ == end_;
+        }
+
+        bool is_error() const
+        {
+            return file_.is_error();
+        }
+
+        std::size_t position() const
+        {
+            return current_ - file_.data() + 1;
+        }
+
+        character_result<value_type> get_character()
+        {
+            if (current_ < end_)
+            {
+                return character_result<value_type>(*current_++);
+            }
+            else
+            {
+                return character_result<value_type>();
+            }
+        }
+
+        void ignore(std::size_t count)
+        {
+            std::size_t len;
+            if ((std::size_t)(end_ - current_) < count)
+            {
+                len = end_ - current_;
+            }
+            else
+            {
+                len = count;
+            }
+            current_ += len;
+        }
+
+        character_result<value_type> peek_character()
+        {
+            return current_ < end_ ? character_result<value_type>(*current_) : character_result<value_type>();
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t len;
+            if ((std::size_t)(end_ - current_) < length)
+            {
+                len = end_ - current_;
+            }
+            else
+            {
+                len = length;
+            }
+            std::memcpy(p, current_, len);
+            current_  += len;
+            return len;
+        }
+
+        span<const value_type> read_buffer()
+        {
+            span<const value_type> s(current_, end_ - current_);
+            current_ = end_;
+            return s;
+        }
+    };
+
+} // namespace jsoncons
+
+#endif
@@ -0,0 +1,409 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_OBJECT_SHAPE_HPP
+#define JSONCONS_OBJECT_SHAPE_HPP
+
+#include <atomic>
+#include <vector>
+#include <memory> // std::allocator
+#include <utility> // std::move
+#include <iterator> // std::distance
+#include <type_traits> // std::enable_if
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/more_type_traits.hpp>
+#include <jsoncons/detail/hash_key.hpp> // jsoncons::detail::hash_key_chars
+
+namespace jsoncons {
+namespace detail {
+
+    // An object_shape holds the keys of an object in order, with an open addressing hash
+    // index of their positions if there are more than a few. Objects that have the same
+    // keys in the same order share a shape, and hold only their values. A shape is
+    // reference counted, and is not modified while it is shared.
+
+    template <class KeyT,class Json>
+    class object_shape
+    {
+    public:
+        using key_type = KeyT;
+        using allocator_type = typename Json::allocator_type;
+        using string_view_type = typename Json::string_view_type;
+    private:
+        using implementation_policy = typename Json::implementation_policy;
+        using key_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<key_type>;
+        using key_container_type = typename implementation_policy::template sequence_container_type<key_type,key_allocator_type>;
+        using index_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<std::size_t>;
+        using index_container_type = typename implementation_policy::template sequence_container_type<std::size_t,index_allocator_type>;
+
+        // Shapes with no more keys than this are searched linearly, and have no index
+        static constexpr std::size_t max_unindexed_size = 16;
+
+        std::atomic<std::size_t> count_;
+        allocator_type alloc_;
+        key_container_type keys_;
+        // A slot holds the position of a key plus one, or zero if empty. There are a
+        // power of two slots, and at most half of them are used.
+        index_container_type index_;
+    public:
+        explicit object_shape(const allocator_type& alloc)
+            : count_(1), alloc_(alloc), keys_(key_allocator_type(alloc)), index_(index_allocator_type(alloc))
+        {
+        }
+
+        object_shape(const allocator_type& alloc, const object_shape& other)
+            : count_(1), alloc_(alloc),
+              keys_(other.keys_, key_allocator_type(alloc)),
+              index_(other.index_, index_allocator_type(alloc))
+        {
+        }
+
+        object_shape(const object_shape&) = delete;
+        object_shape& operator=(const object_shape&) = delete;
+
+        allocator_type get_allocator() const
+        {
+            return alloc_;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return keys_.size();
+        }
+
+        const key_type* keys() const noexcept
+        {
+            return keys_.empty() ? nullptr : std::addressof(keys_[0]);
+        }
+
+        const key_type& key(std::size_t i) const
+        {
+            return keys_[i];
+        }
+
+        // Returns the position of key name, or size() if there is none. If there is none
+        // and the shape is indexed, slot is set to the empty slot where the key belongs.
+        std::size_t find(const string_view_type& name, std::size_t& slot) const noexcept
+        {
+            slot = 0;
+            if (index_.empty())
+            {
+                std::size_t pos = 0;
+                while (pos < keys_.size() && !(keys_[pos] == name))
+                {
+                    ++pos;
+                }
+                return pos;
+            }
+            const std::size_t mask = index_.size() - 1;
+            for (slot = hash_key(name) & mask; index_[slot] != 0; slot = (slot + 1) & mask)
+            {
+                if (keys_[index_[slot] - 1] == name)
+                {
+                    return index_[slot] - 1;
+                }
+            }
+            return keys_.size();
+        }
+
+        std::size_t find(const string_view_type& name) const noexcept
+        {
+            std::size_t slot;
+            return find(name, slot);
+        }
+
+        // The modifiers require that the shape is not shared
+
+        // Appends a key that find placed at slot
+        void push_back(key_type&& key, std::size_t slot)
+        {
+            keys_.push_back(std::move(key));
+            if (index_.empty() ? keys_.size() > max_unindexed_size : keys_.size()*2 > index_.size())
+            {
+                build_index();
+            }
+            else if (!index_.empty())
+            {
+                index_[slot] = keys_.size();
+            }
+        }
+
+        void insert(std::size_t pos, key_type&& key)
+        {
+            keys_.insert(keys_.begin() + pos, std::move(key));
+            build_index();
+        }
+
+        void erase(std::size_t first, std::size_t last)
+        {
+            keys_.erase(keys_.begin() + first, keys_.begin() + last);
+            build_index();
+        }
+
+        void reserve(std::size_t n)
+        {
+            keys_.reserve(n);
+        }
+
+        void shrink_to_fit()
+        {
+            keys_.shrink_to_fit();
+        }
+
+        void add_ref() noexcept
+        {
+            count_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Returns true if this was the last reference
+        bool release() noexcept
+        {
+            return count_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+
+        bool shared() const noexcept
+        {
+            return count_.load(std::memory_order_acquire) > 1;
+        }
+    private:
+        static std::size_t hash_key(const string_view_type& key) noexcept
+        {
+            return hash_key_chars(key.data(), key.size());
+        }
+
+        void build_index()
+        {
+            index_.clear();
+            if (keys_.size() <= max_unindexed_size)
+            {
+                return;
+            }
+            std::size_t capacity = 4*max_unindexed_size;
+            while (capacity < keys_.size()*2)
+            {
+                capacity *= 2;
+            }
+            index_.resize(capacity, 0);
+            const std::size_t mask = capacity - 1;
+            for (std::size_t i = 0; i < keys_.size(); ++i)
+            {
+                std::size_t slot = hash_key(string_view_type(keys_[i].data(), keys_[i].size())) & mask;
+                while (index_[slot] != 0)
+                {
+                    slot = (slot + 1) & mask;
+                }
+                index_[slot] = i + 1;
+            }
+        }
+    };
+
+    // A counted reference to an object_shape, or to none
+
+    template <class Shape>
+    class object_shape_ref
+    {
+    public:
+        using shape_type = Shape;
+        using allocator_type = typename Shape::allocator_type;
+    private:
+        using shape_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<shape_type>;
+        using pointer = typename std::allocator_traits<shape_allocator_type>::pointer;
+
+        pointer ptr_;
+    public:
+        object_shape_ref() noexcept
+            : ptr_(nullptr)
+        {
+        }
+
+        object_shape_ref(const object_shape_ref& other) noexcept
+            : ptr_(other.ptr_)
+        {
+            if (ptr_)
+            {
+                ptr_->add_ref();
+            }
+        }
+
+        object_shape_ref(object_shape_ref&& other) noexcept
+            : ptr_(other.ptr_)
+        {
+            other.ptr_ = nullptr;
+        }
+
+        ~object_shape_ref() noexcept
+        {
+            reset();
+        }
+
+        object_shape_ref& operator=(const object_shape_ref& other) noexcept
+        {
+            object_shape_ref(other).swap(*this);
+            return *this;
+        }
+
+        object_shape_ref& operator=(object_shape_ref&& other) noexcept
+        {
+            object_shape_ref(std::move(other)).swap(*this);
+            return *this;
+        }
+
+        template <class... Args>
+        static object_shape_ref create(const allocator_type& alloc, Args&&... args)
+        {
+            shape_allocator_type shape_alloc(alloc);
+            object_shape_ref ref;
+            ref.ptr_ = std::allocator_traits<shape_allocator_type>::allocate(shape_alloc, 1);
+            JSONCONS_TRY
+            {
+                std::allocator_traits<shape_allocator_type>::construct(shape_alloc, jsoncons::detail::to_plain_pointer(ref.ptr_),
+                                                                       alloc, std::forward<Args>(args)...);
+            }
+            JSONCONS_CATCH(...)
+            {
+                std::allocator_traits<shape_allocator_type>::deallocate(shape_alloc, ref.ptr_, 1);
+                ref.ptr_ = nullptr;
+                JSONCONS_RETHROW;
+            }
+            return ref;
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return ptr_ != nullptr;
+        }
+
+        shape_type* get() const noexcept
+        {
+            return jsoncons::detail::to_plain_pointer(ptr_);
+        }
+
+        shape_type& operator*() const noexcept
+        {
+            return *get();
+        }
+
+        shape_type* operator->() const noexcept
+        {
+            return get();
+        }
+
+        void reset() noexcept
+        {
+            if (ptr_ && ptr_->release())
+            {
+                shape_allocator_type shape_alloc(ptr_->get_allocator());
+                std::allocator_traits<shape_allocator_type>::destroy(shape_alloc, jsoncons::detail::to_plain_pointer(ptr_));
+                std::allocator_traits<shape_allocator_type>::deallocate(shape_alloc, ptr_, 1);
+            }
+            ptr_ = nullptr;
+        }
+
+        void swap(object_shape_ref& other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+        }
+    };
+
+    // The shapes of the objects decoded most recently, so that records that have the same
+    // keys in the same order share one shape
+
+    template <class Shape>
+    class object_shape_cache
+    {
+    public:
+        using shape_ref_type = object_shape_ref<Shape>;
+    private:
+        static constexpr std::size_t cache_size = 8;
+
+        shape_ref_type shapes_[cache_size];
+        std::size_t last_;
+        std::size_t next_;
+    public:
+        object_shape_cache()
+            : last_(0), next_(0)
+        {
+        }
+
+        object_shape_cache(const object_shape_cache&) = delete;
+        object_shape_cache& operator=(const object_shape_cache&) = delete;
+
+        // Returns a cached shape with the keys of [first,last) in order, or none
+        template <class InputIt,class GetKey>
+        shape_ref_type find(InputIt first, InputIt last, GetKey get_key, const typename Shape::allocator_type& alloc) const
+        {
+            const std::size_t count = std::distance(first, last);
+            for (std::size_t n = 0; n < cache_size; ++n)
+            {
+                const std::size_t i = (last_ + n) % cache_size;
+                const shape_ref_type& shape = shapes_[i];
+                if (shape && shape->size() == count && shape->get_allocator() == alloc &&
+                    same_keys(*shape, first, last, get_key))
+                {
+                    const_cast<object_shape_cache*>(this)->last_ = i;
+                    return shape;
+                }
+            }
+            return shape_ref_type();
+        }
+
+        void add(const shape_ref_type& shape)
+        {
+            last_ = next_;
+            shapes_[next_] = shape;
+            next_ = (next_ + 1) % cache_size;
+        }
+
+        void clear() noexcept
+        {
+            for (auto& shape : shapes_)
+            {
+                shape.reset();
+            }
+            last_ = next_ = 0;
+        }
+    private:
+        template <class InputIt,class GetKey>
+        static bool same_keys(const Shape& shape, InputIt first, InputIt last, GetKey get_key)
+        {
+            std::size_t i = 0;
+            for (auto it = first; it != last; ++it, ++i)
+            {
+                if (!(shape.key(i) == get_key(*it)))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    // The shape cache type of json_object type Object, or no_object_shape_cache if it has none
+
+    struct no_object_shape_cache
+    {
+    };
+
+    template <class Object>
+    using object_shape_cache_t = typename Object::shape_cache;
+
+    template <class Object,class Enable=void>
+    struct object_shape_cache_of
+    {
+        using type = no_object_shape_cache;
+    };
+
+    template <class Object>
+    struct object_shape_cache_of<Object,
+        typename std::enable_if<is_detected<object_shape_cache_t,Object>::value>::type>
+    {
+        using type = typename Object::shape_cache;
+    };
+
+} // namespace detail
+} // namespace jsoncons
+
+#endif
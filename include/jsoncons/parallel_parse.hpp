@@ -0,0 +1,48 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_PARALLEL_PARSE_HPP
+#define JSONCONS_PARALLEL_PARSE_HPP
+
+#include <functional> // std::function
+#include <jsoncons/basic_json.hpp>
+#include <jsoncons/detail/parallel_parse.hpp>
+
+namespace jsoncons {
+
+    // parse_parallel
+    //
+    // Kept out of basic_json.hpp so that programs that do not parse on several
+    // threads do not include <thread> or link with the thread library.
+    // num_threads of 0 means std::thread::hardware_concurrency()
+
+    template <class Json>
+    typename std::enable_if<is_basic_json<Json>::value,Json>::type
+    parse_parallel(const basic_string_view<typename Json::char_type>& s, 
+                   std::size_t num_threads,
+                   const basic_json_decode_options<typename Json::char_type>& options = basic_json_decode_options<typename Json::char_type>(), 
+                   std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing())
+    {
+        auto result = unicons::skip_bom(s.begin(), s.end());
+        if (result.ec != unicons::encoding_errc())
+        {
+            JSONCONS_THROW(ser_error(result.ec));
+        }
+        std::size_t offset = result.it - s.begin();
+        if (num_threads != 1)
+        {
+            Json j;
+            if (jsoncons::detail::parse_array_in_parallel(s.data()+offset, s.size()-offset, num_threads, options, j))
+            {
+                return j;
+            }
+        }
+        return Json::parse(s, options, err_handler);
+    }
+
+} // namespace jsoncons
+
+#endif
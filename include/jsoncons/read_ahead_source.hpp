@@ -0,0 +1,277 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_READ_AHEAD_SOURCE_HPP
+#define JSONCONS_READ_AHEAD_SOURCE_HPP
+
+#include <cstddef>
+#include <cstring> // std::memcpy
+#include <algorithm> // std::min
+#include <memory> // std::unique_ptr
+#include <vector>
+#include <deque>
+#include <utility> // std::move
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/source.hpp>
+
+namespace jsoncons {
+
+    // read_ahead_source wraps another source and reads it on a background thread,
+    // block_count blocks of block_length characters at a time, so that waiting for
+    // input overlaps with parsing. Filled blocks are handed to the consumer without
+    // copying, and returned to the reading thread once consumed.
+
+    template <class Source>
+    class read_ahead_source
+    {
+    public:
+        using value_type = typename Source::value_type;
+        static constexpr std::size_t default_block_length = 65536;
+        static constexpr std::size_t default_block_count = 3;
+    private:
+        struct shared_state
+        {
+            Source source;
+            std::vector<std::vector<value_type>> blocks;
+            std::vector<std::size_t> lengths;
+            std::vector<std::size_t> free_blocks;
+            std::deque<std::size_t> filled_blocks;
+            bool done;
+            bool is_error;
+            bool stop;
+            std::mutex mutex;
+            std::condition_variable block_freed;
+            std::condition_variable block_filled;
+            std::thread thread;
+
+            shared_state(Source&& src, std::size_t block_length, std::size_t block_count)
+                : source(std::move(src)),
+                  blocks(block_count, std::vector<value_type>(block_length)),
+                  lengths(block_count, 0),
+                  done(false), is_error(false), stop(false)
+            {
+                for (std::size_t i = 0; i < block_count; ++i)
+                {
+                    free_blocks.push_back(i);
+                }
+            }
+
+            void run()
+            {
+                for (;;)
+                {
+                    std::size_t index;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        block_freed.wait(lock, [this]() {return stop || !free_blocks.empty();});
+                        if (stop)
+                        {
+                            return;
+                        }
+                        index = free_blocks.back();
+                        free_blocks.pop_back();
+                    }
+
+                    std::size_t length = 0;
+                    bool end = true;
+                    bool error = false;
+                    JSONCONS_TRY
+                    {
+                        length = source.read(blocks[index].data(), blocks[index].size());
+                        error = source.is_error();
+                        end = length == 0 || error || source.eof();
+                    }
+                    JSONCONS_CATCH(...)
+                    {
+                        error = true;
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        lengths[index] = length;
+                        if (length > 0)
+                        {
+                            filled_blocks.push_back(index);
+                        }
+                        else
+                        {
+                            free_blocks.push_back(index);
+                        }
+                        done = end;
+                        is_error = error;
+                    }
+                    block_filled.notify_one();
+                    if (end)
+                    {
+                        return;
+                    }
+                }
+            }
+
+            ~shared_state() noexcept
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stop = true;
+                }
+                block_freed.notify_one();
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+        };
+
+        std::unique_ptr<shared_state> state_;
+        bool started_;
+        std::size_t current_block_;
+        const value_type* current_;
+        const value_type* end_;
+        std::size_t position_;
+
+        // Noncopyable
+        read_ahead_source(const read_ahead_source&) = delete;
+        read_ahead_source& operator=(const read_ahead_source&) = delete;
+    public:
+        read_ahead_source()
+            : read_ahead_source(Source())
+        {
+        }
+
+        explicit read_ahead_source(Source&& source,
+                                   std::size_t block_length = default_block_length,
+                                   std::size_t block_count = default_block_count)
+            : state_(new shared_state(std::move(source),
+                                      block_length > 0 ? block_length : 1,
+                                      block_count > 1 ? block_count : 2)),
+              started_(false), current_block_(0), current_(nullptr), end_(nullptr), position_(0)
+        {
+        }
+
+        read_ahead_source(read_ahead_source&&) = default;
+        read_ahead_source& operator=(read_ahead_source&&) = default;
+
+        // Stops the reading thread, after any read it has in progress returns
+        ~read_ahead_source() noexcept = default;
+
+        bool eof() const
+        {
+            if (current_ != end_)
+            {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            return state_->done && state_->filled_blocks.empty();
+        }
+
+        bool is_error() const
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            return state_->is_error;
+        }
+
+        std::size_t position() const
+        {
+            return position_;
+        }
+
+        character_result<value_type> get_character()
+        {
+            if (current_ == end_ && !next_block())
+            {
+                return character_result<value_type>();
+            }
+            ++position_;
+            return character_result<value_type>(*current_++);
+        }
+
+        void ignore(std::size_t count)
+        {
+            while (count > 0)
+            {
+                if (current_ == end_ && !next_block())
+                {
+                    return;
+                }
+                std::size_t len = (std::min)(count, static_cast<std::size_t>(end_ - current_));
+                current_ += len;
+                position_ += len;
+                count -= len;
+            }
+        }
+
+        character_result<value_type> peek_character()
+        {
+            if (current_ == end_ && !next_block())
+            {
+                return character_result<value_type>();
+            }
+            return character_result<value_type>(*current_);
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t count = 0;
+            while (count < length && (current_ != end_ || next_block()))
+            {
+                std::size_t len = (std::min)(length - count, static_cast<std::size_t>(end_ - current_));
+                std::memcpy(p + count, current_, len*sizeof(value_type));
+                current_ += len;
+                count += len;
+            }
+            position_ += count;
+            return count;
+        }
+
+        // Hands over the rest of the current block, or the next filled block, in place.
+        // The block stays valid until the next call that reads from this source.
+        span<const value_type> read_buffer()
+        {
+            if (current_ == end_ && !next_block())
+            {
+                return span<const value_type>();
+            }
+            span<const value_type> s(current_, end_ - current_);
+            position_ += s.size();
+            current_ = end_;
+            return s;
+        }
+    private:
+        // Returns the consumed block to the reading thread and waits for the next one
+        bool next_block()
+        {
+            shared_state& state = *state_;
+            std::unique_lock<std::mutex> lock(state.mutex);
+            if (!started_)
+            {
+                state.thread = std::thread(&shared_state::run, state_.get());
+                started_ = true;
+            }
+            else if (current_ != nullptr)
+            {
+                state.free_blocks.push_back(current_block_);
+                current_ = end_ = nullptr;
+                state.block_freed.notify_one();
+            }
+            state.block_filled.wait(lock, [&state]() {return state.done || !state.filled_blocks.empty();});
+            if (state.filled_blocks.empty())
+            {
+                return false;
+            }
+            current_block_ = state.filled_blocks.front();
+            state.filled_blocks.pop_front();
+            current_ = state.blocks[current_block_].data();
+            end_ = current_ + state.lengths[current_block_];
+            return true;
+        }
+    };
+
+} // namespace jsoncons
+
+#endif
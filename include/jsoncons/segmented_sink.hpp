@@ -0,0 +1,247 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_SEGMENTED_SINK_HPP
+#define JSONCONS_SEGMENTED_SINK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <algorithm> // std::min
+#include <memory> // std::allocator, std::allocator_traits, std::addressof
+#include <vector>
+#include <utility> // std::swap
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/more_type_traits.hpp>
+
+namespace jsoncons {
+
+    // basic_segmented_buffer holds output in a list of fixed size segments obtained from
+    // its allocator. Growing it never moves what has already been written, unlike a
+    // std::basic_string or std::vector.
+
+    template <class T,class Allocator=std::allocator<T>>
+    class basic_segmented_buffer
+    {
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        static constexpr std::size_t default_segment_length = 65536;
+    private:
+        using value_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<value_type>;
+        using alloc_traits = std::allocator_traits<value_allocator_type>;
+        using pointer = typename alloc_traits::pointer;
+        using pointer_allocator_type = typename std::allocator_traits<allocator_type>:: template rebind_alloc<pointer>;
+
+        value_allocator_type alloc_;
+        std::size_t segment_length_;
+        std::vector<pointer,pointer_allocator_type> segments_;
+        value_type* p_;
+        value_type* end_;
+
+        // Noncopyable
+        basic_segmented_buffer(const basic_segmented_buffer&) = delete;
+        basic_segmented_buffer& operator=(const basic_segmented_buffer&) = delete;
+    public:
+        explicit basic_segmented_buffer(std::size_t segment_length = default_segment_length,
+                                        const Allocator& alloc = Allocator())
+            : alloc_(alloc), segment_length_(segment_length > 0 ? segment_length : 1),
+              segments_(pointer_allocator_type(alloc)), p_(nullptr), end_(nullptr)
+        {
+        }
+
+        basic_segmented_buffer(basic_segmented_buffer&& other) noexcept
+            : alloc_(other.alloc_), segment_length_(other.segment_length_),
+              segments_(std::move(other.segments_)), p_(other.p_), end_(other.end_)
+        {
+            other.segments_.clear();
+            other.p_ = other.end_ = nullptr;
+        }
+
+        ~basic_segmented_buffer() noexcept
+        {
+            clear();
+        }
+
+        basic_segmented_buffer& operator=(basic_segmented_buffer&& other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        allocator_type get_allocator() const
+        {
+            return alloc_;
+        }
+
+        std::size_t segment_length() const
+        {
+            return segment_length_;
+        }
+
+        std::size_t size() const
+        {
+            return segments_.empty() ? 0 : (segments_.size()-1)*segment_length_ + (p_ - last_segment());
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        void push_back(value_type ch)
+        {
+            if (p_ == end_)
+            {
+                add_segment();
+            }
+            *p_++ = ch;
+        }
+
+        void append(const value_type* s, std::size_t length)
+        {
+            while (length > 0)
+            {
+                if (p_ == end_)
+                {
+                    add_segment();
+                }
+                std::size_t len = (std::min)(length, static_cast<std::size_t>(end_ - p_));
+                std::memcpy(p_, s, len*sizeof(value_type));
+                p_ += len;
+                s += len;
+                length -= len;
+            }
+        }
+
+        // The filled part of each segment, in order, e.g. for writev
+        std::vector<span<const value_type>> segments() const
+        {
+            std::vector<span<const value_type>> result;
+            result.reserve(segments_.size());
+            for (std::size_t i = 0; i < segments_.size(); ++i)
+            {
+                const value_type* data = jsoncons::detail::to_plain_pointer(segments_[i]);
+                std::size_t length = i+1 < segments_.size() ? segment_length_ : static_cast<std::size_t>(p_ - data);
+                if (length > 0)
+                {
+                    result.emplace_back(data, length);
+                }
+            }
+            return result;
+        }
+
+        // Copies the content to dest, which must have room for size() elements
+        void copy_to(value_type* dest) const
+        {
+            for (const auto& s : segments())
+            {
+                std::memcpy(dest, s.data(), s.size()*sizeof(value_type));
+                dest += s.size();
+            }
+        }
+
+        // Appends the content to a std::basic_string, std::vector or similar container
+        template <class Container>
+        void append_to(Container& cont) const
+        {
+            cont.reserve(cont.size() + size());
+            for (const auto& s : segments())
+            {
+                cont.insert(cont.end(), s.begin(), s.end());
+            }
+        }
+
+        void clear() noexcept
+        {
+            for (auto ptr : segments_)
+            {
+                alloc_traits::deallocate(alloc_, ptr, segment_length_);
+            }
+            segments_.clear();
+            p_ = end_ = nullptr;
+        }
+
+        void swap(basic_segmented_buffer& other) noexcept
+        {
+            std::swap(alloc_, other.alloc_);
+            std::swap(segment_length_, other.segment_length_);
+            segments_.swap(other.segments_);
+            std::swap(p_, other.p_);
+            std::swap(end_, other.end_);
+        }
+    private:
+        const value_type* last_segment() const
+        {
+            return jsoncons::detail::to_plain_pointer(segments_.back());
+        }
+
+        void add_segment()
+        {
+            pointer ptr = alloc_traits::allocate(alloc_, segment_length_);
+            JSONCONS_TRY
+            {
+                segments_.push_back(ptr);
+            }
+            JSONCONS_CATCH(...)
+            {
+                alloc_traits::deallocate(alloc_, ptr, segment_length_);
+                JSONCONS_RETHROW;
+            }
+            p_ = jsoncons::detail::to_plain_pointer(ptr);
+            end_ = p_ + segment_length_;
+        }
+    };
+
+    using segmented_buffer = basic_segmented_buffer<char>;
+    using binary_segmented_buffer = basic_segmented_buffer<uint8_t>;
+
+    // segmented_sink appends encoder output to a basic_segmented_buffer owned by the caller
+
+    template <class T,class Allocator=std::allocator<T>>
+    class segmented_sink
+    {
+    public:
+        using value_type = T;
+        using container_type = basic_segmented_buffer<T,Allocator>;
+    private:
+        container_type* buf_ptr;
+
+        // Noncopyable
+        segmented_sink(const segmented_sink&) = delete;
+        segmented_sink& operator=(const segmented_sink&) = delete;
+    public:
+        segmented_sink(segmented_sink&& val)
+            : buf_ptr(nullptr)
+        {
+            std::swap(buf_ptr,val.buf_ptr);
+        }
+
+        segmented_sink(container_type& buf)
+            : buf_ptr(std::addressof(buf))
+        {
+        }
+
+        segmented_sink& operator=(segmented_sink&& val) = default;
+
+        void flush()
+        {
+        }
+
+        void append(const value_type* s, std::size_t length)
+        {
+            buf_ptr->append(s, length);
+        }
+
+        void push_back(value_type ch)
+        {
+            buf_ptr->push_back(ch);
+        }
+    };
+
+} // namespace jsoncons
+
+#endif
@@ -12,6 +12,7 @@
 #include <vector>
 #include <istream>
 #include <memory> // std::addressof
+#include <algorithm> // std::min
 #include <cstring> // std::memcpy
 #include <exception>
 #include <type_traits> // std::enable_if
@@ -83,6 +84,20 @@ namespace jsoncons {
         }
     };
 
+    // has_read_buffer
+
+    namespace detail {
+        template <class Source>
+        using source_read_buffer_t = decltype(std::declval<Source&>().read_buffer());
+    }
+
+    // Sources that already hold their input in memory may provide
+    //     span<const value_type> read_buffer() 
+    // returning the next unread block in place. Readers pass such blocks 
+    // straight to the parser instead of copying them into a buffer of their own. 
+    template <class Source>
+    using has_read_buffer = jsoncons::detail::is_detected<jsoncons::detail::source_read_buffer_t, Source>;
+
     // text sources
 
     template <class CharT>
@@ -345,6 +360,13 @@ namespace jsoncons {
             current_  += len;
             return len;
         }
+
+        span<const value_type> read_buffer()
+        {
+            span<const value_type> s(current_, end_ - current_);
+            current_ = end_;
+            return s;
+        }
     };
 
     // iterator source
@@ -567,6 +589,217 @@ namespace jsoncons {
         }
     };
 
+    // buffered_binary_stream_source reads the stream in blocks of buffer_length bytes and serves
+    // get_character, peek_character, ignore and read from memory, so the binary parsers
+    // do not make a streambuf call per byte. Bytes read ahead but not consumed are given 
+    // back on destruction by seeking the stream. If the stream cannot seek, as with a pipe,
+    // a socket or std::cin, those bytes are lost and failbit is set on the stream.
+
+    class buffered_binary_stream_source 
+    {
+    public:
+        typedef uint8_t value_type;
+        static constexpr std::size_t default_max_buffer_length = 16384;
+    private:
+        basic_null_istream<char> null_is_;
+        std::istream* stream_ptr_;
+        std::streambuf* sbuf_;
+        std::size_t position_;
+        std::vector<value_type> buffer_;
+        const value_type* current_;
+        const value_type* end_;
+
+        // Noncopyable 
+        buffered_binary_stream_source(const buffered_binary_stream_source&) = delete;
+        buffered_binary_stream_source& operator=(const buffered_binary_stream_source&) = delete;
+    public:
+        buffered_binary_stream_source()
+            : stream_ptr_(&null_is_), sbuf_(null_is_.rdbuf()), position_(0),
+              current_(nullptr), end_(nullptr)
+        {
+        }
+
+        buffered_binary_stream_source(std::istream& is, std::size_t buffer_length = default_max_buffer_length)
+            : stream_ptr_(std::addressof(is)), sbuf_(is.rdbuf()), position_(0),
+              buffer_(buffer_length > 0 ? buffer_length : 1), current_(buffer_.data()), end_(buffer_.data())
+        {
+        }
+
+        buffered_binary_stream_source(buffered_binary_stream_source&& other) noexcept
+            : stream_ptr_(&null_is_), sbuf_(null_is_.rdbuf()), position_(0),
+              current_(nullptr), end_(nullptr)
+        {
+            std::swap(stream_ptr_,other.stream_ptr_);
+            std::swap(sbuf_,other.sbuf_);
+            std::swap(position_,other.position_);
+            buffer_.swap(other.buffer_);
+            std::swap(current_,other.current_);
+            std::swap(end_,other.end_);
+        }
+
+        ~buffered_binary_stream_source() noexcept
+        {
+            give_back();
+        }
+
+        buffered_binary_stream_source& operator=(buffered_binary_stream_source&& other) noexcept
+        {
+            std::swap(stream_ptr_,other.stream_ptr_);
+            std::swap(sbuf_,other.sbuf_);
+            std::swap(position_,other.position_);
+            buffer_.swap(other.buffer_);
+            std::swap(current_,other.current_);
+            std::swap(end_,other.end_);
+            return *this;
+        }
+
+        bool eof() const
+        {
+            return current_ == end_ && stream_ptr_->eof();  
+        }
+
+        bool is_error() const
+        {
+            return stream_ptr_->bad();  
+        }
+
+        std::size_t position() const
+        {
+            return position_;
+        }
+
+        character_result<value_type> get_character()
+        {
+            if (current_ == end_ && !fill_buffer())
+            {
+                return character_result<value_type>();
+            }
+            ++position_;
+            return character_result<value_type>(*current_++);
+        }
+
+        void ignore(std::size_t count)
+        {
+            while (count > 0)
+            {
+                if (current_ == end_ && !fill_buffer())
+                {
+                    return;
+                }
+                std::size_t len = (std::min)(count, static_cast<std::size_t>(end_ - current_));
+                current_ += len;
+                position_ += len;
+                count -= len;
+            }
+        }
+
+        character_result<value_type> peek_character() 
+        {
+            if (current_ == end_ && !fill_buffer())
+            {
+                return character_result<value_type>();
+            }
+            return character_result<value_type>(*current_);
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t count = (std::min)(length, static_cast<std::size_t>(end_ - current_));
+            if (count > 0)
+            {
+                std::memcpy(p, current_, count);
+                current_ += count;
+            }
+            if (count < length)
+            {
+                if (length - count >= buffer_.size())
+                {
+                    // Large reads bypass the buffer
+                    JSONCONS_TRY
+                    {
+                        std::streamsize n = sbuf_->sgetn(reinterpret_cast<char*>(p + count), length - count); // never negative
+                        count += static_cast<std::size_t>(n);
+                        if (count < length)
+                        {
+                            stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::eofbit);
+                        }
+                    }
+                    JSONCONS_CATCH(const std::exception&)     
+                    {
+                        stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::badbit | std::ios::eofbit);
+                    }
+                }
+                else
+                {
+                    while (count < length && (current_ != end_ || fill_buffer()))
+                    {
+                        std::size_t len = (std::min)(length - count, static_cast<std::size_t>(end_ - current_));
+                        std::memcpy(p + count, current_, len);
+                        current_ += len;
+                        count += len;
+                    }
+                }
+            }
+            position_ += length;
+            return count;
+        }
+    private:
+        // Refills an exhausted buffer, returning false and setting eofbit 
+        // (and badbit if the streambuf throws) when no more bytes are available
+        bool fill_buffer()
+        {
+            if (buffer_.empty())
+            {
+                stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::eofbit);
+                return false;
+            }
+            JSONCONS_TRY
+            {
+                std::streamsize count = sbuf_->sgetn(reinterpret_cast<char*>(buffer_.data()), buffer_.size()); // never negative
+                current_ = buffer_.data();
+                end_ = buffer_.data() + count;
+                if (count == 0)
+                {
+                    stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::eofbit);
+                    return false;
+                }
+                return true;
+            }
+            JSONCONS_CATCH(const std::exception&)     
+            {
+                current_ = end_ = buffer_.data();
+                stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::badbit | std::ios::eofbit);
+                return false;
+            }
+        }
+
+        void give_back() noexcept
+        {
+            if (current_ != end_)
+            {
+                bool done = false;
+                JSONCONS_TRY
+                {
+                    done = sbuf_->pubseekoff(-static_cast<std::streamoff>(end_ - current_), std::ios_base::cur, std::ios_base::in) != std::streampos(std::streamoff(-1));
+                }
+                JSONCONS_CATCH(...)
+                {
+                }
+                if (!done)
+                {
+                    JSONCONS_TRY
+                    {
+                        stream_ptr_->clear(stream_ptr_->rdstate() | std::ios::failbit);
+                    }
+                    JSONCONS_CATCH(...)
+                    {
+                    }
+                }
+                current_ = end_;
+            }
+        }
+    };
+
     class bytes_source 
     {
     public:
@@ -659,6 +892,13 @@ namespace jsoncons {
             current_  += len;
             return len;
         }
+
+        span<const value_type> read_buffer()
+        {
+            span<const value_type> s(current_, end_ - current_);
+            current_ = end_;
+            return s;
+        }
     };
 
     // binary_iterator source
@@ -0,0 +1,189 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_SPAN_LIST_SOURCE_HPP
+#define JSONCONS_SPAN_LIST_SOURCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <algorithm> // std::min
+#include <vector>
+#include <utility> // std::move
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/source.hpp>
+
+#if !defined(_WIN32)
+#include <sys/uio.h> // iovec
+#endif
+
+namespace jsoncons {
+
+    // span_list_source reads input held in a list of non-contiguous buffers, such as a
+    // chain of network buffers, without coalescing them. read_buffer() hands out one
+    // buffer at a time in place, so the JSON parser deals with a string or number split
+    // between buffers only at the boundary.
+
+    template <class CharT>
+    class span_list_source
+    {
+    public:
+        using value_type = CharT;
+    private:
+        std::vector<span<const value_type>> spans_;
+        std::size_t index_;
+        const value_type* current_;
+        const value_type* end_;
+        std::size_t position_;
+
+        // Noncopyable
+        span_list_source(const span_list_source&) = delete;
+        span_list_source& operator=(const span_list_source&) = delete;
+    public:
+        span_list_source()
+            : index_(0), current_(nullptr), end_(nullptr), position_(0)
+        {
+        }
+
+        explicit span_list_source(std::vector<span<const value_type>> spans)
+            : spans_(std::move(spans)), index_(0), current_(nullptr), end_(nullptr), position_(0)
+        {
+        }
+
+        // Each element of [first,last) must have data() and size(), e.g. a span, std::basic_string or std::vector
+        template <class Iterator>
+        span_list_source(Iterator first, Iterator last)
+            : index_(0), current_(nullptr), end_(nullptr), position_(0)
+        {
+            for (; first != last; ++first)
+            {
+                spans_.emplace_back(first->data(), first->size());
+            }
+        }
+
+#if !defined(_WIN32)
+        span_list_source(const struct iovec* iov, std::size_t count)
+            : index_(0), current_(nullptr), end_(nullptr), position_(0)
+        {
+            spans_.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                spans_.emplace_back(static_cast<const value_type*>(iov[i].iov_base), iov[i].iov_len/sizeof(value_type));
+            }
+        }
+#endif
+
+        span_list_source(span_list_source&&) = default;
+        span_list_source& operator=(span_list_source&&) = default;
+
+        bool eof() const
+        {
+            if (current_ != end_)
+            {
+                return false;
+            }
+            for (std::size_t i = index_; i < spans_.size(); ++i)
+            {
+                if (spans_[i].size() > 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool is_error() const
+        {
+            return false;
+        }
+
+        std::size_t position() const
+        {
+            return position_;
+        }
+
+        character_result<value_type> get_character()
+        {
+            if (current_ == end_ && !next_span())
+            {
+                return character_result<value_type>();
+            }
+            ++position_;
+            return character_result<value_type>(*current_++);
+        }
+
+        void ignore(std::size_t count)
+        {
+            while (count > 0)
+            {
+                if (current_ == end_ && !next_span())
+                {
+                    return;
+                }
+                std::size_t len = (std::min)(count, static_cast<std::size_t>(end_ - current_));
+                current_ += len;
+                position_ += len;
+                count -= len;
+            }
+        }
+
+        character_result<value_type> peek_character()
+        {
+            if (current_ == end_ && !next_span())
+            {
+                return character_result<value_type>();
+            }
+            return character_result<value_type>(*current_);
+        }
+
+        std::size_t read(value_type* p, std::size_t length)
+        {
+            std::size_t count = 0;
+            while (count < length && (current_ != end_ || next_span()))
+            {
+                std::size_t len = (std::min)(length - count, static_cast<std::size_t>(end_ - current_));
+                std::memcpy(p + count, current_, len*sizeof(value_type));
+                current_ += len;
+                count += len;
+            }
+            position_ += count;
+            return count;
+        }
+
+        // Hands out the rest of the current buffer, or the next buffer, in place
+        span<const value_type> read_buffer()
+        {
+            if (current_ == end_ && !next_span())
+            {
+                return span<const value_type>();
+            }
+            span<const value_type> s(current_, end_ - current_);
+            position_ += s.size();
+            current_ = end_;
+            return s;
+        }
+    private:
+        bool next_span()
+        {
+            while (index_ < spans_.size())
+            {
+                const span<const value_type>& s = spans_[index_++];
+                if (s.size() > 0)
+                {
+                    current_ = s.data();
+                    end_ = current_ + s.size();
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    using binary_span_list_source = span_list_source<uint8_t>;
+
+} // namespace jsoncons
+
+#endif
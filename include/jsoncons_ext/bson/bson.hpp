@@ -17,6 +17,7 @@
 #include <jsoncons_ext/bson/bson_encoder.hpp>
 #include <jsoncons_ext/bson/bson_reader.hpp>
 #include <jsoncons_ext/bson/bson_cursor.hpp>
+#include <jsoncons_ext/bson/bson_push_reader.hpp>
 #include <jsoncons_ext/bson/encode_bson.hpp>
 #include <jsoncons_ext/bson/decode_bson.hpp>
 
@@ -0,0 +1,58 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_BSON_BSON_PUSH_READER_HPP
+#define JSONCONS_BSON_BSON_PUSH_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/binary_push_reader.hpp>
+#include <jsoncons_ext/bson/bson_reader.hpp>
+
+namespace jsoncons { namespace bson {
+
+namespace detail {
+
+    // A BSON document starts with its length, a little endian int32 that counts itself
+    // and the terminating null
+    class bson_item_scanner
+    {
+    public:
+        void reset()
+        {
+        }
+
+        std::size_t scan(const uint8_t* data, std::size_t length)
+        {
+            if (length < 4)
+            {
+                return 0;
+            }
+            uint32_t document_length = uint32_t(data[0]) | (uint32_t(data[1]) << 8) |
+                                       (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24);
+            if (document_length < 5 || document_length > 0x7fffffff)
+            {
+                return length;
+            }
+            return document_length <= length ? document_length : 0;
+        }
+    };
+
+} // namespace detail
+
+// Decodes BSON documents pushed a chunk at a time, e.g. as they arrive on a non-blocking
+// socket. Constructed with the arguments of basic_bson_reader that follow the source.
+template <class Allocator=std::allocator<char>>
+using basic_bson_push_reader = jsoncons::detail::binary_push_reader<detail::bson_item_scanner,
+    basic_bson_reader<jsoncons::detail::push_input_source,Allocator>>;
+
+using bson_push_reader = basic_bson_push_reader<>;
+
+}}
+
+#endif
@@ -18,6 +18,8 @@
 #include <jsoncons/config/jsoncons_config.hpp>
 #include <jsoncons_ext/cbor/cbor_reader.hpp>
 #include <jsoncons_ext/cbor/cbor_cursor.hpp>
+#include <jsoncons_ext/cbor/cbor_push_reader.hpp>
+#include <jsoncons_ext/cbor/cbor_async_reader.hpp>
 #include <jsoncons_ext/cbor/cbor_encoder.hpp>
 #include <jsoncons_ext/cbor/encode_cbor.hpp>
 #include <jsoncons_ext/cbor/decode_cbor.hpp>
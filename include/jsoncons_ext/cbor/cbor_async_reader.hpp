@@ -0,0 +1,98 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CBOR_CBOR_ASYNC_READER_HPP
+#define JSONCONS_CBOR_CBOR_ASYNC_READER_HPP
+
+#include <jsoncons/config/jsoncons_config.hpp>
+
+#if defined(JSONCONS_HAS_COROUTINES)
+
+#include <memory>
+#include <system_error>
+#include <utility> // std::forward
+#include <jsoncons/json_exception.hpp>
+#include <jsoncons/async_source.hpp>
+#include <jsoncons_ext/cbor/cbor_push_reader.hpp>
+
+namespace jsoncons { namespace cbor {
+
+// basic_async_cbor_reader reads CBOR data items from a binary_async_source, reporting their
+// events to a visitor. read() suspends when the input runs dry and resumes when the producer
+// supplies more. Items are found and decoded with a basic_cbor_push_reader.
+
+template <class Allocator=std::allocator<char>>
+class basic_async_cbor_reader : public ser_context
+{
+    binary_async_source& source_;
+    basic_cbor_push_reader<Allocator> reader_;
+
+    // Noncopyable and nonmoveable
+    basic_async_cbor_reader(const basic_async_cbor_reader&) = delete;
+    basic_async_cbor_reader& operator=(const basic_async_cbor_reader&) = delete;
+public:
+    // args are the arguments of basic_cbor_reader that follow the source
+    template <class... Args>
+    basic_async_cbor_reader(binary_async_source& source, Args&&... args)
+        : source_(source), reader_(std::forward<Args>(args)...)
+    {
+    }
+
+    // Reads the next data item. Completes with true when the item has been read, and with
+    // false at the end of input. Throws ser_error if the item is not valid CBOR, or the
+    // input ends within an item.
+    async_task<bool> read()
+    {
+        std::error_code ec;
+        async_task<bool> task = read(ec);
+        bool result = co_await task;
+        if (ec)
+        {
+            JSONCONS_THROW(ser_error(ec,line(),column()));
+        }
+        co_return result;
+    }
+
+    async_task<bool> read(std::error_code& ec)
+    {
+        for (;;)
+        {
+            if (reader_.read(ec))
+            {
+                co_return true;
+            }
+            if (ec)
+            {
+                co_return false;
+            }
+            span<const uint8_t> s = co_await source_.read();
+            if (s.empty())
+            {
+                reader_.finish(ec);
+                co_return false;
+            }
+            reader_.update(s);
+        }
+    }
+
+    std::size_t line() const override
+    {
+        return reader_.line();
+    }
+
+    std::size_t column() const override
+    {
+        return reader_.column();
+    }
+};
+
+using async_cbor_reader = basic_async_cbor_reader<>;
+
+}}
+
+#endif // defined(JSONCONS_HAS_COROUTINES)
+
+#endif
@@ -1247,6 +1247,7 @@ private:
                     break;
             }
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1277,6 +1278,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint16_t));
             memcpy(v.data(),data.data(),data.size()*sizeof(uint16_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1307,6 +1309,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint32_t));
             memcpy(v.data(), data.data(), data.size()*sizeof(uint32_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1337,6 +1340,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint64_t));
             memcpy(v.data(), data.data(), data.size()*sizeof(uint64_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1365,6 +1369,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int8_t));
             memcpy(v.data(), data.data(), data.size()*sizeof(int8_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1395,6 +1400,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int16_t));
             memcpy(v.data(), data.data(), data.size()*sizeof(int16_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1425,6 +1431,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int32_t));
             memcpy(v.data(), data.data(), data.size()*sizeof(int32_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1455,6 +1462,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(int64_t));
             memcpy(v.data(), data.data(), data.size()*sizeof(int64_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1485,6 +1493,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(uint16_t));
             memcpy(v.data(),data.data(),data.size()*sizeof(uint16_t));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1515,6 +1524,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(float));
             memcpy(v.data(), data.data(), data.size()*sizeof(float));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1545,6 +1555,7 @@ private:
             std::vector<uint8_t> v(data.size()*sizeof(double));
             memcpy(v.data(), data.data(), data.size()*sizeof(double));
             write_byte_string_value(byte_string_view(v));
+            end_value();
             return true;
         }
         else
@@ -1712,14 +1723,12 @@ private:
                                double,
                                semantic_tag)
     {
-        std::cout << "write_typed_array_tag big\n";
         write_tag(0x52); // big endian
     }
     void write_typed_array_tag(std::false_type,
                                double,
                                semantic_tag)
     {
-        std::cout << "write_typed_array_tag little\n";
         write_tag(0x56);  // little endian
     }
 
@@ -0,0 +1,187 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_CBOR_CBOR_PUSH_READER_HPP
+#define JSONCONS_CBOR_CBOR_PUSH_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits> // std::numeric_limits
+#include <memory>
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/binary_push_reader.hpp>
+#include <jsoncons_ext/cbor/cbor_reader.hpp>
+
+namespace jsoncons { namespace cbor {
+
+namespace detail {
+
+    const uint64_t indefinite_item_count = (std::numeric_limits<uint64_t>::max)();
+
+    // Finds the end of a top level CBOR data item. A stack holds the number of items
+    // still to come in each open array or map, or indefinite_item_count for indefinite
+    // length arrays, maps and strings, which end with a break. Tags prefix the item they tag.
+    class cbor_item_scanner
+    {
+        std::size_t pos_;
+        std::vector<uint64_t> stack_;
+    public:
+        cbor_item_scanner()
+            : pos_(0)
+        {
+        }
+
+        void reset()
+        {
+            pos_ = 0;
+            stack_.clear();
+        }
+
+        std::size_t scan(const uint8_t* data, std::size_t length)
+        {
+            while (pos_ < length)
+            {
+                uint8_t b = data[pos_];
+                uint8_t major_type = b >> 5;
+                uint8_t info = b & 0x1f;
+
+                if (b == 0xff)
+                {
+                    if (stack_.empty() || stack_.back() != indefinite_item_count)
+                    {
+                        return length;
+                    }
+                    ++pos_;
+                    stack_.pop_back();
+                    if (end_of_item())
+                    {
+                        return pos_;
+                    }
+                    continue;
+                }
+
+                std::size_t header_length;
+                if (info < 24 || info == additional_info::indefinite_length)
+                {
+                    header_length = 1;
+                }
+                else if (info <= 27)
+                {
+                    header_length = 1 + (std::size_t(1) << (info - 24));
+                }
+                else
+                {
+                    return length;
+                }
+                if (length - pos_ < header_length)
+                {
+                    return 0;
+                }
+                uint64_t value = info;
+                if (header_length > 1)
+                {
+                    value = 0;
+                    for (std::size_t i = 1; i < header_length; ++i)
+                    {
+                        value = (value << 8) | data[pos_+i];
+                    }
+                }
+                bool is_indefinite = info == additional_info::indefinite_length;
+
+                switch (major_type)
+                {
+                    case 0x02: // byte string
+                    case 0x03: // text string
+                        if (is_indefinite)
+                        {
+                            pos_ += header_length;
+                            stack_.push_back(indefinite_item_count);
+                            continue;
+                        }
+                        if (value > length - pos_ - header_length)
+                        {
+                            return 0;
+                        }
+                        pos_ += header_length + static_cast<std::size_t>(value);
+                        break;
+                    case 0x04: // array
+                    case 0x05: // map
+                        pos_ += header_length;
+                        if (is_indefinite)
+                        {
+                            stack_.push_back(indefinite_item_count);
+                            continue;
+                        }
+                        if (major_type == 0x05)
+                        {
+                            if (value >= indefinite_item_count/2)
+                            {
+                                return length;
+                            }
+                            value *= 2;
+                        }
+                        if (value > 0)
+                        {
+                            stack_.push_back(value);
+                            continue;
+                        }
+                        break;
+                    case 0x06: // tag
+                        if (is_indefinite)
+                        {
+                            return length;
+                        }
+                        pos_ += header_length;
+                        continue;
+                    default: // integers, simple values and floats
+                        if (is_indefinite)
+                        {
+                            return length;
+                        }
+                        pos_ += header_length;
+                        break;
+                }
+                if (end_of_item())
+                {
+                    return pos_;
+                }
+            }
+            return 0;
+        }
+    private:
+        // An item has ended. Returns true if it was the top level item.
+        bool end_of_item()
+        {
+            while (!stack_.empty())
+            {
+                if (stack_.back() == indefinite_item_count)
+                {
+                    return false;
+                }
+                if (--stack_.back() > 0)
+                {
+                    return false;
+                }
+                stack_.pop_back();
+            }
+            return true;
+        }
+    };
+
+} // namespace detail
+
+// Decodes CBOR data items pushed a chunk at a time, e.g. as they arrive on a non-blocking
+// socket. Constructed with the arguments of basic_cbor_reader that follow the source.
+template <class Allocator=std::allocator<char>>
+using basic_cbor_push_reader = jsoncons::detail::binary_push_reader<detail::cbor_item_scanner,
+    basic_cbor_reader<jsoncons::detail::push_input_source,Allocator>>;
+
+using cbor_push_reader = basic_cbor_push_reader<>;
+
+}}
+
+#endif
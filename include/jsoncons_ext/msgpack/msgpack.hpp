@@ -17,6 +17,7 @@
 #include <jsoncons_ext/msgpack/msgpack_encoder.hpp>
 #include <jsoncons_ext/msgpack/msgpack_reader.hpp>
 #include <jsoncons_ext/msgpack/msgpack_cursor.hpp>
+#include <jsoncons_ext/msgpack/msgpack_push_reader.hpp>
 #include <jsoncons_ext/msgpack/encode_msgpack.hpp>
 #include <jsoncons_ext/msgpack/decode_msgpack.hpp>
 
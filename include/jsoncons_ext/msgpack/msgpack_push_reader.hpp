@@ -0,0 +1,222 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_MSGPACK_MSGPACK_PUSH_READER_HPP
+#define JSONCONS_MSGPACK_MSGPACK_PUSH_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/binary_push_reader.hpp>
+#include <jsoncons_ext/msgpack/msgpack_detail.hpp>
+#include <jsoncons_ext/msgpack/msgpack_reader.hpp>
+
+namespace jsoncons { namespace msgpack {
+
+namespace detail {
+
+    // Finds the end of a top level MessagePack object. A stack holds the number of
+    // objects still to come in each open array or map.
+    class msgpack_item_scanner
+    {
+        std::size_t pos_;
+        std::vector<uint64_t> stack_;
+    public:
+        msgpack_item_scanner()
+            : pos_(0)
+        {
+        }
+
+        void reset()
+        {
+            pos_ = 0;
+            stack_.clear();
+        }
+
+        std::size_t scan(const uint8_t* data, std::size_t length)
+        {
+            while (pos_ < length)
+            {
+                uint8_t type = data[pos_];
+
+                // The length of the header, the length of the big endian size or count
+                // at its end, and whether a payload or the items of a container follow
+                std::size_t header_length = 1;
+                std::size_t size_length = 0;
+                uint64_t size = 0;
+                bool is_container = false;
+                uint64_t count_factor = 1;
+
+                if (type <= 0x7f || type >= msgpack_format::negative_fixint_base_cd)
+                {
+                    // positive or negative fixint
+                }
+                else if (type <= 0x8f) // fixmap
+                {
+                    size = type & 0x0f;
+                    is_container = true;
+                    count_factor = 2;
+                }
+                else if (type <= 0x9f) // fixarray
+                {
+                    size = type & 0x0f;
+                    is_container = true;
+                }
+                else if (type <= 0xbf) // fixstr
+                {
+                    size = type & 0x1f;
+                }
+                else
+                {
+                    switch (type)
+                    {
+                        case msgpack_format::nil_cd:
+                        case msgpack_format::false_cd:
+                        case msgpack_format::true_cd:
+                            break;
+                        case msgpack_format::uint8_cd:
+                        case msgpack_format::int8_cd:
+                            header_length = 2;
+                            break;
+                        case msgpack_format::uint16_cd:
+                        case msgpack_format::int16_cd:
+                            header_length = 3;
+                            break;
+                        case msgpack_format::uint32_cd:
+                        case msgpack_format::int32_cd:
+                        case msgpack_format::float32_cd:
+                            header_length = 5;
+                            break;
+                        case msgpack_format::uint64_cd:
+                        case msgpack_format::int64_cd:
+                        case msgpack_format::float64_cd:
+                            header_length = 9;
+                            break;
+                        case msgpack_format::fixext1_cd:
+                            header_length = 3;
+                            break;
+                        case msgpack_format::fixext2_cd:
+                            header_length = 4;
+                            break;
+                        case msgpack_format::fixext4_cd:
+                            header_length = 6;
+                            break;
+                        case msgpack_format::fixext8_cd:
+                            header_length = 10;
+                            break;
+                        case msgpack_format::fixext16_cd:
+                            header_length = 18;
+                            break;
+                        case msgpack_format::str8_cd:
+                        case msgpack_format::bin8_cd:
+                            size_length = 1;
+                            break;
+                        case msgpack_format::str16_cd:
+                        case msgpack_format::bin16_cd:
+                            size_length = 2;
+                            break;
+                        case msgpack_format::str32_cd:
+                        case msgpack_format::bin32_cd:
+                            size_length = 4;
+                            break;
+                        case msgpack_format::ext8_cd: // size, then type
+                            size_length = 1;
+                            header_length = 3;
+                            break;
+                        case msgpack_format::ext16_cd:
+                            size_length = 2;
+                            header_length = 4;
+                            break;
+                        case msgpack_format::ext32_cd:
+                            size_length = 4;
+                            header_length = 6;
+                            break;
+                        case msgpack_format::array16_cd:
+                            size_length = 2;
+                            is_container = true;
+                            break;
+                        case msgpack_format::array32_cd:
+                            size_length = 4;
+                            is_container = true;
+                            break;
+                        case msgpack_format::map16_cd:
+                            size_length = 2;
+                            is_container = true;
+                            count_factor = 2;
+                            break;
+                        case msgpack_format::map32_cd:
+                            size_length = 4;
+                            is_container = true;
+                            count_factor = 2;
+                            break;
+                        default:
+                            return length;
+                    }
+                    if (size_length > 0 && header_length == 1)
+                    {
+                        header_length = 1 + size_length;
+                    }
+                }
+                if (length - pos_ < header_length)
+                {
+                    return 0;
+                }
+                for (std::size_t i = 1; i <= size_length; ++i)
+                {
+                    size = (size << 8) | data[pos_+i];
+                }
+
+                if (is_container)
+                {
+                    pos_ += header_length;
+                    if (size > 0)
+                    {
+                        stack_.push_back(size*count_factor);
+                        continue;
+                    }
+                }
+                else
+                {
+                    if (size > length - pos_ - header_length)
+                    {
+                        return 0;
+                    }
+                    pos_ += header_length + static_cast<std::size_t>(size);
+                }
+
+                // An object has ended
+                while (!stack_.empty())
+                {
+                    if (--stack_.back() > 0)
+                    {
+                        break;
+                    }
+                    stack_.pop_back();
+                }
+                if (stack_.empty())
+                {
+                    return pos_;
+                }
+            }
+            return 0;
+        }
+    };
+
+} // namespace detail
+
+// Decodes MessagePack objects pushed a chunk at a time, e.g. as they arrive on a non-blocking
+// socket. Constructed with the arguments of basic_msgpack_reader that follow the source.
+template <class Allocator=std::allocator<char>>
+using basic_msgpack_push_reader = jsoncons::detail::binary_push_reader<detail::msgpack_item_scanner,
+    basic_msgpack_reader<jsoncons::detail::push_input_source,Allocator>>;
+
+using msgpack_push_reader = basic_msgpack_push_reader<>;
+
+}}
+
+#endif
@@ -17,6 +17,7 @@
 #include <jsoncons_ext/ubjson/ubjson_encoder.hpp>
 #include <jsoncons_ext/ubjson/ubjson_reader.hpp>
 #include <jsoncons_ext/ubjson/ubjson_cursor.hpp>
+#include <jsoncons_ext/ubjson/ubjson_push_reader.hpp>
 #include <jsoncons_ext/ubjson/encode_ubjson.hpp>
 #include <jsoncons_ext/ubjson/decode_ubjson.hpp>
 
@@ -0,0 +1,344 @@
+// Copyright 2020 Daniel Parker
+// Distributed under the Boost license, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// See https://github.com/danielaparker/jsoncons for latest version
+
+#ifndef JSONCONS_UBJSON_UBJSON_PUSH_READER_HPP
+#define JSONCONS_UBJSON_UBJSON_PUSH_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <jsoncons/config/jsoncons_config.hpp>
+#include <jsoncons/detail/binary_push_reader.hpp>
+#include <jsoncons_ext/ubjson/ubjson_detail.hpp>
+#include <jsoncons_ext/ubjson/ubjson_reader.hpp>
+
+namespace jsoncons { namespace ubjson {
+
+namespace detail {
+
+    // Finds the end of a top level UBJSON value. A stack holds the open arrays and
+    // objects, with the number of values still to come in those with a count, and the
+    // type of the values in those with a type. Each step scans a whole value, key or
+    // container header, or nothing if its bytes have not all arrived.
+    class ubjson_item_scanner
+    {
+        enum class scan_status {ok, more, invalid};
+
+        struct frame
+        {
+            bool is_object;
+            bool has_count;
+            bool key_next;
+            uint8_t type;
+            uint64_t count;
+        };
+
+        std::size_t pos_;
+        std::vector<frame> stack_;
+    public:
+        ubjson_item_scanner()
+            : pos_(0)
+        {
+        }
+
+        void reset()
+        {
+            pos_ = 0;
+            stack_.clear();
+        }
+
+        std::size_t scan(const uint8_t* data, std::size_t length)
+        {
+            for (;;)
+            {
+                std::size_t p = pos_;
+                uint8_t type;
+                if (!stack_.empty())
+                {
+                    frame& f = stack_.back();
+                    if (f.has_count && f.count == 0)
+                    {
+                        if (end_of_container())
+                        {
+                            return pos_;
+                        }
+                        continue;
+                    }
+                    if (f.is_object && f.key_next)
+                    {
+                        if (p >= length)
+                        {
+                            return 0;
+                        }
+                        if (!f.has_count && data[p] == ubjson_format::end_object_marker)
+                        {
+                            pos_ = p + 1;
+                            if (end_of_container())
+                            {
+                                return pos_;
+                            }
+                            continue;
+                        }
+                        std::size_t n = 0;
+                        switch (scan_string(data, length, p, n))
+                        {
+                            case scan_status::more:
+                                return 0;
+                            case scan_status::invalid:
+                                return length;
+                            default:
+                                break;
+                        }
+                        pos_ = p + n;
+                        f.key_next = false;
+                        continue;
+                    }
+                    if (f.type != 0)
+                    {
+                        type = f.type;
+                    }
+                    else
+                    {
+                        if (p >= length)
+                        {
+                            return 0;
+                        }
+                        type = data[p++];
+                        if (!f.is_object && !f.has_count && type == ubjson_format::end_array_marker)
+                        {
+                            pos_ = p;
+                            if (end_of_container())
+                            {
+                                return pos_;
+                            }
+                            continue;
+                        }
+                    }
+                }
+                else
+                {
+                    if (p >= length)
+                    {
+                        return 0;
+                    }
+                    type = data[p++];
+                }
+
+                std::size_t n = 0;
+                switch (type)
+                {
+                    case ubjson_format::null_type:
+                    case ubjson_format::no_op_type:
+                    case ubjson_format::true_type:
+                    case ubjson_format::false_type:
+                        break;
+                    case ubjson_format::int8_type:
+                    case ubjson_format::uint8_type:
+                    case ubjson_format::char_type:
+                        n = 1;
+                        break;
+                    case ubjson_format::int16_type:
+                        n = 2;
+                        break;
+                    case ubjson_format::int32_type:
+                    case ubjson_format::float32_type:
+                        n = 4;
+                        break;
+                    case ubjson_format::int64_type:
+                    case ubjson_format::float64_type:
+                        n = 8;
+                        break;
+                    case ubjson_format::string_type:
+                    case ubjson_format::high_precision_number_type:
+                        switch (scan_string(data, length, p, n))
+                        {
+                            case scan_status::more:
+                                return 0;
+                            case scan_status::invalid:
+                                return length;
+                            default:
+                                break;
+                        }
+                        break;
+                    case ubjson_format::start_array_marker:
+                    case ubjson_format::start_object_marker:
+                    {
+                        frame f{type == ubjson_format::start_object_marker, false, true, 0, 0};
+                        switch (scan_container_header(data, length, p, f, n))
+                        {
+                            case scan_status::more:
+                                return 0;
+                            case scan_status::invalid:
+                                return length;
+                            default:
+                                break;
+                        }
+                        pos_ = p + n;
+                        stack_.push_back(f);
+                        continue;
+                    }
+                    default:
+                        return length;
+                }
+                if (n > length - p)
+                {
+                    return 0;
+                }
+                pos_ = p + n;
+                if (end_of_value())
+                {
+                    return pos_;
+                }
+            }
+        }
+    private:
+        // A value has ended. Returns true if it was the top level value.
+        bool end_of_value()
+        {
+            if (stack_.empty())
+            {
+                return true;
+            }
+            frame& f = stack_.back();
+            if (f.has_count)
+            {
+                --f.count;
+            }
+            f.key_next = true;
+            return false;
+        }
+
+        bool end_of_container()
+        {
+            stack_.pop_back();
+            return end_of_value();
+        }
+
+        // A length or count, an integer with its type marker
+        static scan_status scan_length(const uint8_t* data, std::size_t length, std::size_t p,
+                                       uint64_t& value, std::size_t& n)
+        {
+            if (p >= length)
+            {
+                return scan_status::more;
+            }
+            std::size_t size;
+            bool is_signed = true;
+            switch (data[p])
+            {
+                case ubjson_format::int8_type:
+                    size = 1;
+                    break;
+                case ubjson_format::uint8_type:
+                    size = 1;
+                    is_signed = false;
+                    break;
+                case ubjson_format::int16_type:
+                    size = 2;
+                    break;
+                case ubjson_format::int32_type:
+                    size = 4;
+                    break;
+                case ubjson_format::int64_type:
+                    size = 8;
+                    break;
+                default:
+                    return scan_status::invalid;
+            }
+            if (length - p - 1 < size)
+            {
+                return scan_status::more;
+            }
+            if (is_signed && (data[p+1] & 0x80))
+            {
+                return scan_status::invalid;
+            }
+            value = 0;
+            for (std::size_t i = 1; i <= size; ++i)
+            {
+                value = (value << 8) | data[p+i];
+            }
+            n = 1 + size;
+            return scan_status::ok;
+        }
+
+        // A string without its type marker, as in a key or after S or H
+        static scan_status scan_string(const uint8_t* data, std::size_t length, std::size_t p, std::size_t& n)
+        {
+            uint64_t string_length = 0;
+            std::size_t len = 0;
+            scan_status status = scan_length(data, length, p, string_length, len);
+            if (status != scan_status::ok)
+            {
+                return status;
+            }
+            if (string_length > length - p - len)
+            {
+                return scan_status::more;
+            }
+            n = len + static_cast<std::size_t>(string_length);
+            return scan_status::ok;
+        }
+
+        // The optional type and count after [ or {
+        static scan_status scan_container_header(const uint8_t* data, std::size_t length, std::size_t p,
+                                                 frame& f, std::size_t& n)
+        {
+            if (p >= length)
+            {
+                return scan_status::more;
+            }
+            std::size_t q = p;
+            if (data[q] == ubjson_format::type_marker)
+            {
+                if (length - q < 3)
+                {
+                    return scan_status::more;
+                }
+                if (data[q+2] != ubjson_format::count_marker)
+                {
+                    return scan_status::invalid;
+                }
+                f.type = data[q+1];
+                q += 2;
+            }
+            if (data[q] == ubjson_format::count_marker)
+            {
+                std::size_t len = 0;
+                scan_status status = scan_length(data, length, q+1, f.count, len);
+                if (status != scan_status::ok)
+                {
+                    return status;
+                }
+                f.has_count = true;
+                q += 1 + len;
+
+                // Values of these types have no bytes
+                if (!f.is_object && (f.type == ubjson_format::null_type || f.type == ubjson_format::no_op_type ||
+                                     f.type == ubjson_format::true_type || f.type == ubjson_format::false_type))
+                {
+                    f.count = 0;
+                }
+            }
+            n = q - p;
+            return scan_status::ok;
+        }
+    };
+
+} // namespace detail
+
+// Decodes UBJSON values pushed a chunk at a time, e.g. as they arrive on a non-blocking
+// socket. Constructed with the arguments of basic_ubjson_reader that follow the source.
+template <class Allocator=std::allocator<char>>
+using basic_ubjson_push_reader = jsoncons::detail::binary_push_reader<detail::ubjson_item_scanner,
+    basic_ubjson_reader<jsoncons::detail::push_input_source,Allocator>>;
+
+using ubjson_push_reader = basic_ubjson_push_reader<>;
+
+}}
+
+#endif
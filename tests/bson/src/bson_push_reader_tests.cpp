@@ -0,0 +1,59 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/bson/bson.hpp>
+#include <catch/catch.hpp>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("bson_push_reader tests")
+{
+    std::vector<json> expected;
+    expected.push_back(json::parse(R"({"name" : "Haruki Murakami", "values" : [1.5, -1234567890123, true, null, "😀"], "n" : 123456})"));
+    expected.push_back(json::parse(R"({"a" : {"b" : []}})"));
+    expected.push_back(json(json_object_arg));
+
+    std::vector<uint8_t> data;
+    for (const auto& item : expected)
+    {
+        bson::encode_bson(item, data);
+    }
+
+    SECTION("chunks of every length")
+    {
+        for (std::size_t length : {1, 3, 4, 5, 1000})
+        {
+            INFO(length);
+            std::vector<json> items;
+            json_decoder<json> decoder;
+            bson::bson_push_reader reader(decoder);
+
+            for (std::size_t i = 0; i < data.size(); i += length)
+            {
+                reader.update(data.data() + i, (std::min)(length, data.size() - i));
+                while (reader.read())
+                {
+                    items.push_back(decoder.get_result());
+                }
+            }
+            reader.finish();
+            CHECK(items == expected);
+        }
+    }
+
+    SECTION("truncated document")
+    {
+        std::error_code ec;
+        json_decoder<json> decoder;
+        bson::bson_push_reader reader(decoder);
+        reader.update(data.data(), 10);
+        CHECK_FALSE(reader.read(ec));
+        reader.finish(ec);
+        CHECK(ec == bson::bson_errc::unexpected_eof);
+    }
+}
@@ -0,0 +1,106 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("cbor_push_reader tests")
+{
+    std::vector<json> expected;
+    expected.push_back(json::parse(R"({"name" : "Haruki Murakami", "values" : [1.5, -12345678901234567890, true, null, "😀"], "n" : 123456})"));
+    expected.push_back(json(byte_string{'H','e','l','l','o'}));
+    expected.push_back(json("2020-10-18T12:00:00Z", semantic_tag::datetime));
+    expected.push_back(json(json_array_arg, {json(json_array_arg), json(json_object_arg), json(std::string(300, 'x'))}));
+    expected.push_back(json(10));
+
+    std::vector<uint8_t> data;
+    for (const auto& item : expected)
+    {
+        cbor::encode_cbor(item, data);
+    }
+    // An indefinite length map holding an indefinite length array and an indefinite length string
+    std::vector<uint8_t> indefinite = {0xbf,0x61,'a',0x9f,0x01,0x02,0xff,0x61,'b',0x7f,0x62,'c','d',0x61,'e',0xff,0xff};
+    data.insert(data.end(), indefinite.begin(), indefinite.end());
+    expected.push_back(json::parse(R"({"a":[1,2],"b":"cde"})"));
+
+    SECTION("chunks of every length")
+    {
+        for (std::size_t length : {1, 2, 3, 7, 64, 100000})
+        {
+            INFO(length);
+            std::vector<json> items;
+            json_decoder<json> decoder;
+            cbor::cbor_push_reader reader(decoder);
+
+            for (std::size_t i = 0; i < data.size(); i += length)
+            {
+                reader.update(data.data() + i, (std::min)(length, data.size() - i));
+                while (reader.read())
+                {
+                    items.push_back(decoder.get_result());
+                }
+            }
+            reader.finish();
+            CHECK(reader.buffered() == 0);
+            CHECK(items == expected);
+        }
+    }
+
+    SECTION("items are decoded as soon as their last byte arrives")
+    {
+        std::vector<uint8_t> item;
+        cbor::encode_cbor(expected[0], item);
+
+        json_decoder<json> decoder;
+        cbor::cbor_push_reader reader(decoder);
+        for (std::size_t i = 0; i + 1 < item.size(); ++i)
+        {
+            reader.update(item.data() + i, 1);
+            CHECK_FALSE(reader.read());
+        }
+        CHECK(reader.buffered() == item.size() - 1);
+        reader.update(item.data() + item.size() - 1, 1);
+        CHECK(reader.read());
+        CHECK(decoder.get_result() == expected[0]);
+        CHECK(reader.buffered() == 0);
+        CHECK_FALSE(reader.read());
+    }
+
+    SECTION("truncated item")
+    {
+        std::vector<uint8_t> item;
+        cbor::encode_cbor(expected[0], item);
+
+        json_decoder<json> decoder;
+        cbor::cbor_push_reader reader(decoder);
+        reader.update(item.data(), item.size() / 2);
+        std::error_code ec;
+        CHECK_FALSE(reader.read(ec));
+        CHECK_FALSE(ec);
+        reader.finish(ec);
+        CHECK(ec == cbor::cbor_errc::unexpected_eof);
+    }
+
+    SECTION("invalid byte")
+    {
+        std::vector<uint8_t> bytes = {0x01,0x82,0x01,0xfc};
+
+        json_decoder<json> decoder;
+        cbor::cbor_push_reader reader(decoder);
+        reader.update(bytes.data(), bytes.size());
+        std::error_code ec;
+        CHECK(reader.read(ec));
+        CHECK(decoder.get_result() == json(1));
+        CHECK_FALSE(reader.read(ec));
+        CHECK(ec);
+        CHECK(reader.buffered() == 0);
+    }
+}
+
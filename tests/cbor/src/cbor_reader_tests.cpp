@@ -734,3 +734,79 @@ TEST_CASE("CBOR stringref tag 3")
 
     CHECK(j == expected);
 }
+
+namespace {
+
+    // A streambuf over a string that cannot seek, like a pipe or a socket
+    class unseekable_streambuf : public std::streambuf
+    {
+        std::string s_;
+    public:
+        unseekable_streambuf(const std::string& s)
+            : s_(s)
+        {
+            setg(&s_[0], &s_[0], &s_[0] + s_.size());
+        }
+    };
+}
+
+TEST_CASE("cbor buffered_binary_stream_source")
+{
+    json expected;
+    expected.try_emplace("name", std::string(100, 'x'));
+    expected.try_emplace("bytes", byte_string(std::vector<uint8_t>(40000, 0x7f).data(), 40000));
+    expected.try_emplace("values", json(json_array_arg, {json(1), json(-1000000), json(2.5), json("abc")}));
+    std::vector<uint8_t> data;
+    encode_cbor(expected, data);
+    std::string s(data.begin(), data.end());
+
+    SECTION("buffer lengths")
+    {
+        for (std::size_t length : {1, 2, 7, 100, 16384, 100000})
+        {
+            INFO(length);
+            std::istringstream is(s);
+            json_decoder<json> decoder;
+            basic_cbor_reader<buffered_binary_stream_source> reader(buffered_binary_stream_source(is, length), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+
+    SECTION("stream is left after the item read")
+    {
+        std::istringstream is(s + s);
+        for (int i = 0; i < 2; ++i)
+        {
+            json_decoder<json> decoder;
+            basic_cbor_reader<buffered_binary_stream_source> reader(buffered_binary_stream_source(is), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == expected);
+        }
+        CHECK(is.good());
+    }
+
+    SECTION("stream that cannot seek")
+    {
+        unseekable_streambuf buf(s + s);
+        std::istream is(&buf);
+        {
+            json_decoder<json> decoder;
+            basic_cbor_reader<buffered_binary_stream_source> reader(buffered_binary_stream_source(is), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == expected);
+        }
+        CHECK(is.fail());
+    }
+
+    SECTION("truncated input")
+    {
+        std::istringstream is(s.substr(0, s.size() - 1));
+        json_decoder<json> decoder;
+        basic_cbor_reader<buffered_binary_stream_source> reader(buffered_binary_stream_source(is), decoder);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == cbor_errc::unexpected_eof);
+    }
+}
+
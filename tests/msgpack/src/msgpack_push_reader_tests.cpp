@@ -0,0 +1,75 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <catch/catch.hpp>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("msgpack_push_reader tests")
+{
+    std::vector<json> expected;
+    expected.push_back(json::parse(R"({"name" : "Haruki Murakami", "values" : [1.5, -1234567890123, true, null, "😀"], "n" : 123456})"));
+    std::vector<uint8_t> bytes(300, 'b');
+    expected.push_back(json(byte_string_view(bytes.data(), bytes.size())));
+    expected.push_back(json(json_array_arg, {json(json_array_arg), json(json_object_arg), json(std::string(70000, 'x'))}));
+    expected.push_back(json(-10));
+    json large(json_array_arg);
+    for (int i = 0; i < 20; ++i)
+    {
+        large.push_back(json(i*1000000000LL));
+    }
+    expected.push_back(large);
+
+    std::vector<uint8_t> data;
+    for (const auto& item : expected)
+    {
+        msgpack::encode_msgpack(item, data);
+    }
+    // A timestamp extension
+    std::vector<uint8_t> timestamp = {0xd6,0xff,0x5a,0x4a,0xf6,0xa5};
+    data.insert(data.end(), timestamp.begin(), timestamp.end());
+    expected.push_back(json(1514862245, semantic_tag::epoch_second));
+
+    SECTION("chunks of every length")
+    {
+        for (std::size_t length : {1, 2, 5, 1000, 1000000})
+        {
+            INFO(length);
+            std::vector<json> items;
+            json_decoder<json> decoder;
+            msgpack::msgpack_push_reader reader(decoder);
+
+            for (std::size_t i = 0; i < data.size(); i += length)
+            {
+                reader.update(data.data() + i, (std::min)(length, data.size() - i));
+                while (reader.read())
+                {
+                    items.push_back(decoder.get_result());
+                }
+            }
+            reader.finish();
+            CHECK(items == expected);
+        }
+    }
+
+    SECTION("truncated item")
+    {
+        std::vector<uint8_t> item;
+        msgpack::encode_msgpack(expected[0], item);
+
+        json_decoder<json> decoder;
+        msgpack::msgpack_push_reader reader(decoder);
+        reader.update(item.data(), item.size() - 1);
+        std::error_code ec;
+        CHECK_FALSE(reader.read(ec));
+        CHECK(reader.buffered() == item.size() - 1);
+        reader.finish(ec);
+        CHECK(ec == msgpack::msgpack_errc::unexpected_eof);
+    }
+}
@@ -0,0 +1,217 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/async_json_reader.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+#if defined(JSONCONS_HAS_COROUTINES)
+
+using namespace jsoncons;
+
+namespace {
+
+    async_task<> read_all(async_json_reader& reader, json_decoder<json>& decoder, std::vector<json>& items)
+    {
+        for (;;)
+        {
+            auto more = reader.read();
+            if (!co_await more)
+            {
+                break;
+            }
+            items.push_back(decoder.get_result());
+        }
+    }
+}
+
+TEST_CASE("async_json_reader tests")
+{
+    std::string input = R"({"name" : "Haruki \"Murakami\"", "values" : [1.5e10, -1234, true, null]} 123 "abc" [1,2])";
+    std::vector<json> expected = {json::parse(R"({"name" : "Haruki \"Murakami\"", "values" : [1.5e10, -1234, true, null]})"),
+                                  json(123), json("abc"), json::parse("[1,2]")};
+
+    SECTION("chunks of every length")
+    {
+        for (std::size_t length : {1, 2, 5, 1000})
+        {
+            INFO(length);
+            async_source source;
+            json_decoder<json> decoder;
+            async_json_reader reader(source, decoder);
+            std::vector<json> items;
+
+            auto task = read_all(reader, decoder, items);
+            for (std::size_t i = 0; i < input.size(); i += length)
+            {
+                CHECK(source.waiting());
+                CHECK_FALSE(task.done());
+                source.update(input.data() + i, (std::min)(length, input.size() - i));
+            }
+            source.close();
+            REQUIRE(task.done());
+            task.get();
+            CHECK(items == expected);
+        }
+    }
+
+    SECTION("a text completes without waiting for more input")
+    {
+        std::string text = R"({"a" : [1,2]})";
+        async_source source;
+        json_decoder<json> decoder;
+        async_json_reader reader(source, decoder);
+
+        auto task = reader.read();
+        source.update(text.data(), text.size());
+        REQUIRE(task.done());
+        CHECK(task.get());
+        CHECK(decoder.get_result() == json::parse(text));
+    }
+
+    SECTION("many parses on one thread")
+    {
+        const std::size_t count = 1000;
+        std::vector<std::unique_ptr<async_source>> sources;
+        std::vector<std::unique_ptr<json_decoder<json>>> decoders;
+        std::vector<std::unique_ptr<async_json_reader>> readers;
+        std::vector<async_task<bool>> tasks;
+        std::vector<std::string> texts;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sources.push_back(std::unique_ptr<async_source>(new async_source()));
+            decoders.push_back(std::unique_ptr<json_decoder<json>>(new json_decoder<json>()));
+            readers.push_back(std::unique_ptr<async_json_reader>(new async_json_reader(*sources.back(), *decoders.back())));
+            tasks.push_back(readers.back()->read());
+            texts.push_back(R"({"id" : )" + std::to_string(i) + R"(, "tags" : ["a", "b"]})");
+        }
+        // Feed every parse one character at a time, in turn
+        for (std::size_t pos = 0; pos < texts.back().size(); ++pos)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (pos < texts[i].size())
+                {
+                    sources[i]->update(texts[i].data() + pos, 1);
+                }
+            }
+        }
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            REQUIRE(tasks[i].done());
+            CHECK(tasks[i].get());
+            CHECK(decoders[i]->get_result()["id"].as<std::size_t>() == i);
+        }
+    }
+
+    SECTION("invalid JSON")
+    {
+        std::string text = R"({"a" : [1,2}})";
+        async_source source;
+        json_decoder<json> decoder;
+        async_json_reader reader(source, decoder);
+
+        auto task = reader.read();
+        source.update(text.data(), text.size());
+        REQUIRE(task.done());
+        CHECK_THROWS_AS(task.get(), ser_error);
+
+        std::error_code ec;
+        async_source source2;
+        async_json_reader reader2(source2, decoder);
+        auto task2 = reader2.read(ec);
+        source2.update(text.data(), 5);
+        source2.close();
+        REQUIRE(task2.done());
+        CHECK_FALSE(task2.get());
+        CHECK(ec == json_errc::unexpected_eof);
+    }
+}
+
+TEST_CASE("async_json_cursor tests")
+{
+    std::string input = R"({"a" : [1,"two"], "b" : null})";
+
+    async_source source;
+    async_json_cursor cursor(source);
+    std::vector<staj_event_type> events;
+    std::vector<std::string> keys;
+
+    auto consume = [&]() -> async_task<>
+    {
+        for (;;)
+        {
+            auto more = cursor.next();
+            if (!co_await more)
+            {
+                break;
+            }
+            events.push_back(cursor.current().event_type());
+            if (cursor.current().event_type() == staj_event_type::key)
+            {
+                keys.push_back(cursor.current().get<std::string>());
+            }
+        }
+    };
+    auto task = consume();
+    for (std::size_t i = 0; i < input.size(); i += 3)
+    {
+        source.update(input.data() + i, (std::min)(std::size_t(3), input.size() - i));
+    }
+    REQUIRE(task.done());
+    task.get();
+    CHECK(cursor.done());
+    CHECK((keys == std::vector<std::string>{"a", "b"}));
+    CHECK((events == std::vector<staj_event_type>{staj_event_type::begin_object, staj_event_type::key,
+                                                   staj_event_type::begin_array, staj_event_type::uint64_value,
+                                                   staj_event_type::string_value, staj_event_type::end_array,
+                                                   staj_event_type::key, staj_event_type::null_value,
+                                                   staj_event_type::end_object}));
+}
+
+TEST_CASE("async_cbor_reader tests")
+{
+    std::vector<json> expected = {json::parse(R"({"a" : [1,2,"three"], "b" : -1.5})"), json("abc"), json(10)};
+    std::vector<uint8_t> data;
+    for (const auto& item : expected)
+    {
+        cbor::encode_cbor(item, data);
+    }
+
+    binary_async_source source;
+    json_decoder<json> decoder;
+    cbor::async_cbor_reader reader(source, decoder);
+    std::vector<json> items;
+
+    auto consume = [&]() -> async_task<>
+    {
+        for (;;)
+        {
+            auto more = reader.read();
+            if (!co_await more)
+            {
+                break;
+            }
+            items.push_back(decoder.get_result());
+        }
+    };
+    auto task = consume();
+    for (std::size_t i = 0; i < data.size(); i += 4)
+    {
+        source.update(data.data() + i, (std::min)(std::size_t(4), data.size() - i));
+    }
+    CHECK(items == expected);
+    CHECK_FALSE(task.done());
+    source.close();
+    REQUIRE(task.done());
+    task.get();
+}
+
+#endif // defined(JSONCONS_HAS_COROUTINES)
+
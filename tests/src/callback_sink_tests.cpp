@@ -0,0 +1,131 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/callback_sink.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    // Keeps the buffers handed over, and serves new buffers from those "written"
+    // more than two hand overs ago, as an asynchronous writer would return them
+    template <class T>
+    struct buffer_pool
+    {
+        std::vector<T> output;
+        std::vector<std::vector<T>> pending;
+        std::vector<std::vector<T>> free_buffers;
+        std::size_t writes = 0;
+        std::size_t allocations = 0;
+        std::size_t max_length = 0;
+
+        void write(std::vector<T>&& buffer)
+        {
+            ++writes;
+            max_length = (std::max)(max_length, buffer.size());
+            pending.push_back(std::move(buffer));
+            if (pending.size() > 2)
+            {
+                output.insert(output.end(), pending.front().begin(), pending.front().end());
+                free_buffers.push_back(std::move(pending.front()));
+                pending.erase(pending.begin());
+            }
+        }
+
+        std::vector<T> acquire()
+        {
+            if (free_buffers.empty())
+            {
+                ++allocations;
+                return std::vector<T>();
+            }
+            std::vector<T> buffer = std::move(free_buffers.back());
+            free_buffers.pop_back();
+            return buffer;
+        }
+
+        void drain()
+        {
+            for (auto& buffer : pending)
+            {
+                output.insert(output.end(), buffer.begin(), buffer.end());
+            }
+            pending.clear();
+        }
+    };
+}
+
+TEST_CASE("callback_sink tests")
+{
+    json expected(json_array_arg);
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        json item;
+        item.try_emplace("id", i);
+        item.try_emplace("name", "name-" + std::to_string(i) + std::string(i % 50, 'x'));
+        item.try_emplace("values", json(json_array_arg, {json(i * 0.5), json(true), json(null_type())}));
+        expected.push_back(std::move(item));
+    }
+
+    SECTION("json encoder with a buffer pool")
+    {
+        std::string text;
+        expected.dump(text);
+
+        buffer_pool<char> pool;
+        {
+            callback_sink<char> sink([&pool](std::vector<char>&& buffer) {pool.write(std::move(buffer));},
+                                     [&pool]() {return pool.acquire();},
+                                     1000);
+            basic_compact_json_encoder<char,callback_sink<char>> encoder{std::move(sink)};
+            expected.dump(encoder);
+        }
+        pool.drain();
+
+        CHECK(std::string(pool.output.begin(), pool.output.end()) == text);
+        CHECK(pool.writes == (text.size() + 999) / 1000);
+        CHECK(pool.max_length == 1000);
+        CHECK(pool.allocations == 3);
+    }
+
+    SECTION("cbor encoder")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(expected, data);
+
+        std::vector<uint8_t> output;
+        std::size_t writes = 0;
+        {
+            cbor::basic_cbor_encoder<callback_sink<uint8_t>> encoder{callback_sink<uint8_t>(
+                [&](std::vector<uint8_t>&& buffer) {++writes; output.insert(output.end(), buffer.begin(), buffer.end());},
+                128)};
+            expected.dump(encoder);
+        }
+        CHECK(output == data);
+        CHECK(writes == (data.size() + 127) / 128);
+    }
+
+    SECTION("flush hands over a partly filled buffer")
+    {
+        std::vector<std::string> buffers;
+        callback_sink<char> sink([&](std::vector<char>&& buffer) {buffers.emplace_back(buffer.begin(), buffer.end());}, 4);
+        sink.append("abcdef", 6);
+        CHECK(buffers.size() == 1);
+        sink.flush();
+        CHECK(buffers.size() == 2);
+        sink.flush();
+        CHECK(buffers.size() == 2);
+        sink.push_back('g');
+        sink.flush();
+        CHECK((buffers == std::vector<std::string>{"abcd", "ef", "g"}));
+    }
+}
+
@@ -0,0 +1,135 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if !defined(_WIN32)
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/fd_source.hpp>
+#include <jsoncons/fd_sink.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <unistd.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    // Runs write_to(fd) on a thread feeding one end of a pipe while read_from(fd)
+    // drains the other, so that output larger than the pipe capacity does not block
+    template <class Writer, class Reader>
+    void through_pipe(Writer write_to, Reader read_from)
+    {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        std::thread writer([&]()
+        {
+            write_to(fds[1]);
+            ::close(fds[1]);
+        });
+        read_from(fds[0]);
+        writer.join();
+        ::close(fds[0]);
+    }
+
+    json make_doc()
+    {
+        json doc(json_array_arg);
+        for (std::size_t i = 0; i < 5000; ++i)
+        {
+            json item;
+            item.try_emplace("id", i);
+            item.try_emplace("name", "name-" + std::to_string(i));
+            item.try_emplace("values", json(json_array_arg, {json(i * 0.5), json(true), json(null_type())}));
+            doc.push_back(std::move(item));
+        }
+        return doc;
+    }
+}
+
+TEST_CASE("fd_source and fd_sink tests")
+{
+    json expected = make_doc();
+
+    SECTION("json")
+    {
+        for (std::size_t length : {1, 3, 100, 16384})
+        {
+            INFO(length);
+            json_decoder<json> decoder;
+            through_pipe([&](int fd)
+                {
+                    basic_json_encoder<char,fd_sink<char>> encoder{fd_sink<char>(fd, length)};
+                    expected.dump(encoder);
+                },
+                [&](int fd)
+                {
+                    basic_json_reader<char,fd_source<char>> reader(fd_source<char>(fd, length), decoder);
+                    reader.read();
+                });
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+
+    SECTION("cbor")
+    {
+        json_decoder<json> decoder;
+        through_pipe([&](int fd)
+            {
+                cbor::basic_cbor_encoder<binary_fd_sink> encoder{binary_fd_sink(fd)};
+                expected.dump(encoder);
+            },
+            [&](int fd)
+            {
+                cbor::basic_cbor_reader<binary_fd_source> reader(binary_fd_source(fd, 7), decoder);
+                reader.read();
+            });
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("character access")
+    {
+        std::error_code sink_ec;
+        through_pipe([&](int fd)
+            {
+                fd_sink<char> sink(fd, 2);
+                sink.append("abcdef", 6);
+                sink.push_back('g');
+                sink.flush();
+                sink_ec = sink.error();
+            },
+            [&](int fd)
+            {
+                fd_source<char> source(fd, 2);
+                CHECK(source.peek_character().value() == 'a');
+                CHECK(source.get_character().value() == 'a');
+                source.ignore(3);
+                char buf[10];
+                CHECK(source.read(buf, 10) == 3);
+                CHECK(std::string(buf, 3) == "efg");
+                CHECK(source.eof());
+                CHECK_FALSE(source.get_character());
+                CHECK(source.position() == 7);
+                CHECK_FALSE(source.is_error());
+            });
+        CHECK_FALSE(sink_ec);
+    }
+
+    SECTION("errors")
+    {
+        fd_source<char> source(-1);
+        json_decoder<json> decoder;
+        basic_json_reader<char,fd_source<char>> reader(std::move(source), decoder);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == json_errc::source_error);
+
+        fd_sink<char> sink(-1, 4);
+        sink.append("abcdef", 6);
+        CHECK(sink.error() == std::errc::bad_file_descriptor);
+    }
+}
+
+#endif
@@ -0,0 +1,190 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+
+using namespace jsoncons;
+
+using hjson = basic_json<char,hash_index_policy,std::allocator<char>>;
+
+namespace {
+
+    std::string make_object_text(std::size_t count)
+    {
+        std::string s = "{";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                s.push_back(',');
+            }
+            s += "\"key" + std::to_string(i) + "\":" + std::to_string(i);
+        }
+        s.push_back('}');
+        return s;
+    }
+
+    void check_same(const hjson& j, const std::vector<std::pair<std::string,int>>& expected)
+    {
+        REQUIRE(j.size() == expected.size());
+        std::size_t i = 0;
+        for (const auto& member : j.object_range())
+        {
+            CHECK(member.key() == expected[i].first);
+            CHECK(member.value().as<int>() == expected[i].second);
+            ++i;
+        }
+        for (const auto& item : expected)
+        {
+            auto it = j.find(item.first);
+            REQUIRE(bool(it != j.object_range().end()));
+            CHECK(it->value().as<int>() == item.second);
+        }
+    }
+}
+
+TEST_CASE("hash_index_policy parse")
+{
+    for (std::size_t count : {0, 1, 16, 17, 1000})
+    {
+        INFO(count);
+        hjson j = hjson::parse(make_object_text(count));
+        REQUIRE(j.size() == count);
+
+        std::size_t i = 0;
+        for (const auto& member : j.object_range())
+        {
+            CHECK(member.key() == "key" + std::to_string(i));
+            CHECK(member.value().as<std::size_t>() == i);
+            ++i;
+        }
+        for (i = 0; i < count; ++i)
+        {
+            CHECK(j.at("key" + std::to_string(i)).as<std::size_t>() == i);
+        }
+        CHECK_FALSE(j.contains("key" + std::to_string(count)));
+        CHECK(bool(j.find("missing") == j.object_range().end()));
+    }
+
+    SECTION("duplicate keys keep the first member")
+    {
+        std::string text = make_object_text(100);
+        text.back() = ',';
+        text += R"("key5":-1,"key50":-1})";
+        hjson j = hjson::parse(text);
+        CHECK(j.size() == 100);
+        CHECK(j["key5"].as<int>() == 5);
+        CHECK(j["key50"].as<int>() == 50);
+    }
+}
+
+TEST_CASE("hash_index_policy modifiers")
+{
+    std::vector<std::pair<std::string,int>> expected;
+    hjson j(json_object_arg);
+    for (int i = 0; i < 100; ++i)
+    {
+        std::string key = "k" + std::to_string(i*7 % 100);
+        j.insert_or_assign(key, i);
+        expected.emplace_back(key, i);
+    }
+    check_same(j, expected);
+
+    SECTION("assign existing")
+    {
+        auto result = j.try_emplace("k14", -1);
+        CHECK_FALSE(result.second);
+        j.insert_or_assign("k14", 1000);
+        j["k21"] = 2000;
+        for (auto& item : expected)
+        {
+            if (item.first == "k14") item.second = 1000;
+            if (item.first == "k21") item.second = 2000;
+        }
+        check_same(j, expected);
+    }
+
+    SECTION("erase")
+    {
+        j.erase("k0");
+        expected.erase(expected.begin());
+        j.erase(j.object_range().begin() + 10, j.object_range().begin() + 20);
+        expected.erase(expected.begin() + 10, expected.begin() + 20);
+        j.erase("missing");
+        check_same(j, expected);
+        CHECK_FALSE(j.contains("k0"));
+
+        // Below the size that is indexed
+        j.erase(j.object_range().begin() + 5, j.object_range().end());
+        expected.erase(expected.begin() + 5, expected.end());
+        check_same(j, expected);
+        j.insert_or_assign("new", 1);
+        expected.emplace_back("new", 1);
+        check_same(j, expected);
+    }
+
+    SECTION("insert with hint")
+    {
+        auto it = j.insert_or_assign(j.object_range().begin() + 3, "inserted", 7);
+        CHECK(it->key() == "inserted");
+        expected.insert(expected.begin() + 3, std::make_pair(std::string("inserted"), 7));
+        j.try_emplace(j.object_range().begin(), "first", 8);
+        expected.insert(expected.begin(), std::make_pair(std::string("first"), 8));
+        check_same(j, expected);
+    }
+
+    SECTION("copy and merge")
+    {
+        hjson copy = j;
+        CHECK(copy == j);
+        check_same(copy, expected);
+
+        hjson other(json_object_arg);
+        other.insert_or_assign("k7", -7);
+        other.insert_or_assign("extra", 1);
+        j.merge(other);
+        expected.emplace_back("extra", 1);
+        check_same(j, expected);
+
+        j.merge_or_update(other);
+        for (auto& item : expected)
+        {
+            if (item.first == "k7") item.second = -7;
+        }
+        check_same(j, expected);
+    }
+}
+
+TEST_CASE("hash_index_policy random operations")
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> key_dist(0, 300);
+    std::uniform_int_distribution<int> op_dist(0, 9);
+
+    hjson j(json_object_arg);
+    std::map<std::string,int> reference;
+    for (int i = 0; i < 5000; ++i)
+    {
+        std::string key = std::to_string(key_dist(gen));
+        if (op_dist(gen) < 7)
+        {
+            j.insert_or_assign(key, i);
+            reference[key] = i;
+        }
+        else
+        {
+            j.erase(key);
+            reference.erase(key);
+        }
+    }
+    REQUIRE(j.size() == reference.size());
+    for (const auto& item : reference)
+    {
+        CHECK(j.at(item.first).as<int>() == item.second);
+    }
+}
@@ -0,0 +1,153 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(JSONCONS_HAS_ZLIB)
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons/inflate_source.hpp>
+#include <jsoncons/deflate_sink.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    json make_doc()
+    {
+        json doc(json_array_arg);
+        for (std::size_t i = 0; i < 3000; ++i)
+        {
+            json item;
+            item.try_emplace("id", i);
+            item.try_emplace("name", "name-" + std::to_string(i));
+            item.try_emplace("values", json(json_array_arg, {json(i * 0.5), json(true), json(null_type())}));
+            doc.push_back(std::move(item));
+        }
+        return doc;
+    }
+
+    std::string gzip_json(const json& doc, deflate_format format = deflate_format::gzip)
+    {
+        std::ostringstream os;
+        {
+            basic_json_encoder<char,deflate_sink<char>> encoder{deflate_sink<char>(binary_stream_sink(os), Z_DEFAULT_COMPRESSION, format)};
+            doc.dump(encoder);
+        }
+        return os.str();
+    }
+
+    std::string gzip_text(const std::string& text)
+    {
+        std::ostringstream os;
+        {
+            deflate_sink<char> sink{binary_stream_sink(os)};
+            sink.append(text.data(), text.size());
+        }
+        return os.str();
+    }
+}
+
+TEST_CASE("inflate_source and deflate_sink tests")
+{
+    json expected = make_doc();
+    std::string text = expected.to_string();
+
+    SECTION("json_reader")
+    {
+        std::string compressed = gzip_json(expected);
+        CHECK(compressed.size() < text.size()/4);
+
+        for (std::size_t length : {1, 7, 16384})
+        {
+            INFO(length);
+            std::istringstream is(compressed);
+            json_decoder<json> decoder;
+            basic_json_reader<char,inflate_source<char>> reader(inflate_source<char>(binary_stream_source(is), length), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+
+    SECTION("zlib format")
+    {
+        std::istringstream is(gzip_json(expected, deflate_format::zlib));
+        json_decoder<json> decoder;
+        basic_json_reader<char,inflate_source<char>> reader(inflate_source<char>(binary_stream_source(is)), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("json_cursor")
+    {
+        std::istringstream is(gzip_json(expected));
+        basic_json_cursor<char,inflate_source<char>> cursor{inflate_source<char>(binary_stream_source(is))};
+        std::size_t count = 0;
+        for (; !cursor.done(); cursor.next())
+        {
+            if (cursor.current().event_type() == staj_event_type::key && cursor.current().get<std::string>() == "id")
+            {
+                ++count;
+            }
+        }
+        CHECK(count == 3000);
+    }
+
+    SECTION("cbor")
+    {
+        std::vector<uint8_t> compressed;
+        {
+            cbor::basic_cbor_encoder<deflate_sink<uint8_t,bytes_sink<std::vector<uint8_t>>>> encoder{
+                deflate_sink<uint8_t,bytes_sink<std::vector<uint8_t>>>(bytes_sink<std::vector<uint8_t>>(compressed))};
+            expected.dump(encoder);
+        }
+
+        json_decoder<json> decoder;
+        cbor::basic_cbor_reader<inflate_source<uint8_t,bytes_source>> reader(inflate_source<uint8_t,bytes_source>(bytes_source(compressed)), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("concatenated gzip members")
+    {
+        std::istringstream is(gzip_text("[1,") + gzip_text("2]"));
+        std::string s;
+        inflate_source<char> source{binary_stream_source(is)};
+        for (auto c = source.get_character(); c; c = source.get_character())
+        {
+            s.push_back(c.value());
+        }
+        CHECK(s == "[1,2]");
+        CHECK(source.eof());
+        CHECK_FALSE(source.is_error());
+    }
+
+    SECTION("corrupt and truncated input")
+    {
+        std::string compressed = gzip_json(expected);
+
+        std::string corrupt = compressed;
+        corrupt[corrupt.size()/2] ^= 0x55;
+        std::istringstream is1(corrupt);
+        json_decoder<json> decoder;
+        basic_json_reader<char,inflate_source<char>> reader1(inflate_source<char>(binary_stream_source(is1)), decoder);
+        std::error_code ec1;
+        reader1.read(ec1);
+        CHECK(ec1);
+
+        std::istringstream is2(compressed.substr(0, compressed.size()/2));
+        basic_json_reader<char,inflate_source<char>> reader2(inflate_source<char>(binary_stream_source(is2)), decoder);
+        std::error_code ec2;
+        reader2.read(ec2);
+        CHECK(ec2 == json_errc::source_error);
+    }
+}
+
+#endif
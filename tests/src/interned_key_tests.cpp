@@ -0,0 +1,136 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons/interned_key_policy.hpp>
+#include <jsoncons_ext/jsonpath/jsonpath.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+#include <map>
+#include <thread>
+
+using namespace jsoncons;
+
+using ijson = basic_json<char,interned_key_policy,std::allocator<char>>;
+
+TEST_CASE("interned_key tests")
+{
+    SECTION("equal keys share characters")
+    {
+        interned_key a("name");
+        interned_key b(std::string("name"));
+        interned_key c("other");
+        CHECK(a.data() == b.data());
+        CHECK(a == b);
+        CHECK(a != c);
+        CHECK(a < c);
+        CHECK(a == "name");
+        CHECK(std::string("name") == a);
+        CHECK(a.compare(c) < 0);
+        CHECK(a.size() == 4);
+        CHECK(std::string(a.c_str()) == "name");
+    }
+
+    SECTION("empty key")
+    {
+        interned_key a;
+        interned_key b("");
+        CHECK(a.empty());
+        CHECK(a == b);
+        CHECK(a.data()[0] == 0);
+        CHECK(a < interned_key("a"));
+    }
+
+    SECTION("copy, move and assign")
+    {
+        interned_key a("name");
+        interned_key b(a);
+        interned_key c(std::move(b));
+        CHECK(c.data() == a.data());
+        interned_key d;
+        d = c;
+        CHECK(d == a);
+        d = interned_key("other");
+        CHECK(d == "other");
+    }
+
+    SECTION("keys made on several threads")
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([]()
+            {
+                for (int i = 0; i < 2000; ++i)
+                {
+                    interned_key key("key" + std::to_string(i % 50));
+                    interned_key copy(key);
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        interned_key a("key1");
+        interned_key b("key1");
+        CHECK(a.data() == b.data());
+    }
+}
+
+TEST_CASE("interned_key_policy tests")
+{
+    std::string text = R"(
+[
+    {"name" : "Haruki Murakami", "title" : "Kafka on the Shore", "price" : 25.17},
+    {"name" : "Charles Bukowski", "title" : "Women: A Novel", "price" : 12.00},
+    {"name" : "Ivan Passer", "title" : "Cutter's Way"}
+]
+    )";
+
+    ijson j = ijson::parse(text);
+
+    SECTION("decoded records share keys")
+    {
+        REQUIRE(j.size() == 3);
+        auto it0 = j[0].find("title");
+        auto it2 = j[2].find("title");
+        REQUIRE(bool(it0 != j[0].object_range().end()));
+        REQUIRE(bool(it2 != j[2].object_range().end()));
+        CHECK(it0->key().data() == it2->key().data());
+        CHECK(j[1]["title"].as<std::string>() == "Women: A Novel");
+        CHECK(j == ijson::parse(text));
+        CHECK(j.to_string() == json::parse(text).to_string());
+    }
+
+    SECTION("modify")
+    {
+        j[2].insert_or_assign("price", 15.0);
+        j[0].try_emplace("isbn", "0-375-41398-8");
+        j[1].erase("price");
+        CHECK(j[2]["price"].as<double>() == 15.0);
+        CHECK(j[0].contains("isbn"));
+        CHECK_FALSE(j[1].contains("price"));
+        CHECK(j[2].find("price")->key().data() == j[0].find("price")->key().data());
+
+        ijson copy = j;
+        CHECK(copy == j);
+    }
+
+    SECTION("conversions")
+    {
+        auto m = j[0].as<std::map<std::string,ijson>>();
+        CHECK(m.size() == 3);
+        CHECK(m["name"].as<std::string>() == "Haruki Murakami");
+        ijson from_map(m);
+        CHECK(from_map == j[0]);
+    }
+
+    SECTION("jsonpath")
+    {
+        ijson result = jsonpath::json_query(j, "$[?(@.price > 20)].title");
+        REQUIRE(result.size() == 1);
+        CHECK(result[0].as<std::string>() == "Kafka on the Shore");
+    }
+}
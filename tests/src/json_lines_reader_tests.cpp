@@ -0,0 +1,133 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_lines_reader.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+using namespace jsoncons;
+
+namespace {
+
+    std::string make_lines(std::size_t count)
+    {
+        std::string text;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            text.append("{\"id\":");
+            text.append(std::to_string(i));
+            text.append(",\"name\":\"record ");
+            text.append(std::to_string(i));
+            text.append("\",\"tags\":[1,2.5,true,null]}\n");
+        }
+        return text;
+    }
+
+    std::vector<json_lines_record<json>> read_all(const std::string& text, const json_lines_options& options)
+    {
+        std::vector<json_lines_record<json>> records;
+        std::istringstream is(text);
+        json_lines_reader<json> reader(is,
+                                       [&](json_lines_record<json>&& r) {records.push_back(std::move(r));},
+                                       options);
+        reader.read();
+        return records;
+    }
+}
+
+TEST_CASE("json_lines_reader tests")
+{
+    SECTION("records in input order")
+    {
+        std::string text = make_lines(1000);
+        auto options = json_lines_options{}.num_threads(4).batch_size(256);
+
+        auto records = read_all(text, options);
+        REQUIRE(records.size() == 1000);
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+            CHECK_FALSE(records[i].ec);
+            CHECK(records[i].line == i + 1);
+            CHECK(records[i].value["id"].as<std::size_t>() == i);
+        }
+    }
+
+    SECTION("records in completion order")
+    {
+        std::string text = make_lines(1000);
+        auto options = json_lines_options{}.num_threads(3).batch_size(100).order(json_lines_order::completion);
+
+        auto records = read_all(text, options);
+        REQUIRE(records.size() == 1000);
+        std::sort(records.begin(), records.end(),
+                  [](const json_lines_record<json>& a, const json_lines_record<json>& b) {return a.line < b.line;});
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+            CHECK(records[i].line == i + 1);
+            CHECK(records[i].value["id"].as<std::size_t>() == i);
+        }
+    }
+
+    SECTION("errors are reported per record")
+    {
+        std::string text = "[1,2]\n{\"a\":}\n\"abc\"\n[1 2]\ntrue false\n{\"b\":2}";
+
+        auto records = read_all(text, json_lines_options{}.num_threads(2));
+        REQUIRE(records.size() == 6);
+        CHECK(records[0].value == json::parse("[1,2]"));
+        CHECK(records[1].ec == json_errc::expected_value);
+        CHECK(records[1].line == 2);
+        CHECK(records[1].column == 6);
+        CHECK(records[2].value == json("abc"));
+        CHECK(records[3].ec == json_errc::expected_comma_or_right_bracket);
+        CHECK(records[4].ec == json_errc::extra_character);
+        CHECK(records[4].line == 5);
+        CHECK_FALSE(records[5].ec);
+        CHECK(records[5].value == json::parse("{\"b\":2}"));
+    }
+
+    SECTION("blank lines and CRLF")
+    {
+        std::string text = "\r\n1\r\n\n  \n\t2 \r\n\n";
+
+        auto records = read_all(text, json_lines_options{}.num_threads(1));
+        REQUIRE(records.size() == 2);
+        CHECK(records[0].line == 2);
+        CHECK(records[0].value == json(1));
+        CHECK(records[1].line == 5);
+        CHECK(records[1].value == json(2));
+    }
+
+    SECTION("lines longer than a batch")
+    {
+        std::string long_value(5000, 'x');
+        std::string text = "\"" + long_value + "\"\n[]\n\"" + long_value + "\"";
+
+        auto records = read_all(text, json_lines_options{}.num_threads(2).batch_size(64));
+        REQUIRE(records.size() == 3);
+        CHECK(records[0].value.as<std::string>() == long_value);
+        CHECK(records[1].value == json(json_array_arg));
+        CHECK(records[2].line == 3);
+        CHECK(records[2].value.as<std::string>() == long_value);
+    }
+
+    SECTION("exception from the handler")
+    {
+        std::string text = make_lines(100);
+        std::istringstream is(text);
+        std::size_t count = 0;
+        json_lines_reader<json> reader(is,
+                                       [&](json_lines_record<json>&&) {if (++count == 10) throw std::runtime_error("stop");},
+                                       json_lines_options{}.num_threads(2).batch_size(128));
+        REQUIRE_THROWS_AS(reader.read(), std::runtime_error);
+        CHECK(count == 10);
+    }
+}
+
@@ -0,0 +1,127 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/parallel_parse.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    // Records whose strings hold brackets, commas, quotes and backslashes, so that
+    // chunk boundaries fall inside strings and escape sequences
+    json make_records(std::size_t count)
+    {
+        json doc(json_array_arg);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            json item;
+            item.try_emplace("id", i);
+            item.try_emplace("text", "[{\"a\", \\\"b\\\\\"}], " + std::string(i % 7, '\\') + std::to_string(i));
+            item.try_emplace("values", json(json_array_arg, {json(i * 0.25), json(-1), json(null_type()), json("]")}));
+            item.try_emplace("nested", json::parse("{\"x\":[[1,[2]],{\"y\":{}}]}"));
+            doc.push_back(std::move(item));
+        }
+        return doc;
+    }
+
+    std::string serial_error(const std::string& input)
+    {
+        JSONCONS_TRY
+        {
+            json::parse(input);
+        }
+        JSONCONS_CATCH(const ser_error& e)
+        {
+            return e.what();
+        }
+        return std::string();
+    }
+
+    std::string parallel_error(const std::string& input)
+    {
+        JSONCONS_TRY
+        {
+            parse_parallel<json>(input, 4);
+        }
+        JSONCONS_CATCH(const ser_error& e)
+        {
+            return e.what();
+        }
+        return std::string();
+    }
+}
+
+TEST_CASE("json parallel parse tests")
+{
+    json doc = make_records(3000);
+
+    SECTION("compact and pretty printed")
+    {
+        std::string compact;
+        doc.dump(compact);
+        std::string pretty;
+        doc.dump(pretty, indenting::indent);
+        REQUIRE(compact.size() > 4*64*1024);
+
+        for (std::size_t threads : {0, 2, 3, 4, 7, 16})
+        {
+            INFO(threads);
+            CHECK(parse_parallel<json>(compact, threads) == doc);
+            CHECK(parse_parallel<json>(pretty, threads) == doc);
+        }
+    }
+
+    SECTION("top level values that are not arrays")
+    {
+        json object;
+        object.try_emplace("records", doc);
+        std::string input;
+        object.dump(input);
+
+        CHECK(parse_parallel<json>(input, 4) == object);
+        CHECK(parse_parallel<json>(" \n [1, 2]", 4) == json::parse("[1,2]"));
+    }
+
+    SECTION("errors are those of the serial parser")
+    {
+        std::string input;
+        doc.dump(input);
+
+        std::vector<std::string> inputs;
+        inputs.push_back(input + "]");
+        inputs.push_back(input.substr(0, input.size() - 1));
+        inputs.push_back("[," + input.substr(1));
+        inputs.push_back(input.substr(0, input.size() - 1) + ",]");
+        std::string doubled_comma = input;
+        doubled_comma.insert(doubled_comma.find("},{", input.size() / 2) + 1, ",");
+        inputs.push_back(doubled_comma);
+        std::string bad_number = input;
+        bad_number.replace(bad_number.find(",-1,", input.size() / 3), 4, ",-x,");
+        inputs.push_back(bad_number);
+        inputs.push_back(input + input);
+
+        for (const auto& s : inputs)
+        {
+            std::string expected = serial_error(s);
+            CHECK_FALSE(expected.empty());
+            CHECK(parallel_error(s) == expected);
+        }
+    }
+
+    SECTION("comments")
+    {
+        std::string input;
+        doc.dump(input, indenting::indent);
+        input.insert(input.size() / 2, "/* comment */");
+        input.insert(input.find('\n', input.size() / 2), "// comment");
+        CHECK(parse_parallel<json>(input, 4) == json::parse(input));
+    }
+}
+
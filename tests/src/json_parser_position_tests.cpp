@@ -169,6 +169,60 @@ namespace {
         jsoncons::json_reader reader(jsoncons::string_view(input), updater);
         reader.read();
     }
+
+    // Parses input handed to the parser in chunks of chunk_size characters, and returns 
+    // the error and the line and column at which it is reported
+    std::error_code parse_in_chunks(const std::string& input, std::size_t chunk_size, 
+                                    std::size_t& line, std::size_t& column)
+    {
+        json_decoder<json> decoder;
+        json_parser parser;
+        std::error_code ec;
+        std::size_t offset = 0;
+        bool eof = false;
+
+        auto next_chunk = [&]() -> bool
+        {
+            if (offset == input.size())
+            {
+                return false;
+            }
+            std::size_t length = (std::min)(chunk_size, input.size() - offset);
+            parser.update(input.data() + offset, length);
+            offset += length;
+            return true;
+        };
+
+        while (!ec && !parser.finished())
+        {
+            if (parser.source_exhausted() && !next_chunk())
+            {
+                eof = true;
+            }
+            if (eof)
+            {
+                parser.finish_parse(decoder, ec);
+            }
+            else
+            {
+                parser.parse_some(decoder, ec);
+            }
+        }
+        while (!ec && !eof)
+        {
+            if (parser.source_exhausted() && !next_chunk())
+            {
+                eof = true;
+            }
+            else
+            {
+                parser.check_done(ec);
+            }
+        }
+        line = parser.line();
+        column = parser.column();
+        return ec;
+    }
 }
 
 TEST_CASE("json_parser position")
@@ -231,3 +285,108 @@ TEST_CASE("json_parser position")
     }
 }
 
+TEST_CASE("json_parser line and column after runs of whitespace")
+{
+    SECTION("long indentation")
+    {
+        std::string indent(70, ' ');
+        std::string input = "[\n" + indent + "1,\n" + indent + "\t\t  2,\n\t" + indent + "x]";
+
+        json_decoder<json> decoder;
+        json_parser parser;
+        parser.update(input);
+
+        std::error_code ec;
+        parser.parse_some(decoder, ec);
+        CHECK(ec == json_errc::expected_value);
+        CHECK(parser.line() == 4);
+        CHECK(parser.column() == 72);
+    }
+
+    SECTION("indentation split across buffers")
+    {
+        std::string input1 = "{\"a\":\n" + std::string(40, ' ');
+        std::string input2 = std::string(23, '\t') + "1,\r\n" + std::string(17, ' ') + "}";
+
+        json_decoder<json> decoder;
+        json_parser parser;
+        std::error_code ec;
+
+        parser.update(input1);
+        parser.parse_some(decoder, ec);
+        REQUIRE_FALSE(ec);
+        CHECK(parser.line() == 2);
+        CHECK(parser.column() == 41);
+
+        parser.update(input2);
+        parser.parse_some(decoder, ec);
+        CHECK(ec == json_errc::extra_comma);
+        CHECK(parser.line() == 3);
+        CHECK(parser.column() == 19);
+    }
+
+    SECTION("pretty printed document")
+    {
+        json j(json_array_arg);
+        for (std::size_t i = 0; i < 50; ++i)
+        {
+            json item(json_object_arg);
+            item.try_emplace("id", i);
+            item.try_emplace("tags", json(json_array_arg, {"x", "y"}));
+            j.push_back(std::move(item));
+        }
+        std::string s;
+        j.dump(s, indenting::indent);
+        CHECK(json::parse(s) == j);
+    }
+}
+
+
+TEST_CASE("json_parser position of extra character")
+{
+    struct test_case
+    {
+        std::string input;
+        std::error_code ec;
+        std::size_t line;
+        std::size_t column;
+    };
+
+    std::vector<test_case> tests = {
+        {"true  1ex", json_errc::extra_character, 1, 7},
+        {"[1,2]  x", json_errc::extra_character, 1, 8},
+        {"\"abcdef\"   }", json_errc::extra_character, 1, 12},
+        {"123 4", json_errc::extra_character, 1, 5},
+        {"{}\n  x", json_errc::extra_character, 2, 3},
+        {"[\"abcdef\",\n \"ghi\", x]", json_errc::expected_value, 2, 9}
+    };
+
+    for (const auto& test : tests)
+    {
+        SECTION(test.input)
+        {
+            json_decoder<json> decoder;
+            json_parser parser;
+            std::error_code ec;
+            parser.update(test.input);
+            parser.finish_parse(decoder, ec);
+            if (!ec)
+            {
+                parser.check_done(ec);
+            }
+            CHECK(ec == test.ec);
+            CHECK(parser.line() == test.line);
+            CHECK(parser.column() == test.column);
+
+            for (std::size_t chunk_size : {1, 3, 7})
+            {
+                std::size_t line = 0;
+                std::size_t column = 0;
+                ec = parse_in_chunks(test.input, chunk_size, line, column);
+                CHECK(ec == test.ec);
+                CHECK(line == test.line);
+                CHECK(column == test.column);
+            }
+        }
+    }
+}
@@ -0,0 +1,227 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_reader.hpp>
+#include <jsoncons/decode_json.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    struct parse_outcome
+    {
+        std::error_code ec;
+        std::size_t line;
+        std::size_t column;
+        json j;
+    };
+
+    parse_outcome read_with(const std::string& input, bool structural_index,
+                            std::function<bool(json_errc,const ser_context&)> err_handler = default_json_parsing())
+    {
+        json_decoder<json> decoder;
+        auto options = json_options{}.structural_index(structural_index);
+        basic_json_reader<char,string_source<char>> reader(string_source<char>(input.data(), input.size()), decoder, options, err_handler);
+
+        parse_outcome outcome;
+        reader.read(outcome.ec);
+        outcome.line = reader.line();
+        outcome.column = reader.column();
+        if (!outcome.ec && decoder.is_valid())
+        {
+            outcome.j = decoder.get_result();
+        }
+        return outcome;
+    }
+
+    void check_same_outcome(const std::string& input)
+    {
+        parse_outcome expected = read_with(input, false);
+        parse_outcome actual = read_with(input, true);
+
+        INFO(input);
+        CHECK(actual.ec == expected.ec);
+        CHECK(actual.line == expected.line);
+        CHECK(actual.column == expected.column);
+        CHECK(actual.j == expected.j);
+    }
+}
+
+TEST_CASE("json_parser structural index matches incremental parser")
+{
+    SECTION("valid texts")
+    {
+        std::vector<std::string> inputs = {
+            "{}", "[]", "0", "-0", "12345", "-12.5e+3", "1E5", "0.25", "true", "false", "null", "\"\"",
+            "  \"abc\"  ", "\n\n  [1,2 , 3 ]\n", "\r\n[\r\n  true\r\n]\r\n",
+            "{\"a\":1,\"b\":[true,false,null],\"c\":{\"d\":\"e\"}}",
+            "[\"\\\"\",\"\\\\\",\"\\\\\\\"\",\"\\u00e9\\ud83d\\ude00\",\"\\/\\b\\f\\n\\r\\t\"]",
+            "[18446744073709551616,-9223372036854775809,1.5]",
+            "{\"\xce\xb1\xce\xb2\":\"\xe6\x97\xa5\xe6\x9c\xac\"}",
+            "[[[[[[[[[[]]]]]]]]]]",
+            "[1,[2,[3,{\"x\":[4]}]]]"
+        };
+        for (const auto& input : inputs)
+        {
+            check_same_outcome(input);
+        }
+    }
+
+    SECTION("invalid texts")
+    {
+        std::vector<std::string> inputs = {
+            "", "   ", "\n\n", "[", "{", "[1,", "{\"a\"", "{\"a\":", "{\"a\":1", "\"abc", "[1 2]", "[1,]", "{,}",
+            "{\"a\":1,}", "{\"a\" 1}", "{1:2}", "{'a':1}", "['a']", "[}", "{]", "]", "}", "'a'", "x",
+            "[tru]", "[trux]", "[truex]", "tr", "nul", "fals", "[nulx]", "truex", "true false",
+            "-", "[-]", "[-x]", "01", "[01]", "1.", "[1.]", "[1.x]", "1e", "[1e]", "1e+", "[1e+]", "[1ex]", "[1x]",
+            "[1.5.3]", "[1e5e5]", "[0x1]", "[1\"a\"]", "[\"a\"\"b\"]", "[\"a\"1]", "[\"\\x\"]", "[\"\\u12\"]",
+            "[\"\t\"]", "[\"a\nb\"]", "[\x01]", "{\"a\":1\x01}", "[\"\xff\"]", "[\"\xce\"]",
+            "{\"a\":1}\n\n  x", "[1,\n2,\n  }", "[\r\n1\r\n,x]", "[\"\\\"]",
+            "\\", "[\\\"]", "[1]]", "{\"a\":{\"b\":1}}}"
+        };
+        for (const auto& input : inputs)
+        {
+            check_same_outcome(input);
+        }
+    }
+
+    SECTION("scalar followed by a right bracket or brace")
+    {
+        std::vector<std::pair<std::string,json_errc>> inputs = {
+            {"123]]5678", json_errc::unexpected_right_bracket},
+            {"12356789012345689012}34", json_errc::unexpected_right_brace}
+        };
+        for (const auto& input : inputs)
+        {
+            INFO(input.first);
+            check_same_outcome(input.first);
+            CHECK(read_with(input.first, true).ec == json_errc::extra_character);
+
+            // Read as consecutive texts, the second one begins with the bracket or brace
+            for (bool structural_index : {false, true})
+            {
+                json_decoder<json> decoder;
+                auto options = json_options{}.structural_index(structural_index);
+                basic_json_reader<char,string_source<char>> reader(string_source<char>(input.first.data(), input.first.size()), decoder, options);
+
+                std::error_code ec;
+                reader.read_next(ec);
+                REQUIRE_FALSE(ec);
+                reader.read_next(ec);
+                CHECK(ec == input.second);
+            }
+        }
+    }
+
+    SECTION("texts longer than one block")
+    {
+        // Backslash runs and quotes that straddle the 64 byte blocks of stage 1
+        for (std::size_t pad = 0; pad < 70; ++pad)
+        {
+            std::string run;
+            for (std::size_t n = 1; n <= 4; ++n)
+            {
+                std::string input = "[\"" + std::string(pad, 'a') + std::string(2*n, '\\') + "\",\"" +
+                                    std::string(pad, ' ') + std::string(2*n-1, '\\') + "\"" + std::string(pad, 'b') + "\"," +
+                                    std::to_string(pad) + ",\n" + std::string(pad, ' ') + "{\"k\" : [true, null]}]";
+                check_same_outcome(input);
+                input.insert(input.size()/2, "]");
+                check_same_outcome(input);
+            }
+        }
+    }
+
+    SECTION("pretty printed document")
+    {
+        json doc(json_array_arg);
+        for (int i = 0; i < 200; ++i)
+        {
+            json item;
+            item.try_emplace("id", i);
+            item.try_emplace("name", "item \"" + std::to_string(i) + "\"\\");
+            item.try_emplace("value", i * 0.5 - 30);
+            item.try_emplace("tags", json(json_array_arg, {"a", "b\n", "\xce\xb1"}));
+            doc.push_back(std::move(item));
+        }
+        std::string input;
+        doc.dump(input, indenting::indent);
+
+        parse_outcome outcome = read_with(input, true);
+        CHECK_FALSE(outcome.ec);
+        CHECK(outcome.j == doc);
+        check_same_outcome(input);
+
+        input.replace(input.rfind("30"), 2, "3x");
+        check_same_outcome(input);
+    }
+
+    SECTION("comments use the incremental parser")
+    {
+        check_same_outcome("[1, /* comment */ 2]");
+        check_same_outcome("// comment\n[1,2]");
+        check_same_outcome("[\"/\"]");
+    }
+}
+
+TEST_CASE("json_parser structural index entry points")
+{
+    std::string input = R"({"a" : [1, 2.5, "three", true, null], "b" : {"c" : -4}})";
+    json expected = json::parse(input);
+    auto options = json_options{}.structural_index(true);
+
+    SECTION("json::parse")
+    {
+        CHECK(json::parse(input, options) == expected);
+        REQUIRE_THROWS_AS(json::parse(R"({"a" : [1, 2.5,]})", options), ser_error);
+    }
+
+    SECTION("decode_json")
+    {
+        CHECK(decode_json<json>(input, options) == expected);
+    }
+
+    SECTION("consecutive texts in one buffer")
+    {
+        std::string texts = "[1]\n{\"a\":2}\n\"three\"\n";
+        json_decoder<json> decoder;
+        basic_json_reader<char,string_source<char>> reader(string_source<char>(texts.data(), texts.size()), decoder, options);
+
+        REQUIRE_FALSE(reader.eof());
+        reader.read_next();
+        CHECK(decoder.get_result() == json::parse("[1]"));
+        REQUIRE_FALSE(reader.eof());
+        reader.read_next();
+        CHECK(decoder.get_result() == json::parse("{\"a\":2}"));
+        REQUIRE_FALSE(reader.eof());
+        reader.read_next();
+        CHECK(decoder.get_result() == json("three"));
+        CHECK(reader.eof());
+    }
+
+    SECTION("error handler that recovers")
+    {
+        std::string text = "[1,2,]";
+        auto recover = [](json_errc, const ser_context&) {return true;};
+        parse_outcome expected = read_with(text, false, recover);
+        parse_outcome actual = read_with(text, true, recover);
+        CHECK(actual.ec == expected.ec);
+        CHECK(actual.j == expected.j);
+    }
+
+    SECTION("nan replacement")
+    {
+        auto nan_options = json_options{}.structural_index(true).nan_to_str("NaN");
+        json j = json::parse(R"(["NaN", "x"])", nan_options);
+        REQUIRE(j.size() == 2);
+        CHECK(std::isnan(j[0].as<double>()));
+        CHECK(j[1].as<std::string>() == "x");
+    }
+}
@@ -277,3 +277,59 @@ TEST_CASE("test_incremental_parsing")
 
 
 
+
+TEST_CASE("test_strict_json_parse_policy")
+{
+    using strict_json_parser = basic_json_parser<char,std::allocator<char>,strict_json_parse_policy>;
+
+    SECTION("valid json")
+    {
+        jsoncons::json_decoder<json> decoder;
+        strict_json_parser parser;
+
+        std::string input = R"({"a" : [1, 2.5, "NaN", true, null]})";
+        parser.update(input.data(), input.size());
+        parser.finish_parse(decoder);
+        CHECK(parser.done());
+        CHECK(decoder.get_result() == json::parse(input));
+    }
+
+    SECTION("comments are errors")
+    {
+        jsoncons::json_decoder<json> decoder;
+        strict_json_parser parser;
+
+        std::string input = "[1, /* comment */ 2]";
+        parser.update(input.data(), input.size());
+        std::error_code ec;
+        parser.finish_parse(decoder, ec);
+        CHECK(ec == json_errc::illegal_comment);
+        CHECK(parser.column() == 6);
+    }
+
+    SECTION("error handler does not recover")
+    {
+        jsoncons::json_decoder<json> decoder;
+        int count = 0;
+        auto recover = [&count](json_errc, const ser_context&) {++count; return true;};
+        strict_json_parser parser(recover);
+
+        std::string input = "[1,2,]";
+        parser.update(input.data(), input.size());
+        std::error_code ec;
+        parser.finish_parse(decoder, ec);
+        CHECK(ec == json_errc::extra_comma);
+        CHECK(count == 1);
+    }
+
+    SECTION("no nan replacement")
+    {
+        jsoncons::json_decoder<json> decoder;
+        auto options = json_options{}.nan_to_str("NaN");
+        basic_json_reader<char,string_source<char>,std::allocator<char>,strict_json_parse_policy> reader(std::string(R"(["NaN"])"), decoder, options);
+        reader.read();
+        json j = decoder.get_result();
+        REQUIRE(j.size() == 1);
+        CHECK(j[0].as<std::string>() == "NaN");
+    }
+}
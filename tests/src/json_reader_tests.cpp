@@ -4,6 +4,8 @@
 #include <jsoncons/json.hpp>
 #include <jsoncons/json_encoder.hpp>
 #include <jsoncons/json_reader.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons/decode_json.hpp>
 #include "sample_allocators.hpp"
 #include <catch/catch.hpp>
 #include <sstream>
@@ -267,3 +269,66 @@ TEST_CASE("json_reader read from string test")
 
 
 
+
+namespace {
+
+    class string_address_visitor : public default_json_visitor
+    {
+        const char* first_;
+        const char* last_;
+    public:
+        std::vector<bool> in_place;
+
+        string_address_visitor(const char* first, const char* last)
+            : first_(first), last_(last)
+        {
+        }
+    private:
+        bool visit_key(const string_view_type& name, const ser_context&, std::error_code&) override
+        {
+            in_place.push_back(name.data() >= first_ && name.data() + name.size() <= last_);
+            return true;
+        }
+
+        bool visit_string(const string_view_type& value, semantic_tag, const ser_context&, std::error_code&) override
+        {
+            in_place.push_back(value.data() >= first_ && value.data() + value.size() <= last_);
+            return true;
+        }
+    };
+
+} // namespace
+
+TEST_CASE("json_reader string views into contiguous input")
+{
+    std::vector<char> input;
+    std::string s = R"({"name":"Jane Roe","escaped":"a\tb","empty":""})";
+    input.assign(s.begin(), s.end());
+
+    SECTION("json_reader with string_source")
+    {
+        string_address_visitor visitor(input.data(), input.data() + input.size());
+        basic_json_reader<char,string_source<char>> reader(input, visitor);
+        reader.read();
+
+        std::vector<bool> expected = {true,true,true,false,true,true};
+        CHECK(visitor.in_place == expected);
+    }
+
+    SECTION("json_cursor with string_source")
+    {
+        string_address_visitor visitor(input.data(), input.data() + input.size());
+        basic_json_cursor<char,string_source<char>> cursor(input);
+        cursor.read_to(visitor);
+
+        std::vector<bool> expected = {true,true,true,false,true,true};
+        CHECK(visitor.in_place == expected);
+    }
+
+    SECTION("decode_json from a vector of char")
+    {
+        json j = decode_json<json>(input);
+        CHECK(j["escaped"].as<std::string>() == "a\tb");
+        CHECK(j["name"].as<std::string>() == "Jane Roe");
+    }
+}
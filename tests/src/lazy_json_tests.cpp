@@ -0,0 +1,206 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/lazy_json.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+
+using namespace jsoncons;
+
+namespace {
+
+    // Stops, or sets an error, at the key with the given ordinal
+    class stop_at_key_visitor : public default_json_visitor
+    {
+        std::size_t stop_at_;
+        std::error_code error_;
+    public:
+        std::size_t keys = 0;
+
+        stop_at_key_visitor(std::size_t stop_at, std::error_code error = std::error_code())
+            : stop_at_(stop_at), error_(error)
+        {
+        }
+    private:
+        bool visit_key(const string_view_type&, const ser_context&, std::error_code& ec) override
+        {
+            if (++keys == stop_at_)
+            {
+                ec = error_;
+                return false;
+            }
+            return true;
+        }
+    };
+}
+
+TEST_CASE("lazy_document accessors")
+{
+    std::string input = R"(
+{
+    "id" : 12345,
+    "name" : "Haruki \"Murakami\"",
+    "price" : 18.9,
+    "big" : 18446744073709551615,
+    "negative" : -7,
+    "available" : true,
+    "publisher" : null,
+    "tags" : ["fiction", "novel", ["nested", {"a" : 1}]],
+    "details" : {"pages" : 400, "isbn" : "0679743464", "ratings" : []}
+}
+    )";
+
+    lazy_document doc = lazy_document::parse(input);
+    json expected = json::parse(input);
+
+    SECTION("types and sizes")
+    {
+        CHECK(doc.type() == json_type::object_value);
+        CHECK(doc.size() == 9);
+        CHECK(doc["id"].is_int64());
+        CHECK(doc["big"].is_uint64());
+        CHECK_FALSE(doc["big"].is_int64());
+        CHECK_FALSE(doc["negative"].is_uint64());
+        CHECK(doc["price"].is_double());
+        CHECK(doc["price"].is_number());
+        CHECK(doc["name"].is_string());
+        CHECK(doc["available"].is_bool());
+        CHECK(doc["publisher"].is_null());
+        CHECK(doc["tags"].is_array());
+        CHECK(doc["tags"].size() == 3);
+        CHECK(doc["details"].is_object());
+        CHECK(doc["details"]["ratings"].empty());
+        CHECK(doc.contains("details"));
+        CHECK_FALSE(doc.contains("author"));
+        CHECK_FALSE(doc["tags"].contains("author"));
+    }
+
+    SECTION("scalars")
+    {
+        CHECK(doc["id"].as<int>() == 12345);
+        CHECK(doc["id"].as<double>() == 12345.0);
+        CHECK(doc["big"].as<uint64_t>() == (std::numeric_limits<uint64_t>::max)());
+        CHECK(doc["negative"].as<int64_t>() == -7);
+        CHECK(doc["price"].as<double>() == 18.9);
+        CHECK(doc["available"].as<bool>());
+        CHECK(doc["name"].as<std::string>() == "Haruki \"Murakami\"");
+        CHECK(doc["name"].as<string_view>() == "Haruki \"Murakami\"");
+        CHECK(doc.at("details").at("isbn").as_string_view() == "0679743464");
+    }
+
+    SECTION("conversions are those of basic_json")
+    {
+        CHECK(doc["id"].as<std::string>() == expected["id"].as<std::string>());
+        CHECK(doc["price"].as<std::string>() == expected["price"].as<std::string>());
+        CHECK(doc["available"].as<int>() == expected["available"].as<int>());
+        CHECK(doc["tags"].as<std::vector<json>>() == expected["tags"].as<std::vector<json>>());
+        CHECK((doc["details"].as<std::map<std::string,json>>() == expected["details"].as<std::map<std::string,json>>()));
+    }
+
+    SECTION("materialize")
+    {
+        CHECK(doc.as<json>() == expected);
+        CHECK(doc["tags"].as<json>() == expected["tags"]);
+        CHECK(doc["tags"][2][1].as<ojson>() == ojson::parse(R"({"a" : 1})"));
+        CHECK(doc.at(7).as<json>() == expected["tags"]);
+    }
+
+    SECTION("iteration")
+    {
+        std::vector<std::string> keys;
+        for (const auto& member : doc.root().object_range())
+        {
+            keys.emplace_back(member.key());
+            CHECK(member.value().as<json>() == expected[member.key()]);
+        }
+        CHECK(keys == (std::vector<std::string>{"id","name","price","big","negative","available","publisher","tags","details"}));
+
+        std::size_t i = 0;
+        for (auto item : doc["tags"].array_range())
+        {
+            CHECK(item.as<json>() == expected["tags"][i]);
+            ++i;
+        }
+        CHECK(i == 3);
+        CHECK(doc["details"]["ratings"].array_range().begin() == doc["details"]["ratings"].array_range().end());
+    }
+
+    SECTION("visitor that stops early")
+    {
+        stop_at_key_visitor visitor(2);
+        std::error_code ec;
+        doc.root().dump(visitor, ec);
+        CHECK_FALSE(ec);
+        CHECK(visitor.keys == 2);
+
+        stop_at_key_visitor failing(3, json_errc::source_error);
+        doc.root().dump(failing, ec);
+        CHECK(ec == json_errc::source_error);
+        CHECK(failing.keys == 3);
+    }
+
+    SECTION("errors")
+    {
+        REQUIRE_THROWS_AS(doc["author"], key_not_found);
+        REQUIRE_THROWS_AS(doc["id"]["x"], not_an_object);
+        REQUIRE_THROWS_AS(doc["tags"][3], std::out_of_range);
+        REQUIRE_THROWS_AS(doc["id"][0], std::domain_error);
+        REQUIRE_THROWS_AS(doc["id"].as<string_view>(), std::domain_error);
+        REQUIRE_THROWS_AS(doc["id"].array_range(), std::domain_error);
+        REQUIRE_THROWS_AS(lazy_document::parse(R"({"a" : [1,2}})"), ser_error);
+    }
+}
+
+TEST_CASE("lazy_document sources")
+{
+    SECTION("scalar root")
+    {
+        CHECK(lazy_document::parse("\"abc\"").as<std::string>() == "abc");
+        CHECK(lazy_document::parse("  -1.5 ").as<double>() == -1.5);
+        CHECK(lazy_document::parse("null").root().is_null());
+    }
+
+    SECTION("stream")
+    {
+        std::istringstream is(R"([{"a" : "b"}, 2, [3]])");
+        lazy_document doc = lazy_document::parse(is);
+        CHECK(doc.size() == 3);
+        CHECK(doc[0]["a"].as<std::string>() == "b");
+        CHECK(doc[2][0].as<int>() == 3);
+    }
+
+    SECTION("lossless numbers")
+    {
+        auto options = json_options{}.lossless_number(true);
+        lazy_document doc = lazy_document::parse(R"([1.50, 123456789012345678901234567890])", options);
+        CHECK(doc[0].tag() == semantic_tag::bigdec);
+        CHECK(doc[0].is_number());
+        CHECK(doc[0].as<std::string>() == "1.50");
+        CHECK(doc[0].as<double>() == 1.5);
+        CHECK(doc[1].tag() == semantic_tag::bigint);
+        CHECK(doc.as<json>() == json::parse(R"([1.50, 123456789012345678901234567890])", options));
+    }
+
+    SECTION("wide characters")
+    {
+        wlazy_document doc = wlazy_document::parse(LR"({"name" : "value"})");
+        CHECK(doc[L"name"].as<std::wstring>() == L"value");
+    }
+
+    SECTION("moved document")
+    {
+        lazy_document doc = lazy_document::parse(R"({"k":"v"})");
+        lazy_value value = doc["k"];
+        lazy_document other = std::move(doc);
+        CHECK(value.as<std::string>() == "v");
+        CHECK(other["k"].as<std::string>() == "v");
+    }
+}
+
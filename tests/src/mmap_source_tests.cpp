@@ -0,0 +1,95 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons/mmap_source.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <catch/catch.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("mmap_source tests")
+{
+    std::string in_file = "./input/address-book.json";
+    std::ifstream is(in_file, std::ifstream::binary);
+    json expected = json::parse(is);
+
+    SECTION("json_reader")
+    {
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source<char>> reader(mmap_source<char>(in_file), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("json_cursor")
+    {
+        basic_json_cursor<char,mmap_source<char>> cursor{mmap_source<char>(in_file)};
+        std::size_t count = 0;
+        for (; !cursor.done(); cursor.next())
+        {
+            if (cursor.current().event_type() == staj_event_type::key &&
+                cursor.current().get<std::string>() == "name")
+            {
+                ++count;
+            }
+        }
+        CHECK(count == 2);
+    }
+
+    SECTION("missing file")
+    {
+        mmap_source<char> source("./input/no-such-file.json");
+        CHECK(source.is_error());
+        CHECK(source.eof());
+
+        json_decoder<json> decoder;
+        basic_json_reader<char,mmap_source<char>> reader(std::move(source), decoder);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == json_errc::source_error);
+    }
+
+    SECTION("empty file")
+    {
+        std::string empty_file = "./output/mmap-empty.json";
+        {
+            std::ofstream os(empty_file);
+        }
+        mmap_source<char> source(empty_file);
+        CHECK_FALSE(source.is_error());
+        CHECK(source.eof());
+    }
+
+    SECTION("cbor and msgpack")
+    {
+        std::string cbor_file = "./output/mmap-address-book.cbor";
+        std::string msgpack_file = "./output/mmap-address-book.msgpack";
+        {
+            std::ofstream os(cbor_file, std::ofstream::binary);
+            cbor::encode_cbor(expected, os);
+        }
+        {
+            std::ofstream os(msgpack_file, std::ofstream::binary);
+            msgpack::encode_msgpack(expected, os);
+        }
+
+        json_decoder<json> decoder;
+        cbor::basic_cbor_reader<binary_mmap_source> cbor_reader(binary_mmap_source(cbor_file), decoder);
+        cbor_reader.read();
+        CHECK(decoder.get_result() == expected);
+
+        msgpack::basic_msgpack_reader<binary_mmap_source> msgpack_reader(binary_mmap_source(msgpack_file), decoder);
+        msgpack_reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+}
+
@@ -0,0 +1,260 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+#include <list>
+#include <thread>
+#include <cstdint>
+
+using namespace jsoncons;
+
+using pjson = basic_json<char,packed_array_policy,std::allocator<char>>;
+
+TEST_CASE("packed_array_policy parse")
+{
+    SECTION("doubles")
+    {
+        pjson j = pjson::parse("[1.5,-2.25,3e10]");
+        REQUIRE(j.array_value().is_packed());
+        CHECK(j.array_value().packing() == detail::packed_kind::float64_value);
+        CHECK(j.size() == 3);
+        CHECK(j.to_string() == "[1.5,-2.25,30000000000.0]");
+        CHECK(j.is<std::vector<double>>());
+        CHECK_FALSE(j.is<std::vector<int>>());
+
+        std::vector<double> v = j.as<std::vector<double>>();
+        CHECK(v == std::vector<double>{1.5,-2.25,3e10});
+        std::vector<float> f = j.as<std::vector<float>>();
+        CHECK(f == std::vector<float>{1.5f,-2.25f,3e10f});
+        CHECK(j.array_value().is_packed());
+    }
+
+    SECTION("integers")
+    {
+        pjson a = pjson::parse("[-1,-2,-3]");
+        CHECK(a.array_value().packing() == detail::packed_kind::int64_value);
+        CHECK(a.as<std::vector<int>>() == std::vector<int>{-1,-2,-3});
+        CHECK(a.as<std::list<int64_t>>() == std::list<int64_t>{-1,-2,-3});
+        CHECK_FALSE(a.is<std::vector<uint64_t>>());
+
+        pjson b = pjson::parse("[18446744073709551615,18446744073709551614]");
+        CHECK(b.array_value().packing() == detail::packed_kind::uint64_value);
+        CHECK(b.as<std::vector<uint64_t>>() == std::vector<uint64_t>{18446744073709551615u,18446744073709551614u});
+        CHECK(b.to_string() == "[18446744073709551615,18446744073709551614]");
+
+        // Integers keep the storage kind they would have in json
+        pjson c = pjson::parse("[1,2,3]");
+        CHECK(c.array_value().packing() == detail::packed_kind::uint64_value);
+        CHECK(c.is<std::vector<uint64_t>>());
+        CHECK(c[0].type() == json_type::uint64_value);
+        CHECK(c[0].type() == json::parse("[1,2,3]")[0].type());
+        CHECK(c.to_string() == "[1,2,3]");
+
+        pjson d = pjson::parse("[1,-2,3]");
+        CHECK_FALSE(d.array_value().is_packed());
+        CHECK(d[0].type() == json_type::uint64_value);
+        CHECK(d[1].type() == json_type::int64_value);
+    }
+
+    SECTION("arrays that are not packed")
+    {
+        CHECK_FALSE(pjson::parse("[]").array_value().is_packed());
+        CHECK_FALSE(pjson::parse("[1,2.5]").array_value().is_packed());
+        CHECK_FALSE(pjson::parse(R"([1,"2"])").array_value().is_packed());
+        CHECK_FALSE(pjson::parse(R"(["1.5"])").array_value().is_packed());
+    }
+
+    SECTION("nested")
+    {
+        std::string text = R"({"a":[[1.5,2.5],[3,4]],"b":[true,[1,2]]})";
+        pjson j = pjson::parse(text);
+        CHECK(j["a"][1].array_value().is_packed());
+        CHECK(j.to_string() == json::parse(text).to_string());
+        CHECK(j == pjson::parse(text));
+    }
+}
+
+TEST_CASE("packed_array_policy element access")
+{
+    pjson j = pjson::parse("[1.5,2.5,3.5]");
+
+    SECTION("const access")
+    {
+        const pjson& cj = j;
+        CHECK(cj[1].as<double>() == 2.5);
+        CHECK(cj[2].is_double());
+        double sum = 0;
+        for (const auto& item : cj.array_range())
+        {
+            sum += item.as<double>();
+        }
+        CHECK(sum == 7.5);
+        CHECK(j.size() == 3);
+        // Const access does not change the storage
+        CHECK(cj.array_value().is_packed());
+    }
+
+    SECTION("const iterator then erase")
+    {
+        const pjson& cj = j;
+        auto it = cj.array_range().begin();
+        ++it;
+        j.erase(it);
+        CHECK(j.to_string() == "[1.5,3.5]");
+    }
+
+    SECTION("const access is dropped when the numbers change")
+    {
+        const pjson& cj = j;
+        CHECK(cj[2].as<double>() == 3.5);
+        j.push_back(4.5);
+        REQUIRE(cj.array_value().is_packed());
+        CHECK(cj[3].as<double>() == 4.5);
+        CHECK(cj.array_value().is_packed());
+    }
+
+    SECTION("concurrent const access")
+    {
+        const pjson c = pjson::parse("[1.5,2.5,3.5,4.5]");
+        std::vector<double> sums(4, 0.0);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < sums.size(); ++i)
+        {
+            threads.emplace_back([&c,&sums,i]()
+            {
+                for (const auto& item : c.array_range())
+                {
+                    sums[i] += item.as<double>();
+                }
+            });
+        }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+        CHECK(sums == std::vector<double>(4, 12.0));
+        CHECK(c.array_value().is_packed());
+    }
+
+    SECTION("assign element")
+    {
+        j[0] = "first";
+        CHECK_FALSE(j.array_value().is_packed());
+        CHECK(j.to_string() == R"(["first",2.5,3.5])");
+    }
+
+    SECTION("erase and insert")
+    {
+        j.erase(j.array_range().begin());
+        j.insert(j.array_range().end(), 4.5);
+        CHECK(j.as<std::vector<double>>() == std::vector<double>{2.5,3.5,4.5});
+    }
+}
+
+TEST_CASE("packed_array_policy push_back")
+{
+    pjson j(json_array_arg);
+    j.reserve(10);
+    for (int i = 0; i < 10; ++i)
+    {
+        j.push_back(i*0.5);
+    }
+    REQUIRE(j.array_value().is_packed());
+    CHECK(j.size() == 10);
+    CHECK(j[9].as<double>() == 4.5);
+    CHECK_FALSE(j.array_value().is_packed());
+
+    SECTION("heterogeneous insert")
+    {
+        pjson k(json_array_arg);
+        k.push_back(1);
+        k.push_back(2);
+        REQUIRE(k.array_value().packing() == detail::packed_kind::int64_value);
+        k.push_back(2.5);
+        CHECK_FALSE(k.array_value().is_packed());
+        k.push_back("three");
+        CHECK(k.to_string() == R"([1,2,2.5,"three"])");
+    }
+
+    SECTION("not a number first")
+    {
+        pjson k(json_array_arg);
+        k.reserve(3);
+        k.push_back(true);
+        k.push_back(1.0);
+        CHECK_FALSE(k.array_value().is_packed());
+        CHECK(k.capacity() >= 3);
+        CHECK(k.to_string() == "[true,1.0]");
+    }
+
+    SECTION("tagged numbers are not packed")
+    {
+        pjson k(json_array_arg);
+        k.push_back(pjson(1000, semantic_tag::epoch_second));
+        CHECK_FALSE(k.array_value().is_packed());
+    }
+}
+
+TEST_CASE("packed_array_policy compare and copy")
+{
+    pjson a = pjson::parse("[1,2,3]");
+    pjson b(json_array_arg);
+    b.push_back(pjson(1));
+    b.push_back(pjson(2));
+    b.emplace_back(3);
+    CHECK_FALSE(b.array_value().is_packed());
+    CHECK(a == b);
+    CHECK(b == a);
+
+    pjson c = pjson::parse("[1.0,2.0,3.0]");
+    CHECK(a == c);
+
+    pjson d = pjson::parse("[1,2,4]");
+    CHECK(a < d);
+    CHECK_FALSE(d < a);
+    CHECK(a < pjson::parse("[1,2,3,0]"));
+
+    pjson copy(a);
+    CHECK(copy.array_value().is_packed());
+    CHECK(copy == a);
+    pjson moved(std::move(copy));
+    CHECK(moved.array_value().is_packed());
+    CHECK(moved == a);
+}
+
+TEST_CASE("packed_array_policy cbor typed arrays")
+{
+    std::vector<float> floats = {1.5f, -0.25f, 100.0f};
+    std::vector<double> doubles = {1.5, -0.25, 1e100};
+
+    std::vector<uint8_t> data;
+    cbor::cbor_options options;
+    options.use_typed_arrays(true);
+    cbor::cbor_bytes_encoder encoder(data, options);
+    encoder.begin_array(2);
+    encoder.typed_array(span<const float>(floats));
+    encoder.typed_array(span<const double>(doubles));
+    encoder.end_array();
+    encoder.flush();
+
+    pjson j = cbor::decode_cbor<pjson>(data);
+    REQUIRE(j.size() == 2);
+    CHECK(j[0].array_value().packing() == detail::packed_kind::float32_value);
+    CHECK(j[1].array_value().packing() == detail::packed_kind::float64_value);
+    CHECK(j[0].as<std::vector<float>>() == floats);
+    CHECK(j[1].as<std::vector<double>>() == doubles);
+
+    // Round trip as typed arrays
+    std::vector<uint8_t> data2;
+    cbor::encode_cbor(j, data2, options);
+    CHECK(data2 == data);
+
+    // Decoded to generic elements
+    json k = cbor::decode_cbor<json>(data);
+    CHECK(k[1].as<std::vector<double>>() == doubles);
+    CHECK(k.to_string() == j.to_string());
+}
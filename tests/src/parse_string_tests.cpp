@@ -130,3 +130,77 @@ TEST_CASE("test_parse_big_string2")
 }
 
 
+
+TEST_CASE("test_parse_string_special_characters_at_each_offset")
+{
+    SECTION("escape")
+    {
+        for (std::size_t length = 0; length < 140; ++length)
+        {
+            for (std::size_t i = 0; i <= length; i += 7)
+            {
+                std::string expected(length, 'a');
+                expected.insert(i, 1, '\n');
+                std::string input = "\"" + std::string(length, 'a') + "\"";
+                input.insert(i+1, "\\n");
+
+                json j = json::parse(input);
+                CHECK(j.as<std::string>() == expected);
+            }
+        }
+    }
+
+    SECTION("illegal control character")
+    {
+        for (std::size_t length = 1; length < 140; length += 3)
+        {
+            std::string input = "\"" + std::string(length, 'b') + "\"";
+            input[length] = '\x01';
+
+            std::error_code ec;
+            json_decoder<json> decoder;
+            json_reader reader(input, decoder);
+            reader.read(ec);
+            CHECK(ec == json_errc::illegal_control_character);
+        }
+    }
+
+    SECTION("non ascii after a long ascii run")
+    {
+        std::string prefix(100, 'c');
+        json j = json::parse("\"" + prefix + "\xce\xbc\"");
+        CHECK(j.as<std::string>() == prefix + "\xce\xbc");
+
+        std::error_code expected;
+        json_decoder<json> decoder1;
+        std::string input1 = "\"\xce\"";
+        json_reader reader1(input1, decoder1);
+        reader1.read(expected);
+        REQUIRE(expected);
+
+        std::error_code ec;
+        json_decoder<json> decoder2;
+        std::string input2 = "\"" + prefix + "\xce\"";
+        json_reader reader2(input2, decoder2);
+        reader2.read(ec);
+        CHECK(ec == expected);
+    }
+
+    SECTION("string split across buffers")
+    {
+        std::string part1 = "[\"" + std::string(50, 'd');
+        std::string part2 = std::string(50, 'e') + "\\\"" + std::string(30, 'f') + "\"]";
+
+        json_decoder<json> decoder;
+        json_parser parser;
+        parser.update(part1);
+        parser.parse_some(decoder);
+        parser.update(part2);
+        parser.parse_some(decoder);
+        parser.finish_parse(decoder);
+        REQUIRE(decoder.is_valid());
+
+        json j = decoder.get_result();
+        CHECK(j[0].as<std::string>() == std::string(50, 'd') + std::string(50, 'e') + "\"" + std::string(30, 'f'));
+    }
+}
@@ -0,0 +1,93 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/read_ahead_source.hpp>
+#include <jsoncons/fd_source.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("read_ahead_source tests")
+{
+    json expected(json_array_arg);
+    for (std::size_t i = 0; i < 2000; ++i)
+    {
+        json item;
+        item.try_emplace("id", i);
+        item.try_emplace("name", "name-" + std::to_string(i));
+        item.try_emplace("values", json(json_array_arg, {json(i * 0.5), json(false), json(null_type())}));
+        expected.push_back(std::move(item));
+    }
+    std::string text;
+    expected.dump(text);
+
+    SECTION("json_reader")
+    {
+        for (std::size_t length : {1, 7, 4096, 65536})
+        {
+            INFO(length);
+            std::istringstream is(text);
+            json_decoder<json> decoder;
+            using source_type = read_ahead_source<stream_source<char>>;
+            basic_json_reader<char,source_type> reader(source_type(stream_source<char>(is), length, 2), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+
+    SECTION("cbor reader")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(expected, data);
+        std::string s(data.begin(), data.end());
+        std::istringstream is(s);
+
+        json_decoder<json> decoder;
+        using source_type = read_ahead_source<binary_stream_source>;
+        cbor::basic_cbor_reader<source_type> reader(source_type(binary_stream_source(is), 1000), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+
+    SECTION("character access")
+    {
+        std::string input = "abcdefg";
+        read_ahead_source<string_source<char>> source(string_source<char>(input), 2);
+        CHECK(source.peek_character().value() == 'a');
+        CHECK(source.get_character().value() == 'a');
+        source.ignore(3);
+        char buf[10];
+        CHECK(source.read(buf, 10) == 3);
+        CHECK(std::string(buf, 3) == "efg");
+        CHECK(source.eof());
+        CHECK_FALSE(source.get_character());
+        CHECK(source.position() == 7);
+        CHECK_FALSE(source.is_error());
+    }
+
+    SECTION("destroyed before the input is consumed")
+    {
+        std::istringstream is(text);
+        read_ahead_source<stream_source<char>> source(stream_source<char>(is), 16);
+        CHECK(source.get_character().value() == '[');
+    }
+
+    SECTION("source error")
+    {
+        json_decoder<json> decoder;
+        using source_type = read_ahead_source<fd_source<char>>;
+        basic_json_reader<char,source_type> reader(source_type(fd_source<char>(-1)), decoder);
+        std::error_code ec;
+        reader.read(ec);
+        CHECK(ec == json_errc::source_error);
+    }
+}
+
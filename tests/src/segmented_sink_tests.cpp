@@ -0,0 +1,111 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/segmented_sink.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <jsoncons_ext/msgpack/msgpack.hpp>
+#include <catch/catch.hpp>
+#include "sample_allocators.hpp"
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("segmented_sink tests")
+{
+    json expected(json_array_arg);
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        json item;
+        item.try_emplace("id", i);
+        item.try_emplace("name", "name-" + std::to_string(i));
+        item.try_emplace("values", json(json_array_arg, {json(i * 0.5), json(true), json(null_type())}));
+        expected.push_back(std::move(item));
+    }
+
+    SECTION("json")
+    {
+        std::string text;
+        expected.dump(text);
+
+        for (std::size_t length : {1, 7, 4096, 1000000})
+        {
+            INFO(length);
+            segmented_buffer buffer(length);
+            {
+                basic_compact_json_encoder<char,segmented_sink<char>> encoder{segmented_sink<char>(buffer)};
+                expected.dump(encoder);
+            }
+            CHECK(buffer.size() == text.size());
+            CHECK(buffer.segments().size() == (text.size() + length - 1) / length);
+
+            std::string s;
+            buffer.append_to(s);
+            CHECK(s == text);
+
+            std::vector<char> v(buffer.size());
+            buffer.copy_to(v.data());
+            CHECK(std::string(v.begin(), v.end()) == text);
+        }
+    }
+
+    SECTION("cbor and msgpack")
+    {
+        binary_segmented_buffer buffer(100);
+        {
+            cbor::basic_cbor_encoder<segmented_sink<uint8_t>> encoder{segmented_sink<uint8_t>(buffer)};
+            expected.dump(encoder);
+        }
+        std::vector<uint8_t> data;
+        buffer.append_to(data);
+        CHECK(cbor::decode_cbor<json>(data) == expected);
+
+        // A segmented buffer is a back insertable byte container
+        binary_segmented_buffer buffer2(100);
+        msgpack::encode_msgpack(expected, buffer2);
+        data.clear();
+        buffer2.append_to(data);
+        CHECK(msgpack::decode_msgpack<json>(data) == expected);
+    }
+
+    SECTION("clear, move and empty")
+    {
+        segmented_buffer buffer(4);
+        CHECK(buffer.empty());
+        CHECK(buffer.segments().empty());
+        buffer.append("abcdefgh", 8);
+        CHECK(buffer.size() == 8);
+        CHECK(buffer.segments().size() == 2);
+        buffer.push_back('i');
+        CHECK(buffer.segments().size() == 3);
+
+        segmented_buffer other(std::move(buffer));
+        CHECK(buffer.empty());
+        std::string s;
+        other.append_to(s);
+        CHECK(s == "abcdefghi");
+
+        other.clear();
+        CHECK(other.empty());
+        other.push_back('x');
+        CHECK(other.size() == 1);
+    }
+
+    SECTION("allocator")
+    {
+        FreelistAllocator<char> alloc{1};
+        basic_segmented_buffer<char,FreelistAllocator<char>> buffer(16, alloc);
+        {
+            basic_json_encoder<char,segmented_sink<char,FreelistAllocator<char>>> encoder{segmented_sink<char,FreelistAllocator<char>>(buffer)};
+            expected.dump(encoder);
+        }
+        std::string s;
+        buffer.append_to(s);
+        CHECK(json::parse(s) == expected);
+    }
+}
+
@@ -0,0 +1,214 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/jsonpath/jsonpath.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+#include <map>
+
+using namespace jsoncons;
+
+using sjson = basic_json<char,shape_policy,std::allocator<char>>;
+
+namespace {
+
+    std::string make_object_text(std::size_t count)
+    {
+        std::string s = "{";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i > 0)
+            {
+                s.push_back(',');
+            }
+            s += "\"key" + std::to_string(i) + "\":" + std::to_string(i);
+        }
+        s.push_back('}');
+        return s;
+    }
+
+    bool shares_shape(const sjson& a, const sjson& b)
+    {
+        return a.object_value().shares_shape(b.object_value());
+    }
+}
+
+TEST_CASE("shape_policy parse")
+{
+    std::string text = R"(
+    [
+        {"title":"Sword of Honour","author":"Evelyn Waugh","price":12.99},
+        {"title":"Moby Dick","author":"Herman Melville","price":8.99},
+        {"author":"J. R. R. Tolkien","title":"The Lord of the Rings","price":22.99},
+        {"title":"Sayings of the Century","author":"Nigel Rees","price":8.95}
+    ]
+    )";
+
+    sjson j = sjson::parse(text);
+    REQUIRE(j.size() == 4);
+
+    SECTION("records with the same keys share a shape")
+    {
+        CHECK(shares_shape(j[0], j[1]));
+        CHECK(shares_shape(j[0], j[3]));
+        CHECK_FALSE(shares_shape(j[0], j[2]));
+    }
+
+    SECTION("insertion order is preserved")
+    {
+        CHECK(j[2].to_string() == R"({"author":"J. R. R. Tolkien","title":"The Lord of the Rings","price":22.99})");
+        CHECK(j.to_string() == ojson::parse(text).to_string());
+    }
+
+    SECTION("find")
+    {
+        CHECK(j[1]["author"].as<std::string>() == "Herman Melville");
+        CHECK(j[2].at("price").as<double>() == 22.99);
+        CHECK(j[3].contains("title"));
+        CHECK_FALSE(j[3].contains("isbn"));
+    }
+
+    SECTION("duplicate keys")
+    {
+        sjson k = sjson::parse(R"([{"a":1,"b":2,"a":3},{"a":1,"b":2,"a":3}])");
+        CHECK(k[0].to_string() == R"({"a":1,"b":2})");
+        CHECK(k[0] == k[1]);
+    }
+
+    SECTION("large objects")
+    {
+        for (std::size_t count : {16, 17, 100})
+        {
+            INFO(count);
+            sjson k = sjson::parse(make_object_text(count));
+            REQUIRE(k.size() == count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                CHECK(k.at("key" + std::to_string(i)).as<std::size_t>() == i);
+            }
+            CHECK_FALSE(k.contains("key" + std::to_string(count)));
+        }
+    }
+}
+
+TEST_CASE("shape_policy modify")
+{
+    sjson j = sjson::parse(R"([{"a":1,"b":2,"c":3},{"a":4,"b":5,"c":6}])");
+    sjson& first = j[0];
+    sjson& second = j[1];
+    REQUIRE(shares_shape(first, second));
+
+    SECTION("assign a value")
+    {
+        first["b"] = "two";
+        CHECK(shares_shape(first, second));
+        CHECK(first.to_string() == R"({"a":1,"b":"two","c":3})");
+        CHECK(second.to_string() == R"({"a":4,"b":5,"c":6})");
+    }
+
+    SECTION("insert a key")
+    {
+        first.insert_or_assign("d", 4);
+        CHECK_FALSE(shares_shape(first, second));
+        CHECK(first.to_string() == R"({"a":1,"b":2,"c":3,"d":4})");
+        CHECK(second.to_string() == R"({"a":4,"b":5,"c":6})");
+
+        second.try_emplace(second.object_range().begin(), "z", 0);
+        CHECK(second.to_string() == R"({"z":0,"a":4,"b":5,"c":6})");
+        CHECK(second.try_emplace("a", 10).second == false);
+    }
+
+    SECTION("erase a key")
+    {
+        second.erase("b");
+        CHECK_FALSE(shares_shape(first, second));
+        CHECK(first.to_string() == R"({"a":1,"b":2,"c":3})");
+        CHECK(second.to_string() == R"({"a":4,"c":6})");
+
+        second.erase(second.object_range().begin());
+        CHECK(second.to_string() == R"({"c":6})");
+    }
+
+    SECTION("merge")
+    {
+        sjson source = sjson::parse(R"({"c":30,"d":40})");
+        sjson a = first;
+        a.merge(source);
+        CHECK(a.to_string() == R"({"a":1,"b":2,"c":3,"d":40})");
+        first.merge_or_update(source);
+        CHECK(first.to_string() == R"({"a":1,"b":2,"c":30,"d":40})");
+        CHECK(second.to_string() == R"({"a":4,"b":5,"c":6})");
+    }
+
+    SECTION("iterate and modify")
+    {
+        for (auto& member : first.object_range())
+        {
+            member.value(member.value().as<int>() * 10);
+        }
+        CHECK(first.to_string() == R"({"a":10,"b":20,"c":30})");
+        CHECK(second.to_string() == R"({"a":4,"b":5,"c":6})");
+    }
+}
+
+TEST_CASE("shape_policy build")
+{
+    sjson j;
+    for (std::size_t i = 0; i < 40; ++i)
+    {
+        j.insert_or_assign("key" + std::to_string(i), i);
+    }
+    CHECK(j == sjson::parse(make_object_text(40)));
+    CHECK(j.at("key39").as<std::size_t>() == 39);
+
+    sjson copy(j);
+    CHECK(shares_shape(copy, j));
+    copy.erase("key0");
+    CHECK(copy.size() == 39);
+    CHECK(j.size() == 40);
+    CHECK(copy.at("key39").as<std::size_t>() == 39);
+    CHECK_FALSE(copy.contains("key0"));
+
+    j.clear();
+    CHECK(j.empty());
+    j["a"] = 1;
+    CHECK(j.to_string() == R"({"a":1})");
+}
+
+TEST_CASE("shape_policy compare")
+{
+    sjson a = sjson::parse(R"({"a":1,"b":2})");
+    sjson b = sjson::parse(R"({"a":1,"b":2})");
+    sjson c = sjson::parse(R"({"b":2,"a":1})");
+    sjson d = sjson::parse(R"({"a":1,"b":3})");
+
+    CHECK(a == b);
+    CHECK(a != c);
+    CHECK(a != d);
+    CHECK(a < d);
+    CHECK_FALSE(d < a);
+    CHECK(sjson(json_object_arg) == sjson(json_object_arg));
+}
+
+TEST_CASE("shape_policy conversions")
+{
+    sjson j = sjson::parse(R"([{"x":1,"y":2},{"x":3,"y":4}])");
+
+    std::map<std::string,int> m = j[1].as<std::map<std::string,int>>();
+    CHECK(m == (std::map<std::string,int>{{"x",3},{"y",4}}));
+
+    sjson k(m);
+    CHECK(k == j[1]);
+
+    sjson result = jsonpath::json_query(j, "$[*].y");
+    CHECK(result.to_string() == "[2,4]");
+
+    std::vector<uint8_t> data;
+    cbor::encode_cbor(j, data);
+    sjson l = cbor::decode_cbor<sjson>(data);
+    CHECK(l == j);
+    CHECK(shares_shape(l[0], l[1]));
+}
@@ -0,0 +1,239 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/jsonpath/jsonpath.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+#include <thread>
+
+using namespace jsoncons;
+
+TEST_CASE("shared_json copy")
+{
+    shared_json a = shared_json::parse(R"({"a":{"b":1,"c":[1,2,3]},"d":[{"e":true}]})");
+    REQUIRE(a.use_count() == 1);
+
+    SECTION("copies share containers")
+    {
+        shared_json b = a;
+        CHECK(a.use_count() == 2);
+        CHECK(b.use_count() == 2);
+        CHECK(b == a);
+        CHECK(b.to_string() == a.to_string());
+
+        shared_json c(b);
+        CHECK(a.use_count() == 3);
+        c = shared_json();
+        CHECK(a.use_count() == 2);
+    }
+
+    SECTION("const access does not copy")
+    {
+        shared_json b = a;
+        const shared_json& cb = b;
+        CHECK(cb["a"]["c"][1].as<int>() == 2);
+        CHECK(cb.at("d").size() == 1);
+        for (const auto& member : cb.object_range())
+        {
+            CHECK_FALSE(member.key().empty());
+        }
+        CHECK(a.use_count() == 2);
+    }
+
+    SECTION("modifying a copy copies the modified path")
+    {
+        shared_json b = a;
+        b["a"]["c"][0] = 10;
+        CHECK(a.use_count() == 1);
+        CHECK(a.to_string() == R"({"a":{"b":1,"c":[1,2,3]},"d":[{"e":true}]})");
+        CHECK(b.to_string() == R"({"a":{"b":1,"c":[10,2,3]},"d":[{"e":true}]})");
+
+        // The unmodified subtree is still shared
+        CHECK(b.at("d").use_count() == 2);
+        CHECK(b.at("a").use_count() == 1);
+    }
+
+    SECTION("modifying the original leaves the copy")
+    {
+        shared_json b = a;
+        a.erase("d");
+        a["a"].insert_or_assign("b", "one");
+        CHECK(a.to_string() == R"({"a":{"b":"one","c":[1,2,3]}})");
+        CHECK(b.to_string() == R"({"a":{"b":1,"c":[1,2,3]},"d":[{"e":true}]})");
+    }
+
+    SECTION("arrays")
+    {
+        shared_json b = a.at("d");
+        b.push_back(shared_json(null_type()));
+        CHECK(b.size() == 2);
+        CHECK(a.at("d").size() == 1);
+        CHECK(b[0].use_count() == 2);
+    }
+
+    SECTION("reference taken before a copy")
+    {
+        shared_json b = shared_json::parse("[1,2,3]");
+        auto& e = b[0];
+        shared_json c = b;
+        e = 42;
+        CHECK(b.to_string() == "[42,2,3]");
+        CHECK(c.to_string() == "[1,2,3]");
+        CHECK(b.use_count() == 1);
+        CHECK(c.use_count() == 1);
+    }
+
+    SECTION("nested reference taken before a copy")
+    {
+        auto& e = a["a"]["c"][1];
+        shared_json b = a;
+        e = 20;
+        CHECK(a.to_string() == R"({"a":{"b":1,"c":[1,20,3]},"d":[{"e":true}]})");
+        CHECK(b.to_string() == R"({"a":{"b":1,"c":[1,2,3]},"d":[{"e":true}]})");
+        // Containers that no reference was taken into are still shared
+        CHECK(b.at("d").use_count() == 2);
+    }
+
+    SECTION("iterator taken before a copy")
+    {
+        shared_json o = shared_json::parse(R"({"x":1,"y":2})");
+        auto it = o.object_range().begin();
+        shared_json o2 = o;
+        it->value() = 7;
+        CHECK(o.to_string() == R"({"x":7,"y":2})");
+        CHECK(o2.to_string() == R"({"x":1,"y":2})");
+    }
+
+    SECTION("erase through a const iterator into a shared array")
+    {
+        shared_json b = shared_json::parse("[1,2,3,4,5,6,7,8]");
+        shared_json c = b;
+        const shared_json& cb = b;
+        b.erase(cb.array_range().begin()+1);
+        CHECK(b.to_string() == "[1,3,4,5,6,7,8]");
+        CHECK(c.to_string() == "[1,2,3,4,5,6,7,8]");
+
+        b.erase(cb.array_range().begin()+1, cb.array_range().begin()+3);
+        CHECK(b.to_string() == "[1,5,6,7,8]");
+    }
+
+    SECTION("insert through a const iterator into a shared array")
+    {
+        shared_json b = shared_json::parse("[1,2,3]");
+        shared_json c = b;
+        const shared_json& cc = c;
+        c.insert(cc.array_range().begin(), shared_json(0));
+        CHECK(c.to_string() == "[0,1,2,3]");
+        CHECK(b.to_string() == "[1,2,3]");
+
+        shared_json d = c;
+        const shared_json& cd = d;
+        d.emplace(cd.array_range().end(), 4);
+        CHECK(d.to_string() == "[0,1,2,3,4]");
+        CHECK(c.to_string() == "[0,1,2,3]");
+    }
+
+    SECTION("erase through a const iterator into a shared object")
+    {
+        shared_json o = shared_json::parse(R"({"x":1,"y":2,"z":3})");
+        shared_json p = o;
+        const shared_json& co = o;
+        o.erase(co.find("y"));
+        CHECK(o.to_string() == R"({"x":1,"z":3})");
+        CHECK(p.to_string() == R"({"x":1,"y":2,"z":3})");
+    }
+
+    SECTION("modifications that hand out no references keep sharing")
+    {
+        shared_json b = a;
+        b.erase("d");
+        shared_json c = b;
+        CHECK(c.use_count() == 2);
+        shared_json d = shared_json::parse("[1,2]");
+        d.push_back(3);
+        shared_json e = d;
+        CHECK(d.use_count() == 2);
+        CHECK(e.to_string() == "[1,2,3]");
+    }
+
+    SECTION("swap and move")
+    {
+        shared_json b = a;
+        shared_json c(std::move(b));
+        CHECK(a.use_count() == 2);
+        shared_json d;
+        d.swap(c);
+        CHECK(a.use_count() == 2);
+        CHECK(d == a);
+    }
+}
+
+TEST_CASE("shared_json query results share nodes")
+{
+    shared_json root = shared_json::parse(R"(
+    {
+        "books":
+        [
+            {"title":"Sword of Honour","author":"Evelyn Waugh"},
+            {"title":"Moby Dick","author":"Herman Melville"}
+        ]
+    }
+    )");
+
+    shared_json result = jsonpath::json_query(root, "$.books[*]");
+    REQUIRE(result.size() == 2);
+    CHECK(result[0].use_count() == 2);
+    CHECK(result[0]["title"].as<std::string>() == "Sword of Honour");
+
+    result[0]["title"] = "Vile Bodies";
+    CHECK(root["books"][0]["title"].as<std::string>() == "Sword of Honour");
+}
+
+TEST_CASE("shared_json destroy deeply nested")
+{
+    shared_json a(json_array_arg);
+    for (std::size_t i = 0; i < 10000; ++i)
+    {
+        shared_json outer(json_array_arg);
+        outer.push_back(std::move(a));
+        a = std::move(outer);
+    }
+    shared_json b = a;
+    CHECK(a.use_count() == 2);
+    a = shared_json();
+    CHECK(b.size() == 1);
+    b = shared_json();
+}
+
+TEST_CASE("shared_json copies in threads")
+{
+    shared_json a = shared_json::parse(R"({"counts":[0,0,0,0],"name":"config"})");
+
+    std::vector<shared_json> results(4);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&a,&results,i]()
+        {
+            for (int k = 0; k < 100; ++k)
+            {
+                shared_json copy = a;
+                copy["counts"][i] = k;
+                results[i] = copy;
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    CHECK(a.to_string() == R"({"counts":[0,0,0,0],"name":"config"})");
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        CHECK(results[i]["counts"][i].as<int>() == 99);
+        CHECK(results[i]["name"].as<std::string>() == "config");
+    }
+}
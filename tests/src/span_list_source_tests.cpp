@@ -0,0 +1,129 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons/json_cursor.hpp>
+#include <jsoncons/span_list_source.hpp>
+#include <jsoncons/segmented_sink.hpp>
+#include <jsoncons_ext/cbor/cbor.hpp>
+#include <catch/catch.hpp>
+#include <string>
+#include <vector>
+
+using namespace jsoncons;
+
+namespace {
+
+    template <class T>
+    std::vector<std::vector<T>> split(const std::vector<T>& data, std::size_t length)
+    {
+        std::vector<std::vector<T>> chunks;
+        for (std::size_t i = 0; i < data.size(); i += length)
+        {
+            chunks.emplace_back(data.begin() + i, data.begin() + (std::min)(i + length, data.size()));
+            if (i % 3 == 0)
+            {
+                chunks.emplace_back(); // empty buffers are skipped
+            }
+        }
+        return chunks;
+    }
+}
+
+TEST_CASE("span_list_source tests")
+{
+    std::string input = R"({"name" : "Haruki \"Murakami\"é", "values" : [1.5e10, -12345678901234567890, true, null, "😀"], "n" : 123456})";
+    std::vector<char> text(input.begin(), input.end());
+    json expected = json::parse(input);
+
+    SECTION("json_reader with strings and numbers split at every position")
+    {
+        for (std::size_t length : {1, 2, 3, 5, 8, 1000})
+        {
+            INFO(length);
+            auto chunks = split(text, length);
+            json_decoder<json> decoder;
+            basic_json_reader<char,span_list_source<char>> reader(span_list_source<char>(chunks.begin(), chunks.end()), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+
+    SECTION("json_cursor")
+    {
+        auto chunks = split(text, 4);
+        basic_json_cursor<char,span_list_source<char>> cursor{span_list_source<char>(chunks.begin(), chunks.end())};
+        std::vector<std::string> keys;
+        for (; !cursor.done(); cursor.next())
+        {
+            if (cursor.current().event_type() == staj_event_type::key)
+            {
+                keys.push_back(cursor.current().get<std::string>());
+            }
+        }
+        CHECK((keys == std::vector<std::string>{"name", "values", "n"}));
+    }
+
+    SECTION("cbor reader")
+    {
+        std::vector<uint8_t> data;
+        cbor::encode_cbor(expected, data);
+        for (std::size_t length : {1, 3, 7})
+        {
+            INFO(length);
+            auto chunks = split(data, length);
+            json_decoder<json> decoder;
+            cbor::basic_cbor_reader<binary_span_list_source> reader(binary_span_list_source(chunks.begin(), chunks.end()), decoder);
+            reader.read();
+            CHECK(decoder.get_result() == expected);
+        }
+    }
+
+    SECTION("segments of a segmented buffer")
+    {
+        binary_segmented_buffer buffer(5);
+        cbor::encode_cbor(expected, buffer);
+
+        json_decoder<json> decoder;
+        cbor::basic_cbor_reader<binary_span_list_source> reader(binary_span_list_source(buffer.segments()), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == expected);
+    }
+
+#if !defined(_WIN32)
+    SECTION("iovec")
+    {
+        std::string a = R"({"a" : [1,)";
+        std::string b = R"(2]})";
+        struct iovec iov[2];
+        iov[0].iov_base = &a[0];
+        iov[0].iov_len = a.size();
+        iov[1].iov_base = &b[0];
+        iov[1].iov_len = b.size();
+
+        json_decoder<json> decoder;
+        basic_json_reader<char,span_list_source<char>> reader(span_list_source<char>(iov, 2), decoder);
+        reader.read();
+        CHECK(decoder.get_result() == json::parse(R"({"a":[1,2]})"));
+    }
+#endif
+
+    SECTION("character access")
+    {
+        std::vector<std::string> chunks = {"ab", "", "cde", "f", "g"};
+        span_list_source<char> source(chunks.begin(), chunks.end());
+        CHECK(source.peek_character().value() == 'a');
+        CHECK(source.get_character().value() == 'a');
+        source.ignore(3);
+        char buf[10];
+        CHECK(source.read(buf, 10) == 3);
+        CHECK(std::string(buf, 3) == "efg");
+        CHECK(source.eof());
+        CHECK_FALSE(source.get_character());
+        CHECK(source.position() == 7);
+    }
+}
+
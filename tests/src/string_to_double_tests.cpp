@@ -53,3 +53,54 @@ TEST_CASE("test_exponent")
 
 }
 
+
+TEST_CASE("test_decimal_to_double")
+{
+    SECTION("matches strtod")
+    {
+        std::vector<std::string> inputs = {
+            "0", "-0", "1", "-1.5", "0.1", "1e23", "1E+2", "1e-2", "+5", "5.", "00012.5e1",
+            "9007199254740993", "4503599627370497.5", "7.2057594037927933e16",
+            "2.2250738585072011e-308", "2.2250738585072014e-308", "4.9406564584124654e-324",
+            "2.4703282292062328e-324", "1.7976931348623157e308", "1.7976931348623158e308",
+            "1.00000000000000011102230246251565404236316680908203125",
+            "1.00000000000000011102230246251565404236316680908203124",
+            "123456789012345678901234567890", "0.000000000000000000000000000000000000001234",
+            "1e-400", "1e400", "-1e400"
+        };
+        for (const auto& input : inputs)
+        {
+            double expected = strtod(input.c_str(), nullptr);
+            double val = 0;
+            if (jsoncons::detail::decimal_to_double(input.data(), input.length(), '.', val))
+            {
+                INFO(input);
+                CHECK(std::signbit(val) == std::signbit(expected));
+                CHECK(val == expected);
+            }
+        }
+    }
+
+    SECTION("not decimal numbers")
+    {
+        std::vector<std::string> inputs = {"", "-", ".", "e5", "1e", "1e+", "1.5x", "0x10", "inf", "nan", " 1"};
+        for (const auto& input : inputs)
+        {
+            double val = 0;
+            INFO(input);
+            CHECK_FALSE(jsoncons::detail::decimal_to_double(input.data(), input.length(), '.', val));
+        }
+    }
+
+    SECTION("to_double_t without null terminator")
+    {
+        jsoncons::detail::to_double_t to_double;
+        std::string s = "1.2531.25";
+        CHECK(to_double(s.data(), 4) == 1.25);
+        CHECK(to_double(s.data() + 4, 5) == 31.25);
+        CHECK(std::isinf(to_double("infinity", 8)));
+
+        std::wstring ws = L"-0.75e2";
+        CHECK(to_double(ws.data(), ws.length()) == -75.0);
+    }
+}
@@ -1,3 +1,4 @@
 #define CATCH_CONFIG_MAIN
+// Catch's alternate signal stack size is not a constant expression with glibc 2.34 and later
+#define CATCH_CONFIG_NO_POSIX_SIGNALS
 #include <catch/catch.hpp>
-
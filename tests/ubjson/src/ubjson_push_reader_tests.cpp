@@ -0,0 +1,68 @@
+// Copyright 2020 Daniel Parker
+// Distributed under Boost license
+
+#if defined(_MSC_VER)
+#include "windows.h" // test no inadvertant macro expansions
+#endif
+#include <jsoncons/json.hpp>
+#include <jsoncons_ext/ubjson/ubjson.hpp>
+#include <catch/catch.hpp>
+#include <vector>
+
+using namespace jsoncons;
+
+TEST_CASE("ubjson_push_reader tests")
+{
+    std::vector<json> expected;
+    expected.push_back(json::parse(R"({"name" : "Haruki Murakami", "values" : [1.5, -1234567890123, true, null, "😀"], "n" : 123456})"));
+    expected.push_back(json(json_array_arg, {json(json_array_arg), json(json_object_arg), json(std::string(300, 'x'))}));
+    expected.push_back(json("18446744073709551616000", semantic_tag::bigint));
+    expected.push_back(json(true));
+
+    std::vector<uint8_t> data;
+    for (const auto& item : expected)
+    {
+        ubjson::encode_ubjson(item, data);
+    }
+    // An array with a type and count, an unsized object, and an object with a count
+    std::vector<uint8_t> optimized = {'[','$','i','#','U',3,1,2,3,
+                                      '{','U',1,'a','[','T','F',']','U',1,'b','S','U',2,'c','d','}',
+                                      '{','#','i',1,'U',1,'x','[','$','Z','#','i',2};
+    data.insert(data.end(), optimized.begin(), optimized.end());
+    expected.push_back(json::parse("[1,2,3]"));
+    expected.push_back(json::parse(R"({"a":[true,false],"b":"cd"})"));
+    expected.push_back(json::parse(R"({"x":[null,null]})"));
+
+    SECTION("chunks of every length")
+    {
+        for (std::size_t length : {1, 2, 7, 1000})
+        {
+            INFO(length);
+            std::vector<json> items;
+            json_decoder<json> decoder;
+            ubjson::ubjson_push_reader reader(decoder);
+
+            for (std::size_t i = 0; i < data.size(); i += length)
+            {
+                reader.update(data.data() + i, (std::min)(length, data.size() - i));
+                while (reader.read())
+                {
+                    items.push_back(decoder.get_result());
+                }
+            }
+            reader.finish();
+            CHECK(items == expected);
+        }
+    }
+
+    SECTION("invalid type")
+    {
+        std::vector<uint8_t> bytes = {'[','X',']'};
+        std::error_code ec;
+        json_decoder<json> decoder;
+        ubjson::ubjson_push_reader reader(decoder);
+        reader.update(bytes.data(), 2);
+        CHECK_FALSE(reader.read(ec));
+        CHECK(ec);
+    }
+}